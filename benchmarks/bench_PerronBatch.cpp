@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "algorithm/GeneratorFactory.hpp"
+#include "analysis/PerronBatch.hpp"
+#include "analysis/eigenvalues.hpp"
+#include "io/Input.hpp"
+
+// PerronBatch (calculateMaxEigenvalues) と グラフごとの calculateMaxEigenvalue の比較
+// all-patternsモードで生成した刈り込み済みのグラフすべての最大固有値を両方で求め，
+// 所要時間 (反復のうち最短) と値の最大差を出力する．
+// 使い方: bench_PerronBatch [algorithm alphabet length position... [--repeat N]]
+// (既定は DeBruijn 2 4 1 1 1 1，65536個のグラフ)
+
+namespace {
+
+double elapsed(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int repeat = 3;
+    if (args.size() >= 2 && args[args.size() - 2] == "--repeat") {
+        repeat = std::max(1, std::atoi(args.back().c_str()));
+        args.resize(args.size() - 2);
+    }
+    if (args.empty()) {
+        args = {"DeBruijn", "2", "4", "1", "1", "1", "1"};
+    }
+    if (args.size() < 4) {
+        std::cerr << "Usage: bench_PerronBatch [algorithm alphabet length position... "
+                     "[--repeat N]]"
+                  << std::endl;
+        return 1;
+    }
+
+    io::type::Config config;
+    config.generation.mode = "all-patterns";
+    config.generation.algorithm = args[0];
+    config.generation.opt_mode = "sink_less";
+    config.generation.alphabet = std::atoi(args[1].c_str());
+    config.generation.forbidden.length = std::atoi(args[2].c_str());
+    for (size_t i = 3; i < args.size(); ++i) {
+        config.generation.forbidden.position.push_back(std::atoi(args[i].c_str()));
+    }
+    config.generation.period = config.generation.forbidden.position.size();
+
+    auto generator = GeneratorFactory::create(config);
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    std::vector<Graph> graphs;
+    while (enumerator.next()) {
+        graphs.push_back(generator->generateTrimmed(enumerator.get()));
+    }
+    std::vector<const Graph*> pointers;
+    for (const auto& graph : graphs) {
+        pointers.push_back(&graph);
+    }
+
+    double single = 0.0, batch = 0.0, maxDiff = 0.0;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<double> expected;
+        for (const auto& graph : graphs) {
+            expected.push_back(calculateMaxEigenvalue(graph));
+        }
+        const double singleTime = elapsed(start);
+
+        start = std::chrono::steady_clock::now();
+        const auto values = calculateMaxEigenvalues(pointers);
+        const double batchTime = elapsed(start);
+
+        single = r == 0 ? singleTime : std::min(single, singleTime);
+        batch = r == 0 ? batchTime : std::min(batch, batchTime);
+        for (size_t g = 0; g < graphs.size(); ++g) {
+            maxDiff = std::max(maxDiff, std::abs(values[g] - expected[g]));
+        }
+    }
+
+    std::cout << "graphs: " << graphs.size() << "\n"
+              << "calculateMaxEigenvalue: " << single << " s\n"
+              << "calculateMaxEigenvalues: " << batch << " s\n"
+              << "speedup: " << single / batch << "x\n"
+              << "max difference: " << maxDiff << std::endl;
+    return 0;
+}
@@ -1,33 +1,111 @@
 #include "Beal.hpp"
 
 #include <algorithm>
+#include <queue>
+#include <stdexcept>
 
-#include "../utils/NodeUtils.hpp"
+#include "../core/CsrGraph.hpp"
 
-std::vector<Node> Beal::generateNodes(const std::vector<Node>& forbiddenNodes) const {
-    std::vector<Node> nodes;
+namespace {
 
-    for (const auto& node : forbiddenNodes) {
-        const std::string& label = node.getLabel();
-        unsigned int phase = node.getPhase();
+constexpr int NONE = -1;
+
+// 位相付きトライ
+// 状態 s は禁止語の接頭辞 x とその開始位相 ph の組 (x, ph)．
+// 状態 0..period-1 は空系列 (E, p)．
+// 同じ接頭辞を持つ状態は位相によらずラベルトライの同じ頂点に対応し，
+// その前順走査で (ラベル, 位相) の昇順にノードを並べる．
+struct PhaseTrie {
+    unsigned int k;                   // アルファベットサイズ
+    std::vector<int> child;           // child[s * k + c]: 状態の子
+    std::vector<unsigned int> phase;  // 状態の開始位相
+    std::vector<bool> forbidden;      // 禁止語そのものか
+
+    std::vector<int> labelChild;              // labelChild[l * k + c]: ラベルトライの子
+    std::vector<std::vector<int>> labelStates;  // ラベルトライの頂点に対応する状態
 
-        // 接頭辞ノードを追加
-        for (size_t len = 1; len <= label.size(); ++len) {
-            nodes.emplace_back(label.substr(0, len), phase);
+    PhaseTrie(unsigned int k, unsigned int period) : k(k), labelChild(k, NONE), labelStates(1) {
+        for (unsigned int p = 0; p < period; ++p) {
+            addState(p);
         }
     }
 
-    // 空系列ノードを追加
-    for (size_t p = 0; p < period; ++p) {
-        nodes.emplace_back("E", p);
+    int addState(unsigned int ph) {
+        child.resize(child.size() + k, NONE);
+        phase.push_back(ph);
+        forbidden.push_back(false);
+        return static_cast<int>(phase.size() - 1);
     }
 
-    // 重複を削除
-    std::sort(nodes.begin(), nodes.end());
-    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    int addLabel() {
+        labelChild.resize(labelChild.size() + k, NONE);
+        labelStates.emplace_back();
+        return static_cast<int>(labelStates.size() - 1);
+    }
 
-    return nodes;
-}
+    // 禁止語 (digits, ph) の接頭辞をすべて登録
+    void insert(const std::vector<int>& digits, unsigned int ph) {
+        int s = ph;
+        int l = 0;
+        for (int c : digits) {
+            if (labelChild[l * k + c] == NONE) {
+                int next = addLabel();
+                labelChild[l * k + c] = next;
+            }
+            l = labelChild[l * k + c];
+
+            if (child[s * k + c] == NONE) {
+                int next = addState(ph);
+                child[s * k + c] = next;
+                labelStates[l].push_back(next);
+            }
+            s = child[s * k + c];
+        }
+        forbidden[s] = true;
+    }
+
+    // 遷移表 delta[s * k + c] を失敗リンクから構築
+    std::vector<int> buildTransitions(unsigned int period) const {
+        std::vector<int> delta(child.size(), NONE);
+        std::vector<int> fail(phase.size(), NONE);
+        std::queue<int> queue;
+
+        // 空系列からの遷移: 子がなければ次の位相の空系列へ
+        for (unsigned int p = 0; p < period; ++p) {
+            int empty = (p + 1) % period;
+            for (unsigned int c = 0; c < k; ++c) {
+                int t = child[p * k + c];
+                if (t != NONE) {
+                    delta[p * k + c] = t;
+                    fail[t] = empty;
+                    queue.push(t);
+                } else {
+                    delta[p * k + c] = empty;
+                }
+            }
+        }
+
+        // 幅優先で失敗リンク (最長の真の接尾辞となる状態) を求める
+        while (!queue.empty()) {
+            int s = queue.front();
+            queue.pop();
+            for (unsigned int c = 0; c < k; ++c) {
+                int t = child[s * k + c];
+                if (t != NONE) {
+                    delta[s * k + c] = t;
+                    fail[t] = delta[fail[s] * k + c];
+                    queue.push(t);
+                } else {
+                    delta[s * k + c] = delta[fail[s] * k + c];
+                }
+            }
+        }
+
+        return delta;
+    }
+};
+
+}  // namespace
 
 Beal::Beal(unsigned int alphabetSize, unsigned int period, unsigned int wordLength)
     : period(period) {
@@ -35,52 +113,97 @@ Beal::Beal(unsigned int alphabetSize, unsigned int period, unsigned int wordLeng
 }
 
 Graph Beal::generate(const std::vector<Node>& forbiddenNodes) const {
-    Graph graph;
-    std::vector<Node> nodes = generateNodes(forbiddenNodes);
-
-    for (const auto& node : nodes) {
-        graph.addNode(node);
+    const unsigned int k = alphabet.size();
+    PhaseTrie trie(k, period);
 
-        // 禁止ノードはスキップ
-        if (containsNode(forbiddenNodes, node)) {
-            continue;
+    // 禁止語をトライに登録
+    std::vector<int> digits;
+    for (const auto& node : forbiddenNodes) {
+        if (node.getPhase() >= period) {
+            throw std::invalid_argument("Forbidden word phase must be less than period: " +
+                                        node.getLabel());
+        }
+        digits.clear();
+        for (char c : node.getLabel()) {
+            auto digit = alphabet.find(c);
+            if (digit == std::string::npos) {
+                throw std::invalid_argument("Forbidden word contains a symbol outside the "
+                                            "alphabet: " + node.getLabel());
+            }
+            digits.push_back(static_cast<int>(digit));
         }
+        trie.insert(digits, node.getPhase());
+    }
 
-        const std::string& label = node.getLabel();
-        unsigned int phase = node.getPhase();
+    const auto delta = trie.buildTransitions(period);
 
-        for (char c : alphabet) {
-            std::string nextLabel = (label != "E" ? label : "") + c;
+    CsrGraph csr;
+    for (char c : alphabet) {
+        csr.addSymbol(std::string(1, c));
+    }
 
-            // 次ノードを探索
-            auto findNextNode = [&](const std::string& prefix,
-                                    unsigned int phaseOffset) -> std::pair<bool, Node> {
-                Node candidate(prefix, (phase + phaseOffset) % period);
-                if (containsNode(nodes, candidate)) {
-                    return {true, candidate};
-                }
-                return {false, Node()};
-            };
-
-            bool found = false;
-            for (size_t len = 0; len <= nextLabel.size(); ++len) {
-                auto [isFound, nextNode] = findNextNode(nextLabel.substr(len), len);
-                if (isFound) {
-                    graph.addEdge(Edge(node, nextNode, std::string(1, c)));
-                    found = true;
-                    break;
-                }
+    // ラベルトライを前順に走査し，(ラベル, 位相) の昇順にノードを追加
+    std::vector<CsrGraph::Id> toId(trie.phase.size());
+    std::vector<int> order;
+    order.reserve(trie.phase.size());
+
+    auto addStates = [&](const std::vector<int>& states, const std::string& label) {
+        std::vector<int> sorted(states);
+        std::sort(sorted.begin(), sorted.end(),
+                  [&](int a, int b) { return trie.phase[a] < trie.phase[b]; });
+        for (int s : sorted) {
+            toId[s] = csr.addNode(label, trie.phase[s]);
+            order.push_back(s);
+        }
+    };
+    auto addEmptyStates = [&]() {
+        for (unsigned int p = 0; p < period; ++p) {
+            toId[p] = csr.addNode("E", p);
+            order.push_back(p);
+        }
+    };
+
+    // 空系列 "E" は根の子のうち 'E' 以上の文字で始まるラベルの直前に並ぶ
+    bool emptyAdded = false;
+    std::string label;
+    std::vector<std::pair<int, unsigned int>> stack;  // (ラベルトライの頂点, 次に見る文字)
+    stack.push_back({0, 0});
+    while (!stack.empty()) {
+        auto& [l, c] = stack.back();
+        if (c == k) {
+            stack.pop_back();
+            if (!label.empty()) {
+                label.pop_back();
             }
+            continue;
+        }
+        int next = trie.labelChild[l * k + c];
+        char symbol = alphabet[c];
+        ++c;
+        if (next == NONE) {
+            continue;
+        }
+        if (stack.size() == 1 && !emptyAdded && symbol >= 'E') {
+            addEmptyStates();
+            emptyAdded = true;
+        }
+        label.push_back(symbol);
+        addStates(trie.labelStates[next], label);
+        stack.push_back({next, 0});
+    }
+    if (!emptyAdded) {
+        addEmptyStates();
+    }
 
-            // 見つからなかった場合のみ空系列ノードへ遷移
-            if (!found) {
-                auto [isFound, emptyNode] = findNextNode("E", nextLabel.size());
-                if (isFound) {
-                    graph.addEdge(Edge(node, emptyNode, std::string(1, c)));
-                }
-            }
+    // 禁止ノード以外から各文字の遷移を追加
+    for (int s : order) {
+        if (trie.forbidden[s]) {
+            continue;
+        }
+        for (unsigned int c = 0; c < k; ++c) {
+            csr.addEdge(toId[s], toId[delta[s * k + c]], c);
         }
     }
 
-    return graph;
+    return Graph(std::move(csr));
 }
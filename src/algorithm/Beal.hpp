@@ -7,6 +7,9 @@
 #include "../core/constants.hpp"
 #include "GraphGenerator.hpp"
 
+// Béalアルゴリズムによるグラフ生成器
+// 禁止語の接頭辞を位相ごとのトライに格納し，失敗リンク (Aho–Corasick) で
+// 各遷移先「次の系列の最長の接尾辞となるノード」を償却O(1)で求める．
 class Beal : public GraphGenerator {
    public:
     // コンストラクタ
@@ -18,8 +21,4 @@ class Beal : public GraphGenerator {
    private:
     std::string alphabet;  // アルファベット
     unsigned int period;   // 周期
-
-    // ヘルパー関数
-    std::vector<Node> generateNodes(
-        const std::vector<Node>& forbiddenNodes) const;  // ノード生成のヘルパー関数
 };
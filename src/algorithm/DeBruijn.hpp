@@ -1,14 +1,14 @@
 #pragma once
 
-#include <functional>
-#include <unordered_map>
 #include <vector>
 
 #include "../core/Graph.hpp"
 #include "../core/Node.hpp"
-#include "../core/constants.hpp"
+#include "DeBruijnView.hpp"
 #include "GraphGenerator.hpp"
 
+// De Bruijnグラフ生成器
+// 基となるグラフは実体化せず DeBruijnView で表し，禁止ノードを除いた部分グラフのみを生成する．
 class DeBruijn : public GraphGenerator {
    public:
     // コンストラクタ
@@ -17,13 +17,12 @@ class DeBruijn : public GraphGenerator {
     // グラフ生成
     Graph generate(const std::vector<Node>& forbiddenNodes) const;
 
-   private:
-    std::string alphabet;     // アルファベット
-    unsigned int period;      // 周期
-    std::vector<Node> nodes;  // ノードリスト
-    std::vector<Edge> edges;  // エッジリスト
+    // シンクレスなグラフ生成 (刈り込み後に残ったノードのみ実体化)
+    Graph generateTrimmed(const std::vector<Node>& forbiddenNodes) const;
+
+    // 実体化しないグラフ
+    const DeBruijnView& getView() const { return view; }
 
-    // ヘルパー関数
-    void generateNodes(unsigned int wordLength, unsigned int period);  // ノード生成のヘルパー関数
-    void generateEdges();                                              // エッジ生成のヘルパー関数
+   private:
+    DeBruijnView view;  // 基となるDe Bruijnグラフ
 };
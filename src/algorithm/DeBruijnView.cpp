@@ -0,0 +1,249 @@
+#include "DeBruijnView.hpp"
+
+#include <Spectra/GenEigsSolver.h>
+
+#include <queue>
+#include <stdexcept>
+
+#include "../analysis/eigenvalues.hpp"
+#include "../core/CsrGraph.hpp"
+#include "../core/constants.hpp"
+
+namespace {
+
+// 生存ノードが誘導する部分グラフの隣接行列を x -> A x として作用させる (Spectra用)
+class AliveMatProd {
+   public:
+    using Scalar = double;
+
+    AliveMatProd(const DeBruijnView& view, const std::vector<bool>& alive) : view(view) {
+        const CsrGraph::Id dead = static_cast<CsrGraph::Id>(-1);
+        toCompact.assign(view.getNodeCount(), dead);
+        for (std::uint64_t v = 0; v < view.getNodeCount(); ++v) {
+            if (alive[v]) {
+                toCompact[v] = static_cast<CsrGraph::Id>(nodes.size());
+                nodes.push_back(v);
+            }
+        }
+    }
+
+    Eigen::Index rows() const { return nodes.size(); }
+    Eigen::Index cols() const { return nodes.size(); }
+
+    void perform_op(const Scalar* x_in, Scalar* y_out) const {
+        const CsrGraph::Id dead = static_cast<CsrGraph::Id>(-1);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            Scalar sum = 0;
+            view.forEachSuccessor(nodes[i], [&](std::uint64_t tgt, unsigned int) {
+                if (toCompact[tgt] != dead) {
+                    sum += x_in[toCompact[tgt]];
+                }
+            });
+            y_out[i] = sum;
+        }
+    }
+
+   private:
+    const DeBruijnView& view;
+    std::vector<std::uint64_t> nodes;     // 圧縮インデックス -> ノード
+    std::vector<CsrGraph::Id> toCompact;  // ノード -> 圧縮インデックス
+};
+
+}  // namespace
+
+// コンストラクタ
+DeBruijnView::DeBruijnView(unsigned int alphabetSize, unsigned int period,
+                           unsigned int wordLength)
+    : period(period), wordLength(wordLength), wordCount(1) {
+    alphabet = ALPHABET.substr(0, alphabetSize);
+    for (unsigned int i = 0; i < wordLength; ++i) {
+        if (wordCount > UINT32_MAX / alphabet.size()) {
+            throw std::overflow_error("DeBruijn graph is too large.");
+        }
+        wordCount *= alphabet.size();
+    }
+    if (wordCount * period > UINT32_MAX) {
+        throw std::overflow_error("DeBruijn graph is too large.");
+    }
+}
+
+// Nodeをインデックスに変換 (グラフに存在しないノードならfalse)
+bool DeBruijnView::encode(const Node& node, std::uint64_t& index) const {
+    const std::string& word = node.getLabel();
+    if (word.size() != wordLength || node.getPhase() >= period) {
+        return false;
+    }
+    std::uint64_t code = 0;
+    for (char c : word) {
+        auto digit = alphabet.find(c);
+        if (digit == std::string::npos) {
+            return false;
+        }
+        code = code * alphabet.size() + digit;
+    }
+    index = code * period + node.getPhase();
+    return true;
+}
+
+// k進数を語に復号 (先頭の文字が最上位桁)
+std::string DeBruijnView::decodeWord(std::uint64_t code) const {
+    std::string word(wordLength, alphabet[0]);
+    for (size_t i = wordLength; i-- > 0;) {
+        word[i] = alphabet[code % alphabet.size()];
+        code /= alphabet.size();
+    }
+    return word;
+}
+
+// インデックスをNodeに変換
+Node DeBruijnView::decode(std::uint64_t index) const {
+    return Node(decodeWord(index / period), index % period);
+}
+
+// 生存ノード集合を生成
+std::vector<bool> DeBruijnView::genAliveMask(const std::vector<Node>& forbiddenNodes) const {
+    std::vector<bool> alive(getNodeCount(), true);
+    for (const auto& node : forbiddenNodes) {
+        std::uint64_t index;
+        if (encode(node, index)) {
+            alive[index] = false;
+        }
+    }
+    return alive;
+}
+
+// 入次数または出次数が0のノードを繰り返し除去
+void DeBruijnView::trim(std::vector<bool>& alive) const {
+    const std::uint64_t n = getNodeCount();
+    std::vector<unsigned int> outDeg(n, 0);
+    std::vector<unsigned int> inDeg(n, 0);
+
+    for (std::uint64_t v = 0; v < n; ++v) {
+        if (!alive[v]) {
+            continue;
+        }
+        forEachSuccessor(v, [&](std::uint64_t tgt, unsigned int) {
+            if (alive[tgt]) {
+                outDeg[v]++;
+                inDeg[tgt]++;
+            }
+        });
+    }
+
+    std::queue<std::uint64_t> zeroDegNodes;
+    for (std::uint64_t v = 0; v < n; ++v) {
+        if (alive[v] && (outDeg[v] == 0 || inDeg[v] == 0)) {
+            alive[v] = false;
+            zeroDegNodes.push(v);
+        }
+    }
+
+    while (!zeroDegNodes.empty()) {
+        std::uint64_t current = zeroDegNodes.front();
+        zeroDegNodes.pop();
+
+        forEachSuccessor(current, [&](std::uint64_t tgt, unsigned int) {
+            if (alive[tgt] && --inDeg[tgt] == 0) {
+                alive[tgt] = false;
+                zeroDegNodes.push(tgt);
+            }
+        });
+        forEachPredecessor(current, [&](std::uint64_t src, unsigned int) {
+            if (alive[src] && --outDeg[src] == 0) {
+                alive[src] = false;
+                zeroDegNodes.push(src);
+            }
+        });
+    }
+}
+
+// 最大固有値を計算 (行列を作らずにSpectraで計算し，失敗時のみ部分グラフを実体化)
+double DeBruijnView::calcMaxEigenvalue(const std::vector<bool>& alive) const {
+    AliveMatProd op(*this, alive);
+    const int n = op.rows();
+    if (n == 0) {
+        return 0.0;
+    }
+
+    try {
+        const int nev = 1;
+        const int ncv = std::min(std::max(3, 2 * nev + 1), n - 1);
+
+        Spectra::GenEigsSolver<AliveMatProd> solver(op, nev, ncv);
+        solver.init();
+        int nconv = solver.compute(Spectra::SortRule::LargestReal);
+
+        if (solver.info() == Spectra::CompInfo::Successful && nconv > 0) {
+            return solver.eigenvalues()[0].real();
+        }
+    } catch (const std::exception&) {
+        // 下のフォールバックで計算
+    }
+    return calculateMaxEigenvalue(materialize(alive));
+}
+
+// 長さLの経路の数 (各ノードから長さrの経路数を動的計画法で求める)
+std::uint64_t DeBruijnView::countPathsOfLength(const std::vector<bool>& alive,
+                                               unsigned int length) const {
+    if (length == 0) {
+        return 0;
+    }
+
+    const std::uint64_t n = getNodeCount();
+    std::vector<std::uint64_t> count(n), next(n);
+    for (std::uint64_t v = 0; v < n; ++v) {
+        count[v] = alive[v] ? 1 : 0;
+    }
+
+    for (unsigned int step = 0; step < length; ++step) {
+        for (std::uint64_t v = 0; v < n; ++v) {
+            std::uint64_t sum = 0;
+            if (alive[v]) {
+                forEachSuccessor(v, [&](std::uint64_t tgt, unsigned int) { sum += count[tgt]; });
+            }
+            next[v] = sum;
+        }
+        count.swap(next);
+    }
+
+    std::uint64_t total = 0;
+    for (std::uint64_t v = 0; v < n; ++v) {
+        total += count[v];
+    }
+    return total;
+}
+
+// 生存ノードが誘導する部分グラフを実体化
+Graph DeBruijnView::materialize(const std::vector<bool>& alive) const {
+    const std::uint64_t n = getNodeCount();
+
+    CsrGraph csr;
+    for (char c : alphabet) {
+        csr.addSymbol(std::string(1, c));
+    }
+
+    const CsrGraph::Id removed = static_cast<CsrGraph::Id>(-1);
+    std::vector<CsrGraph::Id> toId(n, removed);
+    for (std::uint64_t w = 0; w < wordCount; ++w) {
+        std::string label = decodeWord(w);
+        for (unsigned int phase = 0; phase < period; ++phase) {
+            std::uint64_t index = w * period + phase;
+            if (alive[index]) {
+                toId[index] = csr.addNode(label, phase);
+            }
+        }
+    }
+
+    for (std::uint64_t v = 0; v < n; ++v) {
+        if (toId[v] == removed) {
+            continue;
+        }
+        forEachSuccessor(v, [&](std::uint64_t tgt, unsigned int symbol) {
+            if (toId[tgt] != removed) {
+                csr.addEdge(toId[v], toId[tgt], symbol);
+            }
+        });
+    }
+
+    return Graph(std::move(csr));
+}
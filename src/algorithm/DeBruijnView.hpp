@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../core/Graph.hpp"
+#include "../core/Node.hpp"
+
+// 実体化しないDe Bruijnグラフ
+// グラフは (アルファベット, 語長L, 周期) のみで表し，隣接ノードは必要な時に算術的に求める．
+// ノード (w, phase) のインデックスは w * period + phase (wは語のk進数表現)．
+// 部分グラフは生存ノードのビット集合 (alive) で表し，刈り込み・最大固有値・経路数の計算を
+// 実体化せずに行う．Graphとして実体化するのは最終的に残った部分グラフのみ．
+class DeBruijnView {
+   public:
+    // コンストラクタ
+    DeBruijnView(unsigned int alphabetSize, unsigned int period, unsigned int wordLength);
+
+    // ゲッター
+    std::uint64_t getNodeCount() const { return wordCount * period; }
+    unsigned int getAlphabetSize() const { return alphabet.size(); }
+    unsigned int getPeriod() const { return period; }
+    unsigned int getWordLength() const { return wordLength; }
+
+    // 後続ノードを列挙: f(target, symbol)
+    template <typename Func>
+    void forEachSuccessor(std::uint64_t node, Func f) const {
+        const std::uint64_t k = alphabet.size();
+        const std::uint64_t w = node / period;
+        const std::uint64_t nextPhase = (node % period + 1) % period;
+        for (std::uint64_t c = 0; c < k; ++c) {
+            f(((w * k + c) % wordCount) * period + nextPhase, static_cast<unsigned int>(c));
+        }
+    }
+
+    // 先行ノードを列挙: f(source, symbol)
+    template <typename Func>
+    void forEachPredecessor(std::uint64_t node, Func f) const {
+        const std::uint64_t k = alphabet.size();
+        const std::uint64_t w = node / period;
+        const std::uint64_t prevPhase = (node % period + period - 1) % period;
+        const std::uint64_t head = wordCount / k;  // k^(L-1)
+        const unsigned int symbol = static_cast<unsigned int>(w % k);
+        for (std::uint64_t c = 0; c < k; ++c) {
+            f((c * head + w / k) * period + prevPhase, symbol);
+        }
+    }
+
+    // Nodeとインデックスの変換
+    bool encode(const Node& node, std::uint64_t& index) const;
+    Node decode(std::uint64_t index) const;
+
+    // 禁止ノードを除いた生存ノード集合を生成
+    std::vector<bool> genAliveMask(const std::vector<Node>& forbiddenNodes) const;
+
+    // 入次数または出次数が0のノードを繰り返し除去 (cleanGraph と同じ結果)
+    void trim(std::vector<bool>& alive) const;
+
+    // 生存ノードが誘導する部分グラフの最大固有値
+    double calcMaxEigenvalue(const std::vector<bool>& alive) const;
+
+    // 生存ノードが誘導する部分グラフ上の長さLの経路の数
+    std::uint64_t countPathsOfLength(const std::vector<bool>& alive, unsigned int length) const;
+
+    // 生存ノードが誘導する部分グラフを実体化
+    Graph materialize(const std::vector<bool>& alive) const;
+
+   private:
+    std::string alphabet;     // アルファベット
+    unsigned int period;      // 周期
+    unsigned int wordLength;  // 語長L
+    std::uint64_t wordCount;  // 語の総数 k^L
+
+    std::string decodeWord(std::uint64_t code) const;  // k進数を語に復号
+};
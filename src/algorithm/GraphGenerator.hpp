@@ -4,6 +4,7 @@
 
 #include "../core/Graph.hpp"
 #include "../core/Node.hpp"
+#include "../utils/GraphUtils.hpp"
 
 class GraphGenerator {
    public:
@@ -11,4 +12,9 @@ class GraphGenerator {
 
     // 純粋仮想関数: グラフ生成
     virtual Graph generate(const std::vector<Node>& forbiddenNodes) const = 0;
+
+    // シンクレスなグラフ生成 (実体化前に刈り込める生成器はオーバーライドする)
+    virtual Graph generateTrimmed(const std::vector<Node>& forbiddenNodes) const {
+        return cleanGraph(generate(forbiddenNodes));
+    }
 };
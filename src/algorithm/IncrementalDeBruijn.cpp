@@ -0,0 +1,250 @@
+#include "IncrementalDeBruijn.hpp"
+
+#include <algorithm>
+
+#include "../utils/GraphUtils.hpp"
+
+// コンストラクタ
+IncrementalDeBruijn::IncrementalDeBruijn(unsigned int alphabetSize, unsigned int period,
+                                         unsigned int wordLength)
+    : view(alphabetSize, period, wordLength) {
+    reset({});
+}
+
+// 禁止集合を設定し直す
+void IncrementalDeBruijn::reset(const std::vector<Node>& forbiddenNodes) {
+    const std::uint64_t n = view.getNodeCount();
+    alive = view.genAliveMask(forbiddenNodes);
+    trimmed = alive;
+    view.trim(trimmed);
+
+    inDeg.assign(n, 0);
+    outDeg.assign(n, 0);
+    candidate.assign(n, false);
+    reached.assign(n, false);
+    perron.resize(n, 0.0);
+    for (std::uint64_t v = 0; v < n; ++v) {
+        if (!trimmed[v]) {
+            continue;
+        }
+        view.forEachSuccessor(v, [&](std::uint64_t tgt, unsigned int) {
+            if (trimmed[tgt]) {
+                outDeg[v]++;
+                inDeg[tgt]++;
+            }
+        });
+    }
+}
+
+// 禁止語を加える
+void IncrementalDeBruijn::forbid(const Node& node) {
+    std::uint64_t index;
+    if (!view.encode(node, index) || !alive[index]) {
+        return;
+    }
+    alive[index] = false;
+    if (trimmed[index]) {
+        remove(index);
+    }
+}
+
+// 禁止語を取り除く
+void IncrementalDeBruijn::allow(const Node& node) {
+    std::uint64_t index;
+    if (!view.encode(node, index) || alive[index]) {
+        return;
+    }
+    alive[index] = true;
+    restore(index);
+}
+
+// trimmed からノードを除き，次数が0になったノードを連鎖的に除く
+void IncrementalDeBruijn::remove(std::uint64_t node) {
+    trimmed[node] = false;
+    stack.assign(1, node);
+    while (!stack.empty()) {
+        std::uint64_t current = stack.back();
+        stack.pop_back();
+        view.forEachSuccessor(current, [&](std::uint64_t tgt, unsigned int) {
+            if (trimmed[tgt] && --inDeg[tgt] == 0) {
+                trimmed[tgt] = false;
+                stack.push_back(tgt);
+            }
+        });
+        view.forEachPredecessor(current, [&](std::uint64_t src, unsigned int) {
+            if (trimmed[src] && --outDeg[src] == 0) {
+                trimmed[src] = false;
+                stack.push_back(src);
+            }
+        });
+    }
+}
+
+// 生存に戻したノードを起点に，刈り込み済みのノードのうち復活するものを trimmed に戻す
+// 新たに残るノードは戻したノードを通る両側無限の経路上にあり，その経路のうち
+// 戻したノードとの間の片側は刈り込み済みのノードだけを通るので，
+// 刈り込み済みの生存ノードを前向き・後ろ向きに辿った範囲 (候補) だけを刈り込めばよい．
+void IncrementalDeBruijn::restore(std::uint64_t node) {
+    std::vector<std::uint64_t> candidates{node};
+    candidate[node] = true;
+    for (bool forwardSearch : {true, false}) {
+        // 向きごとに訪問済みの印を付け直す (前向きで見つけた候補からも後ろ向きに辿る)
+        std::vector<std::uint64_t> visited{node};
+        reached[node] = true;
+        stack.assign(1, node);
+        while (!stack.empty()) {
+            std::uint64_t current = stack.back();
+            stack.pop_back();
+            auto visit = [&](std::uint64_t next, unsigned int) {
+                if (alive[next] && !trimmed[next] && !reached[next]) {
+                    reached[next] = true;
+                    visited.push_back(next);
+                    stack.push_back(next);
+                    if (!candidate[next]) {
+                        candidate[next] = true;
+                        candidates.push_back(next);
+                    }
+                }
+            };
+            if (forwardSearch) {
+                view.forEachSuccessor(current, visit);
+            } else {
+                view.forEachPredecessor(current, visit);
+            }
+        }
+        for (std::uint64_t v : visited) {
+            reached[v] = false;
+        }
+    }
+
+    // 候補の次数を trimmed と候補の和集合の中で数え，次数0の候補を刈り込む
+    for (std::uint64_t v : candidates) {
+        inDeg[v] = 0;
+        outDeg[v] = 0;
+    }
+    for (std::uint64_t v : candidates) {
+        view.forEachSuccessor(v, [&](std::uint64_t tgt, unsigned int) {
+            if (trimmed[tgt] || candidate[tgt]) {
+                outDeg[v]++;
+            }
+            if (candidate[tgt]) {
+                inDeg[tgt]++;
+            }
+        });
+        view.forEachPredecessor(v, [&](std::uint64_t src, unsigned int) {
+            if (trimmed[src]) {
+                inDeg[v]++;
+            }
+        });
+    }
+
+    stack.clear();
+    for (std::uint64_t v : candidates) {
+        if (outDeg[v] == 0 || inDeg[v] == 0) {
+            candidate[v] = false;
+            stack.push_back(v);
+        }
+    }
+    while (!stack.empty()) {
+        std::uint64_t current = stack.back();
+        stack.pop_back();
+        view.forEachSuccessor(current, [&](std::uint64_t tgt, unsigned int) {
+            if (candidate[tgt] && --inDeg[tgt] == 0) {
+                candidate[tgt] = false;
+                stack.push_back(tgt);
+            }
+        });
+        view.forEachPredecessor(current, [&](std::uint64_t src, unsigned int) {
+            if (candidate[src] && --outDeg[src] == 0) {
+                candidate[src] = false;
+                stack.push_back(src);
+            }
+        });
+    }
+
+    // 残った候補と既存のノードの間の辺を既存のノードの次数に加えてから trimmed に戻す
+    for (std::uint64_t v : candidates) {
+        if (!candidate[v]) {
+            continue;
+        }
+        view.forEachSuccessor(v, [&](std::uint64_t tgt, unsigned int) {
+            if (trimmed[tgt]) {
+                inDeg[tgt]++;
+            }
+        });
+        view.forEachPredecessor(v, [&](std::uint64_t src, unsigned int) {
+            if (trimmed[src]) {
+                outDeg[src]++;
+            }
+        });
+    }
+    for (std::uint64_t v : candidates) {
+        if (candidate[v]) {
+            trimmed[v] = true;
+            candidate[v] = false;
+        }
+    }
+}
+
+// 刈り込み後の部分グラフが強連結か
+bool IncrementalDeBruijn::isStronglyConnected() const {
+    return ::isStronglyConnected(
+        trimmed,
+        [&](std::uint64_t v, const auto& visit) {
+            view.forEachSuccessor(v, [&](std::uint64_t next, unsigned int) { visit(next); });
+        },
+        [&](std::uint64_t v, const auto& visit) {
+            view.forEachPredecessor(v, [&](std::uint64_t next, unsigned int) { visit(next); });
+        });
+}
+
+// 最大固有値
+// 強連結なら前回のPerronベクトルから始めるべき乗法 (A + I は原始的なので上下界が一致する)，
+// 可約なら上下界が一致しないので実体化して通常の方法で計算する．
+double IncrementalDeBruijn::calcMaxEigenvalue(const EigenOptions& options) {
+    if (!isStronglyConnected()) {
+        return calculateMaxEigenvalue(generateTrimmed(), options);
+    }
+
+    const std::uint64_t n = view.getNodeCount();
+    const std::uint64_t dead = static_cast<std::uint64_t>(-1);
+    std::vector<std::uint64_t> toCompact(n, dead);
+    std::vector<std::uint64_t> nodes;
+    for (std::uint64_t v = 0; v < n; ++v) {
+        if (trimmed[v]) {
+            toCompact[v] = nodes.size();
+            nodes.push_back(v);
+        }
+    }
+    if (nodes.empty()) {
+        return 0.0;
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(nodes.size() * view.getAlphabetSize());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        view.forEachSuccessor(nodes[i], [&](std::uint64_t tgt, unsigned int) {
+            if (toCompact[tgt] != dead) {
+                triplets.emplace_back(i, toCompact[tgt], 1.0);
+            }
+        });
+    }
+    Eigen::SparseMatrix<double> matrix(nodes.size(), nodes.size());
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+
+    Eigen::VectorXd vector(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        vector[i] = perron[nodes[i]];
+    }
+    PerronRoot root = calculatePerronRoot(matrix, options, vector);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        perron[nodes[i]] = vector[i];
+    }
+
+    // 初期値が前回の解に偏っていると変化量からの外挿が過小になりうるため，
+    // Collatz–Wielandtの上下界が一致した場合のみ採用する
+    if (root.converged) {
+        return root.value;
+    }
+    return calculateMaxEigenvalue(generateTrimmed(), options);
+}
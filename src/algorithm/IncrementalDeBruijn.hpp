@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../analysis/eigenvalues.hpp"
+#include "../core/Graph.hpp"
+#include "../core/Node.hpp"
+#include "DeBruijnView.hpp"
+
+// 禁止語の追加・削除ごとに部分グラフを差分更新するDe Bruijnグラフ
+// 生存ノード集合と刈り込み後のノード集合，その中での入出次数を保持し，
+// 禁止語を1つ加える (forbid) と刈り込みの連鎖だけを，取り除く (allow) と
+// 復活しうるノード (そのノードから・へ刈り込み済みのノードを辿って届く範囲) だけを調べる．
+// 最大固有値は刈り込み後の部分グラフが強連結なら前回のPerronベクトルを初期値とするべき乗法で求める．
+class IncrementalDeBruijn {
+   public:
+    // コンストラクタ (禁止語なし)
+    IncrementalDeBruijn(unsigned int alphabetSize, unsigned int period, unsigned int wordLength);
+
+    // 禁止集合を設定し直す (差分ではなく全体から構築)
+    void reset(const std::vector<Node>& forbiddenNodes);
+
+    // 禁止語を加える・取り除く (グラフにない語は無視)
+    void forbid(const Node& node);
+    void allow(const Node& node);
+
+    // ゲッター
+    const DeBruijnView& getView() const { return view; }
+    const std::vector<bool>& getAliveMask() const { return alive; }
+    const std::vector<bool>& getTrimmedMask() const { return trimmed; }
+
+    // 現在の部分グラフ・刈り込み後の部分グラフを実体化
+    Graph generate() const { return view.materialize(alive); }
+    Graph generateTrimmed() const { return view.materialize(trimmed); }
+
+    // 刈り込み後の部分グラフの最大固有値 (刈り込みで最大固有値は変わらない)
+    double calcMaxEigenvalue(const EigenOptions& options = {});
+
+   private:
+    DeBruijnView view;
+    std::vector<bool> alive;            // 禁止語以外のノード
+    std::vector<bool> trimmed;          // 刈り込み後に残るノード
+    std::vector<unsigned int> inDeg;    // trimmed 内での入次数 (trimmed のノードのみ有効)
+    std::vector<unsigned int> outDeg;   // trimmed 内での出次数
+    std::vector<bool> candidate;        // allow で調べるノードの印 (作業用)
+    std::vector<bool> reached;          // allow の探索の訪問済みの印 (作業用)
+    std::vector<std::uint64_t> stack;   // 作業用
+    std::vector<double> perron;         // 前回のPerronベクトル (ノードごと)
+
+    void remove(std::uint64_t node);
+    void restore(std::uint64_t node);
+    bool isStronglyConnected() const;
+};
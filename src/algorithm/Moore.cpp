@@ -1,93 +1,229 @@
 #include "Moore.hpp"
 
-#include <numeric>  // For std::accumulate
-
-#include "../core/Edge.hpp"
+#include <algorithm>
+#include <utility>
 
 namespace Moore {
-Graph apply(const Graph& graph) {
-    const auto& adjList = graph.genAdjacencyList();
-
-    std::unordered_map<std::string, std::unordered_set<Node>> toNodes;
-    std::unordered_map<Node, std::string> toId;
-    initIDs(adjList, toNodes, toId);
-
-    std::unordered_map<std::string, std::unordered_set<Node>> toNewNodes;
-    std::unordered_map<Node, std::string> toNewId;
-    do {
-        toNewNodes.clear();
-        updateIDs(adjList, toNodes, toId, toNewNodes, toNewId);
-
-        toNodes.swap(toNewNodes);
-        toId.swap(toNewId);
-    } while (toNewNodes.size() != toNodes.size());
-
-    // ノードマッピング作成
-    std::unordered_map<Node, Node> toNewNode;
-    for (const auto& [id, nodes] : toNodes) {
-        const Node& newNode = *std::min_element(nodes.begin(), nodes.end(),
-                                                [](const Node& a, const Node& b) { return a < b; });
-        for (const auto& oldNode : nodes) {
-            toNewNode[oldNode] = newNode;
+
+namespace {
+
+constexpr int NONE = -1;
+
+// 遷移表 delta[s * k + a] を生成 (同じ記号の辺が複数ある場合は後のものを採用)
+std::vector<int> genTransitions(const CsrGraph& graph) {
+    const size_t k = graph.getSymbolCount();
+    std::vector<int> delta(graph.getNodeCount() * k, NONE);
+    for (size_t e = 0; e < graph.getEdgeCount(); ++e) {
+        delta[graph.getEdgeSource(e) * k + graph.getEdgeSymbol(e)] = graph.getEdgeTarget(e);
+    }
+    return delta;
+}
+
+// ブロックを連続区間で表す分割
+struct Partition {
+    std::vector<int> elems;    // ブロックごとに連続して並べた状態
+    std::vector<int> loc;      // 状態 -> elems内の位置
+    std::vector<int> blockOf;  // 状態 -> ブロック
+    std::vector<int> first;    // ブロックの先頭位置
+    std::vector<int> end;      // ブロックの終端位置
+    std::vector<int> marked;   // ブロック内で印の付いた状態数
+
+    Partition(int n, int sink) : elems(n), loc(n), blockOf(n, 0) {
+        for (int s = 0; s < n; ++s) {
+            elems[s] = s;
+            loc[s] = s;
         }
+        // 吸収状態 (末尾) を別ブロックとする
+        first = {0, sink};
+        end = {sink, n};
+        marked = {0, 0};
+        blockOf[sink] = 1;
     }
 
-    // グラフの再構築
-    Graph newGraph;
-    for (const auto& [_, nodes] : toNodes) {
-        const Node& src = *std::min_element(nodes.begin(), nodes.end(),
-                                            [](const Node& a, const Node& b) { return a < b; });
-        newGraph.addNode(src);
-        for (const auto& [label, tgt] : adjList.at(src)) {
-            newGraph.addEdge(Edge(src, toNewNode.at(tgt), label));
+    int size(int block) const { return end[block] - first[block]; }
+
+    // 状態に印を付け，ブロックの先頭側へ移動
+    void mark(int s) {
+        int b = blockOf[s];
+        int pos = first[b] + marked[b]++;
+        int other = elems[pos];
+        std::swap(elems[pos], elems[loc[s]]);
+        loc[other] = loc[s];
+        loc[s] = pos;
+    }
+
+    // 印の付いた部分を新しいブロックとして分離し，その番号を返す (分離しなければNONE)
+    int split(int b) {
+        int count = marked[b];
+        marked[b] = 0;
+        if (count == 0 || count == size(b)) {
+            return NONE;
+        }
+        int nb = first.size();
+        first.push_back(first[b]);
+        end.push_back(first[b] + count);
+        marked.push_back(0);
+        first[b] += count;
+        for (int i = first[nb]; i < end[nb]; ++i) {
+            blockOf[elems[i]] = nb;
         }
+        return nb;
     }
+};
 
-    return newGraph;
-}
+}  // namespace
 
-namespace {
-void initIDs(const std::unordered_map<Node, std::unordered_map<std::string, Node>>& adjList,
-             std::unordered_map<std::string, std::unordered_set<Node>>& toNodes,
-             std::unordered_map<Node, std::string>& toId) {
-    for (const auto& [node, edges] : adjList) {
-        std::vector<std::string> ids;
-        ids.reserve(edges.size());
-        for (const auto& [label, _] : edges) {
-            ids.push_back(label);
-        }
-        std::sort(ids.begin(), ids.end());
-        std::string id = std::accumulate(ids.begin(), ids.end(), std::string());
-
-        toNodes[id].emplace(node);
-        toId[node] = id;
+std::vector<CsrGraph::Id> computeClasses(const CsrGraph& graph) {
+    const int n = graph.getNodeCount();
+    const int k = graph.getSymbolCount();
+    if (n == 0) {
+        return {};
     }
-}
 
-void updateIDs(const std::unordered_map<Node, std::unordered_map<std::string, Node>>& adjList,
-               const std::unordered_map<std::string, std::unordered_set<Node>>& toNodes,
-               const std::unordered_map<Node, std::string>& toId,
-               std::unordered_map<std::string, std::unordered_set<Node>>& toNewNodes,
-               std::unordered_map<Node, std::string>& toNewId) {
-    for (const auto& [id, nodes] : toNodes) {
-        if (nodes.size() == 1) {
-            toNewNodes[id].insert(nodes.begin(), nodes.end());
-        } else {
-            for (const auto& src : nodes) {
-                std::string newId = id;
-
-                std::vector<std::string> ids;
-                for (const auto& [label, tgt] : adjList.at(src)) {
-                    ids.push_back(label + toId.at(tgt));
+    // 吸収状態 sink = n を加えて完全な遷移表にする
+    const int sink = n;
+    const int total = n + 1;
+    auto delta = genTransitions(graph);
+    delta.resize(static_cast<size_t>(total) * k, sink);
+    for (auto& t : delta) {
+        if (t == NONE) {
+            t = sink;
+        }
+    }
+
+    // 記号ごとの逆遷移 (CSR): inv[a] の t への遷移元は invSrc[invOff[a * (total + 1) + t] ..)
+    std::vector<int> invOff(static_cast<size_t>(k) * (total + 1), 0);
+    std::vector<int> invSrc(static_cast<size_t>(total) * k);
+    for (int a = 0; a < k; ++a) {
+        int* off = &invOff[static_cast<size_t>(a) * (total + 1)];
+        for (int s = 0; s < total; ++s) {
+            off[delta[static_cast<size_t>(s) * k + a] + 1]++;
+        }
+        for (int t = 0; t < total; ++t) {
+            off[t + 1] += off[t];
+        }
+        std::vector<int> cursor(off, off + total);
+        int* src = &invSrc[static_cast<size_t>(a) * total];
+        for (int s = 0; s < total; ++s) {
+            src[cursor[delta[static_cast<size_t>(s) * k + a]]++] = s;
+        }
+    }
+
+    Partition partition(total, sink);
+
+    // 作業リスト (ブロック, 記号)
+    std::vector<std::pair<int, int>> work;
+    std::vector<bool> inWork;
+    auto push = [&](int b, int a) {
+        if (inWork.size() < (b + 1) * static_cast<size_t>(k)) {
+            inWork.resize((b + 1) * static_cast<size_t>(k), false);
+        }
+        if (!inWork[b * k + a]) {
+            inWork[b * k + a] = true;
+            work.emplace_back(b, a);
+        }
+    };
+    for (int a = 0; a < k; ++a) {
+        push(partition.blockOf[sink], a);
+    }
+
+    std::vector<int> preimage;
+    std::vector<int> touched;
+    while (!work.empty()) {
+        auto [b, a] = work.back();
+        work.pop_back();
+        inWork[b * k + a] = false;
+
+        // 記号aでブロックbに遷移する状態を集める
+        preimage.clear();
+        const int* off = &invOff[static_cast<size_t>(a) * (total + 1)];
+        const int* src = &invSrc[static_cast<size_t>(a) * total];
+        for (int i = partition.first[b]; i < partition.end[b]; ++i) {
+            int t = partition.elems[i];
+            preimage.insert(preimage.end(), src + off[t], src + off[t + 1]);
+        }
+
+        touched.clear();
+        for (int s : preimage) {
+            int y = partition.blockOf[s];
+            if (partition.marked[y] == 0) {
+                touched.push_back(y);
+            }
+            partition.mark(s);
+        }
+
+        // 分離したブロックを作業リストに追加 (既にあれば両方，なければ小さい方)
+        for (int y : touched) {
+            int z = partition.split(y);
+            if (z == NONE) {
+                continue;
+            }
+            for (int c = 0; c < k; ++c) {
+                if (inWork.size() > y * static_cast<size_t>(k) + c && inWork[y * k + c]) {
+                    push(z, c);
+                } else {
+                    push(partition.size(z) < partition.size(y) ? z : y, c);
                 }
-                std::sort(ids.begin(), ids.end());
-                newId += std::accumulate(ids.begin(), ids.end(), newId);
+            }
+        }
+    }
 
-                toNewNodes[newId].emplace(src);
-                toNewId[src] = newId;
+    // 同値類番号を最小のノードIDの順に振り直す
+    std::vector<CsrGraph::Id> classes(n);
+    std::vector<int> toClass(partition.first.size(), NONE);
+    CsrGraph::Id next = 0;
+    for (int s = 0; s < n; ++s) {
+        int b = partition.blockOf[s];
+        if (toClass[b] == NONE) {
+            toClass[b] = next++;
+        }
+        classes[s] = toClass[b];
+    }
+    return classes;
+}
+
+Graph apply(const Graph& graph) {
+    const auto& csr = graph.getCsr();
+    const size_t n = csr.getNodeCount();
+    const size_t k = csr.getSymbolCount();
+
+    const auto classes = computeClasses(csr);
+    const auto delta = genTransitions(csr);
+    const size_t classCount = n == 0 ? 0 : *std::max_element(classes.begin(), classes.end()) + 1;
+
+    // 代表ノード (Nodeの順序で最小のもの) を選択
+    auto less = [&](CsrGraph::Id a, CsrGraph::Id b) {
+        if (csr.getLabel(a) != csr.getLabel(b)) {
+            return csr.getLabel(a) < csr.getLabel(b);
+        }
+        return csr.getPhase(a) < csr.getPhase(b);
+    };
+    std::vector<CsrGraph::Id> reps(classCount, static_cast<CsrGraph::Id>(-1));
+    for (CsrGraph::Id v = 0; v < n; ++v) {
+        auto& rep = reps[classes[v]];
+        if (rep == static_cast<CsrGraph::Id>(-1) || less(v, rep)) {
+            rep = v;
+        }
+    }
+
+    // グラフの再構築
+    CsrGraph newCsr;
+    for (size_t a = 0; a < k; ++a) {
+        newCsr.addSymbol(csr.getSymbol(a));
+    }
+    for (CsrGraph::Id rep : reps) {
+        newCsr.addNode(csr.getLabel(rep), csr.getPhase(rep));
+    }
+    for (size_t c = 0; c < classCount; ++c) {
+        for (size_t a = 0; a < k; ++a) {
+            int tgt = delta[reps[c] * k + a];
+            if (tgt != NONE) {
+                newCsr.addEdge(c, classes[tgt], a);
             }
         }
     }
+
+    return Graph(std::move(newCsr));
 }
-}  // namespace
+
 }  // namespace Moore
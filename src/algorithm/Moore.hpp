@@ -1,24 +1,19 @@
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
-#include "../core/Edge.hpp"
+#include "../core/CsrGraph.hpp"
 #include "../core/Graph.hpp"
-#include "../core/Node.hpp"
 
+// 決定的なラベル付きグラフの最小化
+// 遷移を持たない記号は仮想的な吸収状態への遷移とみなし，Hopcroftの分割細分化法で
+// 同値なノードをまとめる (O(m log n))．同値類の代表は (ラベル, 位相) が最小のノード．
 namespace Moore {
+
+// 最小化したグラフを生成
 Graph apply(const Graph& graph);
 
-namespace {
-void initIDs(const std::unordered_map<Node, std::unordered_map<std::string, Node>>& adjList,
-             std::unordered_map<std::string, std::unordered_set<Node>>& toNodes,
-             std::unordered_map<Node, std::string>& toId);
-void updateIDs(const std::unordered_map<Node, std::unordered_map<std::string, Node>>& adjList,
-               const std::unordered_map<std::string, std::unordered_set<Node>>& toNodes,
-               const std::unordered_map<Node, std::string>& toId,
-               std::unordered_map<std::string, std::unordered_set<Node>>& toNewNodes,
-               std::unordered_map<Node, std::string>& toNewId);
-}  // namespace
+// 各ノードの同値類番号を計算 (番号は同値類に属する最小のノードIDの順)
+std::vector<CsrGraph::Id> computeClasses(const CsrGraph& graph);
+
 };  // namespace Moore
@@ -0,0 +1,293 @@
+#include "SequenceCoder.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// bytes の pos ビット目から上位ビット順に n ビット (n <= 32，末尾より後は0)
+std::uint32_t readBits(const std::string& bytes, std::uint64_t pos, unsigned int n) {
+    std::uint64_t value = 0;
+    unsigned int bits = 0;
+    const unsigned int skip = pos % 8;
+    for (std::uint64_t i = pos / 8; bits < n + skip; ++i, bits += 8) {
+        value = value << 8 | (i < bytes.size() ? static_cast<unsigned char>(bytes[i]) : 0);
+    }
+    const std::uint64_t mask = (std::uint64_t{1} << n) - 1;
+    return static_cast<std::uint32_t>((value >> (bits - skip - n)) & mask);
+}
+
+// 上位ビット順にビットを受け取り，limit バイトまで書き出す
+class BitWriter {
+   public:
+    BitWriter(std::ostream& out, std::uint64_t limit) : out(out), limit(limit) {}
+
+    // value の下位 n ビット (n <= 32)
+    void write(std::uint32_t value, unsigned int n) {
+        buffer = buffer << n | value;
+        bits += n;
+        while (bits >= 8 && written < limit) {
+            bits -= 8;
+            out.put(static_cast<char>(buffer >> bits));
+            ++written;
+        }
+        buffer &= (std::uint64_t{1} << bits) - 1;
+    }
+
+    std::uint64_t getWritten() const { return written; }
+
+   private:
+    std::ostream& out;
+    std::uint64_t limit;
+    std::uint64_t written = 0;
+    std::uint64_t buffer = 0;
+    unsigned int bits = 0;
+};
+
+}  // namespace
+
+// コンストラクタ
+// 節点の番号は深さの順 (遷移先は遷移元より後) なので，後ろから系列数を確定させる．
+SequenceCoder::SequenceCoder(SequenceDawg dawg) : dawg(std::move(dawg)) {
+    const auto& d = this->dawg;
+    const auto& offsets = d.getOffsets();
+    const auto& targets = d.getTargets();
+    const size_t n = d.getNodeCount();
+    std::vector<BigUint> paths(n);
+    before.resize(d.getEdgeCount());
+    for (size_t v = n; v-- > 0;) {
+        if (offsets[v] == offsets[v + 1]) {
+            paths[v] = 1;
+        }
+        for (std::uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+            before[e] = paths[v];
+            paths[v] += paths[targets[e]];
+        }
+    }
+    if (n > 0) {
+        count = paths[0];
+    }
+    bitsPerWord = count.isZero() ? 0 : count.getBitLength() - 1;
+    if (count.fitsUint64()) {
+        beforeUint64.reserve(before.size());
+        for (const auto& value : before) {
+            beforeUint64.push_back(value.toUint64());
+        }
+    }
+
+    byteSymbol.fill(-1);
+    const auto& labels = d.getLabels();
+    if (!labels.empty() && labels[0].size() == 1) {
+        for (size_t s = 0; s < labels.size(); ++s) {
+            byteSymbol[static_cast<unsigned char>(labels[s][0])] = static_cast<int>(s);
+        }
+    }
+}
+
+SequenceCoder::SequenceCoder(const CsrGraph& graph, unsigned int length)
+    : SequenceCoder(SequenceDawg::build(graph, length)) {}
+
+// 系列の順位
+BigUint SequenceCoder::rank(const std::string& word) const {
+    checkLength(word);
+    BigUint index;
+    std::uint32_t node = 0;
+    for (unsigned int depth = 0; depth < dawg.getLength(); ++depth) {
+        const std::uint32_t edge = findEdge(node, word, depth);
+        index += before[edge];
+        node = dawg.getTargets()[edge];
+    }
+    return index;
+}
+
+std::uint64_t SequenceCoder::rankUint64(const std::string& word) const {
+    if (!count.fitsUint64()) {
+        throw std::overflow_error("The number of sequences does not fit in 64 bits.");
+    }
+    checkLength(word);
+    std::uint64_t index = 0;
+    std::uint32_t node = 0;
+    for (unsigned int depth = 0; depth < dawg.getLength(); ++depth) {
+        const std::uint32_t edge = findEdge(node, word, depth);
+        index += beforeUint64[edge];
+        node = dawg.getTargets()[edge];
+    }
+    return index;
+}
+
+// 順位 index の系列
+std::string SequenceCoder::unrank(const BigUint& index) const {
+    if (index >= count) {
+        throw std::out_of_range("Sequence index " + index.toString() + " is out of range.");
+    }
+    const auto& offsets = dawg.getOffsets();
+    std::string word;
+    BigUint rest = index;
+    std::uint32_t node = 0;
+    for (unsigned int depth = 0; depth < dawg.getLength(); ++depth) {
+        const auto edge = std::upper_bound(before.begin() + offsets[node] + 1,
+                                           before.begin() + offsets[node + 1], rest) -
+                          before.begin() - 1;
+        rest -= before[edge];
+        word += dawg.getLabels()[dawg.getSymbols()[edge]];
+        node = dawg.getTargets()[edge];
+    }
+    return word;
+}
+
+std::string SequenceCoder::unrankUint64(std::uint64_t index) const {
+    if (!count.fitsUint64()) {
+        throw std::overflow_error("The number of sequences does not fit in 64 bits.");
+    }
+    if (index >= count.toUint64()) {
+        throw std::out_of_range("Sequence index " + std::to_string(index) + " is out of range.");
+    }
+    const auto& offsets = dawg.getOffsets();
+    std::string word;
+    std::uint32_t node = 0;
+    for (unsigned int depth = 0; depth < dawg.getLength(); ++depth) {
+        const auto edge = std::upper_bound(beforeUint64.begin() + offsets[node] + 1,
+                                           beforeUint64.begin() + offsets[node + 1], index) -
+                          beforeUint64.begin() - 1;
+        index -= beforeUint64[edge];
+        word += dawg.getLabels()[dawg.getSymbols()[edge]];
+        node = dawg.getTargets()[edge];
+    }
+    return word;
+}
+
+// バイト列を系列に変換 (入力全体を読み込んでから変換する)
+std::uint64_t SequenceCoder::encode(std::istream& in, std::ostream& out) const {
+    if (bitsPerWord == 0) {
+        throw std::invalid_argument("At least two allowed sequences are needed to encode data.");
+    }
+    const std::string bytes((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+    const std::uint64_t totalBits = static_cast<std::uint64_t>(bytes.size()) * 8;
+    out << bytes.size() << '\n';
+
+    std::uint64_t words = 0;
+    for (std::uint64_t pos = 0; pos < totalBits; pos += bitsPerWord, ++words) {
+        if (bitsPerWord < 64) {
+            std::uint64_t value = 0;
+            for (unsigned int done = 0; done < bitsPerWord;) {
+                const unsigned int n = std::min<unsigned int>(32, bitsPerWord - done);
+                value = value << n | readBits(bytes, pos + done, n);
+                done += n;
+            }
+            out << unrankUint64(value) << '\n';
+            continue;
+        }
+        BigUint value;
+        for (size_t done = 0; done < bitsPerWord;) {
+            const auto n = static_cast<unsigned int>(std::min<size_t>(32, bitsPerWord - done));
+            const std::uint32_t chunk = readBits(bytes, pos + done, n);
+            for (unsigned int i = 0; i < n; ++i) {
+                if ((chunk >> (n - 1 - i)) & 1) {
+                    value.setBit(bitsPerWord - 1 - (done + i));
+                }
+            }
+            done += n;
+        }
+        out << unrank(value) << '\n';
+    }
+    return words;
+}
+
+// 系列をバイト列に戻す
+std::uint64_t SequenceCoder::decode(std::istream& in, std::ostream& out) const {
+    std::string line;
+    std::uint64_t byteCount = 0;
+    try {
+        if (!std::getline(in, line)) {
+            throw std::invalid_argument("empty");
+        }
+        size_t parsed = 0;
+        byteCount = std::stoull(line, &parsed);
+        if (parsed != line.size()) {
+            throw std::invalid_argument("trailing characters");
+        }
+    } catch (const std::logic_error&) {
+        throw std::invalid_argument("Encoded data must start with the byte count.");
+    }
+    if (byteCount > 0 && bitsPerWord == 0) {
+        throw std::invalid_argument("At least two allowed sequences are needed to decode data.");
+    }
+
+    BitWriter writer(out, byteCount);
+    while (writer.getWritten() < byteCount && std::getline(in, line)) {
+        if (bitsPerWord < 64) {
+            const std::uint64_t value = rankUint64(line);
+            if (value >> bitsPerWord != 0) {
+                throw std::invalid_argument("Not a valid encoded word: " + line);
+            }
+            for (unsigned int done = 0; done < bitsPerWord;) {
+                const unsigned int n = std::min<unsigned int>(32, bitsPerWord - done);
+                writer.write(static_cast<std::uint32_t>(value >> (bitsPerWord - done - n)) &
+                                 static_cast<std::uint32_t>((std::uint64_t{1} << n) - 1),
+                             n);
+                done += n;
+            }
+            continue;
+        }
+        const BigUint value = rank(line);
+        if (value.getBitLength() > bitsPerWord) {
+            throw std::invalid_argument("Not a valid encoded word: " + line);
+        }
+        for (size_t done = 0; done < bitsPerWord;) {
+            const auto n = static_cast<unsigned int>(std::min<size_t>(32, bitsPerWord - done));
+            std::uint32_t chunk = 0;
+            for (unsigned int i = 0; i < n; ++i) {
+                chunk = chunk << 1 | value.testBit(bitsPerWord - 1 - (done + i));
+            }
+            writer.write(chunk, n);
+            done += n;
+        }
+    }
+    if (writer.getWritten() < byteCount) {
+        throw std::invalid_argument("Encoded data is truncated.");
+    }
+    return byteCount;
+}
+
+// 系列の長さ (文字数) が合わない語は std::invalid_argument
+void SequenceCoder::checkLength(const std::string& word) const {
+    if (dawg.getNodeCount() == 0 ||
+        word.size() != dawg.getLabels()[0].size() * dawg.getLength()) {
+        throw std::invalid_argument("Not an allowed sequence: " + word);
+    }
+}
+
+// word の position 文字目からのラベルの記号 (なければ -1)
+int SequenceCoder::findSymbol(const std::string& word, size_t position) const {
+    const auto& labels = dawg.getLabels();
+    if (labels[0].size() == 1) {
+        return byteSymbol[static_cast<unsigned char>(word[position])];
+    }
+    const size_t width = labels[0].size();
+    const auto it = std::lower_bound(labels.begin(), labels.end(), word,
+                                     [&](const std::string& label, const std::string& w) {
+                                         return w.compare(position, width, label) > 0;
+                                     });
+    if (it == labels.end() || word.compare(position, width, *it) != 0) {
+        return -1;
+    }
+    return static_cast<int>(it - labels.begin());
+}
+
+// 節点 node から word の depth 番目のラベルで辿る遷移 (なければ std::invalid_argument)
+std::uint32_t SequenceCoder::findEdge(std::uint32_t node, const std::string& word,
+                                      unsigned int depth) const {
+    const int symbol = findSymbol(word, depth * dawg.getLabels()[0].size());
+    const auto& offsets = dawg.getOffsets();
+    const auto& symbols = dawg.getSymbols();
+    const auto begin = symbols.begin() + offsets[node];
+    const auto end = symbols.begin() + offsets[node + 1];
+    const auto edge = std::lower_bound(begin, end, static_cast<std::uint32_t>(symbol));
+    if (symbol < 0 || edge == end || *edge != static_cast<std::uint32_t>(symbol)) {
+        throw std::invalid_argument("Not an allowed sequence: " + word);
+    }
+    return static_cast<std::uint32_t>(edge - symbols.begin());
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../core/CsrGraph.hpp"
+#include "../utils/BigUint.hpp"
+#include "SequenceDawg.hpp"
+
+// 長さLの許可系列と辞書順の順位 (0始まり) の対応 (数え上げ符号)
+// 最小のDAWGの各遷移について，同じ節点から出る辞書順で前の遷移の先の系列数の和を前もって数える．
+// 順位付けは辿った遷移の和を足し，逆順位付けは和を超えない最後の遷移を二分探索で選んで引くので，
+// 1語あたり O(L log k) 回の足し引き (k は記号数) で系列を列挙せずに変換できる．
+// 系列数が std::uint64_t に収まる場合は固定長の整数で計算する．
+class SequenceCoder {
+   public:
+    explicit SequenceCoder(SequenceDawg dawg);
+
+    // グラフの長さLの許可系列から構築 (辺ラベルの長さがそろっていなければ std::invalid_argument)
+    SequenceCoder(const CsrGraph& graph, unsigned int length);
+
+    // 系列の数
+    const BigUint& getCount() const { return count; }
+
+    // 1語に載せるビット数 (floor(log2 系列数)，系列が1つ以下なら0)
+    size_t getBitsPerWord() const { return bitsPerWord; }
+
+    // 系列の順位 (集合にない語なら std::invalid_argument)
+    BigUint rank(const std::string& word) const;
+
+    // 順位 index の系列 (index が系列数以上なら std::out_of_range)
+    std::string unrank(const BigUint& index) const;
+
+    // 固定長の整数での順位付け・逆順位付け (系列数が std::uint64_t に収まらなければ
+    // std::overflow_error，他は rank / unrank と同じ)
+    std::uint64_t rankUint64(const std::string& word) const;
+    std::string unrankUint64(std::uint64_t index) const;
+
+    // バイト列を上位ビットから getBitsPerWord() ビットずつ (末尾は0で埋める) 系列に変換して
+    // 1行目に元のバイト数，以降に1行1語で書き出し，語数を返す (1語に載るビットがなければ
+    // std::invalid_argument)
+    std::uint64_t encode(std::istream& in, std::ostream& out) const;
+
+    // encode の出力をバイト列に戻して書き出し，バイト数を返す
+    // 形式が違うか，集合にない語か順位が getBitsPerWord() ビットに収まらない語があれば
+    // std::invalid_argument
+    std::uint64_t decode(std::istream& in, std::ostream& out) const;
+
+    const SequenceDawg& getDawg() const { return dawg; }
+
+   private:
+    SequenceDawg dawg;
+    BigUint count;
+    size_t bitsPerWord = 0;
+    std::vector<BigUint> before;              // 遷移 -> 同じ節点の前の遷移の先の系列数の和
+    std::vector<std::uint64_t> beforeUint64;  // before の固定長版 (収まらなければ空)
+    std::array<int, 256> byteSymbol;          // 1文字のラベル -> 記号 (なければ -1)
+
+    void checkLength(const std::string& word) const;
+    int findSymbol(const std::string& word, size_t position) const;
+    std::uint32_t findEdge(std::uint32_t node, const std::string& word, unsigned int depth) const;
+};
@@ -0,0 +1,225 @@
+#include "SequenceDawg.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+
+constexpr std::uint32_t UNSET = std::numeric_limits<std::uint32_t>::max();
+
+}  // namespace
+
+// コンストラクタ
+SequenceDawg::SequenceDawg(unsigned int length, std::vector<std::string> labels,
+                           std::vector<std::uint32_t> offsets, std::vector<std::uint32_t> symbols,
+                           std::vector<std::uint32_t> targets)
+    : length(length),
+      labels(std::move(labels)),
+      offsets(std::move(offsets)),
+      symbols(std::move(symbols)),
+      targets(std::move(targets)) {
+    const auto& l = this->labels;
+    for (size_t s = 1; s < l.size(); ++s) {
+        if (!(l[s - 1] < l[s]) || l[s].size() != l[0].size()) {
+            throw std::invalid_argument("DAWG labels must be sorted, unique and of equal length.");
+        }
+    }
+    const auto& o = this->offsets;
+    const auto& sym = this->symbols;
+    const auto& tgt = this->targets;
+    if (o.empty() || o.front() != 0 || o.back() != sym.size() || sym.size() != tgt.size() ||
+        o.size() - 1 > UNSET) {
+        throw std::invalid_argument("DAWG offsets do not match the transitions.");
+    }
+    if (length == 0 && o.size() > 1) {
+        throw std::invalid_argument("DAWG of length 0 must be empty.");
+    }
+
+    // 根からの深さを番号順に確定させる (遷移先は遷移元より後なので先に確定している)
+    const size_t n = o.size() - 1;
+    std::vector<std::uint32_t> depth(n, UNSET);
+    if (n > 0) {
+        depth[0] = 0;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        if (o[v] > o[v + 1] || depth[v] == UNSET || (depth[v] == length) != (o[v] == o[v + 1])) {
+            throw std::invalid_argument("DAWG node " + std::to_string(v) +
+                                        " is unreachable or not on a path of the length.");
+        }
+        for (std::uint32_t e = o[v]; e < o[v + 1]; ++e) {
+            const std::uint32_t t = tgt[e];
+            if (sym[e] >= l.size() || (e > o[v] && sym[e - 1] >= sym[e]) || t <= v || t >= n ||
+                (depth[t] != UNSET && depth[t] != depth[v] + 1)) {
+                throw std::invalid_argument("DAWG node " + std::to_string(v) +
+                                            " has an invalid transition.");
+            }
+            depth[t] = depth[v] + 1;
+        }
+    }
+}
+
+// グラフから構築
+// 決定化したオートマトンの状態を根からの深さごとに集め (残りの長さの経路がある状態だけ)，
+// 深い段から順に (記号, 遷移先の節点) の列が同じ状態を1つの節点にまとめる．
+// 残りの長さが異なる節点は受理する系列の長さが異なるので，段ごとにまとめれば最小になる．
+SequenceDawg SequenceDawg::build(const CsrGraph& graph, unsigned int length) {
+    SequenceEnumerator enumerator(graph);
+    if (!enumerator.hasUniformLabels()) {
+        throw std::invalid_argument("DAWG output requires edge labels of equal length.");
+    }
+    const auto& order = enumerator.getSymbolOrder();
+    std::vector<std::string> labels;
+    for (CsrGraph::Id symbol : order) {
+        labels.push_back(graph.getSymbol(symbol));
+    }
+    if (length == 0 || graph.getNodeCount() == 0) {
+        return SequenceDawg(length, std::move(labels), {0}, {}, {});
+    }
+    const int initial = enumerator.getInitialState();
+    if (enumerator.getStateReach(initial) < length) {
+        return SequenceDawg(length, std::move(labels), {0}, {}, {});
+    }
+
+    // 深さごとの状態
+    std::vector<std::vector<int>> levels(length + 1);
+    levels[0].push_back(initial);
+    for (unsigned int depth = 0; depth < length; ++depth) {
+        std::unordered_set<int> seen;
+        for (int state : levels[depth]) {
+            for (CsrGraph::Id symbol : order) {
+                const int child = enumerator.getTransition(state, symbol);
+                if (child != SequenceEnumerator::NONE &&
+                    enumerator.getStateReach(child) >= length - depth - 1 &&
+                    seen.insert(child).second) {
+                    levels[depth + 1].push_back(child);
+                }
+            }
+        }
+    }
+
+    // 深い段から節点にまとめる (節点の番号は仮のもの，深さLの節点は0のみ)
+    using Signature = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+    std::vector<Signature> signatures{{}};
+    std::vector<unsigned int> nodeDepth{length};
+    std::unordered_map<int, std::uint32_t> below;  // 1つ深い段の状態 -> 節点
+    for (int state : levels[length]) {
+        below.emplace(state, 0);
+    }
+    for (unsigned int depth = length; depth-- > 0;) {
+        std::map<Signature, std::uint32_t> registry;
+        std::unordered_map<int, std::uint32_t> current;
+        for (int state : levels[depth]) {
+            Signature signature;
+            for (std::uint32_t rank = 0; rank < order.size(); ++rank) {
+                const auto it = below.find(enumerator.getTransition(state, order[rank]));
+                if (it != below.end()) {
+                    signature.emplace_back(rank, it->second);
+                }
+            }
+            auto [entry, inserted] =
+                registry.emplace(signature, static_cast<std::uint32_t>(signatures.size()));
+            if (inserted) {
+                signatures.push_back(std::move(signature));
+                nodeDepth.push_back(depth);
+            }
+            current.emplace(state, entry->second);
+        }
+        below = std::move(current);
+    }
+
+    // 根から幅優先で番号を振り直す (深さの順，同じ深さでは辞書順に初めて届いた順)
+    const std::uint32_t root = below.at(initial);
+    std::vector<std::uint32_t> renumber(signatures.size(), UNSET);
+    std::vector<std::uint32_t> queue{root};
+    renumber[root] = 0;
+    std::vector<std::uint32_t> offsets{0}, symbols, targets;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        for (const auto& [symbol, target] : signatures[queue[head]]) {
+            if (renumber[target] == UNSET) {
+                renumber[target] = static_cast<std::uint32_t>(queue.size());
+                queue.push_back(target);
+            }
+            symbols.push_back(symbol);
+            targets.push_back(renumber[target]);
+        }
+        offsets.push_back(static_cast<std::uint32_t>(symbols.size()));
+    }
+    return SequenceDawg(length, std::move(labels), std::move(offsets), std::move(symbols),
+                        std::move(targets));
+}
+
+// 系列を含むか (ラベルの長さごとに区切り，記号を二分探索で辿る)
+bool SequenceDawg::contains(const std::string& word) const {
+    if (getNodeCount() == 0 || word.size() != labels[0].size() * length) {
+        return false;
+    }
+    const size_t width = labels[0].size();
+    std::uint32_t node = 0;
+    for (unsigned int i = 0; i < length; ++i) {
+        const std::string chunk = word.substr(i * width, width);
+        const auto label = std::lower_bound(labels.begin(), labels.end(), chunk);
+        if (label == labels.end() || *label != chunk) {
+            return false;
+        }
+        const auto symbol = static_cast<std::uint32_t>(label - labels.begin());
+        const auto begin = symbols.begin() + offsets[node];
+        const auto end = symbols.begin() + offsets[node + 1];
+        const auto edge = std::lower_bound(begin, end, symbol);
+        if (edge == end || *edge != symbol) {
+            return false;
+        }
+        node = targets[edge - symbols.begin()];
+    }
+    return true;
+}
+
+// 系列を辞書順に列挙 (反復的な深さ優先探索)
+std::uint64_t SequenceDawg::forEach(const Visit& visit) const {
+    if (getNodeCount() == 0) {
+        return 0;
+    }
+    const size_t width = labels[0].size();
+    std::uint64_t count = 0;
+    std::string word;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack{{0, offsets[0]}};  // 節点, 次の遷移
+    while (!stack.empty()) {
+        auto& [node, edge] = stack.back();
+        if (edge == offsets[node + 1]) {
+            stack.pop_back();
+            continue;
+        }
+        word.resize((stack.size() - 1) * width);
+        word += labels[symbols[edge]];
+        const std::uint32_t target = targets[edge++];
+        if (stack.size() == length) {
+            visit(word);
+            ++count;
+        } else {
+            stack.emplace_back(target, offsets[target]);
+        }
+    }
+    return count;
+}
+
+// 系列の数 (番号の大きい節点から根への経路数を数える)
+BigUint SequenceDawg::count() const {
+    const size_t n = getNodeCount();
+    if (n == 0) {
+        return BigUint();
+    }
+    std::vector<BigUint> paths(n);
+    for (size_t v = n; v-- > 0;) {
+        if (offsets[v] == offsets[v + 1]) {
+            paths[v] = 1;
+        }
+        for (std::uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+            paths[v] += paths[targets[e]];
+        }
+    }
+    return paths[0];
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../core/CsrGraph.hpp"
+#include "../utils/BigUint.hpp"
+#include "SequenceEnumerator.hpp"
+
+// 長さLの許可系列の集合を表す最小の非巡回決定性オートマトン (DAWG)
+// 節点 0 が根で，根から長さLの経路の記号列 (記号は辺ラベルの辞書順の番号) が系列に対応する．
+// 節点は根からの深さの順に番号を振るので，遷移先は常に遷移元より大きい番号になる．
+// 辺ラベルの長さがそろっている場合だけ表せる (記号列と系列が1対1に対応する)．
+class SequenceDawg {
+   public:
+    using Visit = SequenceEnumerator::Visit;
+
+    SequenceDawg() = default;
+
+    // 配列から構築 (節点 v の遷移は offsets[v]..offsets[v+1]-1 番目の symbols / targets)
+    // ラベルが辞書順で長さがそろっていない，遷移が記号の昇順でない，遷移先が遷移元以下，
+    // 深さLの節点以外に遷移のない節点がある場合 (L = 0 なら節点がある場合) は std::invalid_argument
+    SequenceDawg(unsigned int length, std::vector<std::string> labels,
+                 std::vector<std::uint32_t> offsets, std::vector<std::uint32_t> symbols,
+                 std::vector<std::uint32_t> targets);
+
+    // グラフの長さLの許可系列から構築 (系列は列挙しない)
+    // 辺ラベルの長さがそろっていなければ std::invalid_argument
+    static SequenceDawg build(const CsrGraph& graph, unsigned int length);
+
+    // 系列を含むか
+    bool contains(const std::string& word) const;
+
+    // 系列を辞書順に visit へ渡し，その数を返す
+    std::uint64_t forEach(const Visit& visit) const;
+
+    // 系列の数 (任意精度)
+    BigUint count() const;
+
+    // 系列の長さ (記号数)
+    unsigned int getLength() const { return length; }
+
+    // 記号 -> ラベル (辞書順)
+    const std::vector<std::string>& getLabels() const { return labels; }
+
+    // 節点数・遷移数 (系列がなければ0)
+    size_t getNodeCount() const { return offsets.size() - 1; }
+    size_t getEdgeCount() const { return symbols.size(); }
+
+    const std::vector<std::uint32_t>& getOffsets() const { return offsets; }
+    const std::vector<std::uint32_t>& getSymbols() const { return symbols; }
+    const std::vector<std::uint32_t>& getTargets() const { return targets; }
+
+   private:
+    unsigned int length = 0;
+    std::vector<std::string> labels;
+    std::vector<std::uint32_t> offsets{0};
+    std::vector<std::uint32_t> symbols;
+    std::vector<std::uint32_t> targets;
+};
@@ -0,0 +1,225 @@
+#include "SequenceEnumerator.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <set>
+
+namespace {
+
+// 閉路に届くノードの経路の最大長
+constexpr unsigned int UNBOUNDED = std::numeric_limits<unsigned int>::max();
+
+}  // namespace
+
+// コンストラクタ
+SequenceEnumerator::SequenceEnumerator(const CsrGraph& graph) : graph(graph) {
+    const size_t k = graph.getSymbolCount();
+    symbolOrder.resize(k);
+    std::iota(symbolOrder.begin(), symbolOrder.end(), 0);
+    std::sort(symbolOrder.begin(), symbolOrder.end(), [&](CsrGraph::Id a, CsrGraph::Id b) {
+        return graph.getSymbol(a) < graph.getSymbol(b);
+    });
+    for (CsrGraph::Id s = 1; s < k; ++s) {
+        uniformLabels = uniformLabels && graph.getSymbol(s).size() == graph.getSymbol(0).size();
+    }
+    genReach();
+}
+
+// 長さLの語を辞書順に列挙
+std::uint64_t SequenceEnumerator::enumerate(unsigned int length, const Visit& visit) {
+    return enumerate(length, visit, {});
+}
+
+// 接頭辞で始まる長さLの語を辞書順に列挙
+std::uint64_t SequenceEnumerator::enumerate(unsigned int length, const Visit& visit,
+                                            const std::vector<CsrGraph::Id>& prefix) {
+    if (length == 0 || graph.getNodeCount() == 0 || prefix.size() > length) {
+        return 0;
+    }
+    int state = getInitialState();
+    std::string word;
+    for (CsrGraph::Id symbol : prefix) {
+        state = getTransition(state, symbol);
+        if (state == NONE) {
+            return 0;
+        }
+        word += graph.getSymbol(symbol);
+    }
+    const auto rest = length - static_cast<unsigned int>(prefix.size());
+    if (stateReach[state] < rest) {
+        return 0;
+    }
+    if (uniformLabels) {
+        return search(state, std::move(word), rest, visit);
+    }
+
+    // ラベル列が異なっても同じ語になりうるので集めて重複を除く
+    std::set<std::string> words;
+    search(state, std::move(word), rest, [&](const std::string& w) { words.insert(w); });
+    for (const auto& w : words) {
+        visit(w);
+    }
+    return words.size();
+}
+
+// 分割して列挙するための接頭辞
+// 幅優先で1記号ずつ伸ばし，各段では親の順に子を記号の辞書順に並べるので接頭辞は辞書順に並ぶ．
+std::vector<std::vector<CsrGraph::Id>> SequenceEnumerator::genPrefixes(unsigned int length,
+                                                                       size_t minCount) {
+    if (length == 0 || graph.getNodeCount() == 0) {
+        return {};
+    }
+    const int initial = getInitialState();
+    if (stateReach[initial] < length) {
+        return {};
+    }
+    std::vector<std::pair<std::vector<CsrGraph::Id>, int>> level{{{}, initial}};
+    for (unsigned int depth = 1; depth <= length && level.size() < minCount; ++depth) {
+        std::vector<std::pair<std::vector<CsrGraph::Id>, int>> next;
+        for (const auto& [prefix, state] : level) {
+            for (CsrGraph::Id symbol : symbolOrder) {
+                const int child = getTransition(state, symbol);
+                if (child == NONE || stateReach[child] < length - depth) {
+                    continue;
+                }
+                next.emplace_back(prefix, child);
+                next.back().first.push_back(symbol);
+            }
+        }
+        level = std::move(next);
+    }
+
+    std::vector<std::vector<CsrGraph::Id>> prefixes;
+    prefixes.reserve(level.size());
+    for (auto& entry : level) {
+        prefixes.push_back(std::move(entry.first));
+    }
+    return prefixes;
+}
+
+// 各ノードから辿れる経路の最大長
+// 出辺のないノードから逆向きに確定させ (後続がすべて確定したら 1 + 最大値)，確定しないノードは閉路に届く．
+void SequenceEnumerator::genReach() {
+    const size_t n = graph.getNodeCount();
+    const auto& outOffsets = graph.getOutOffsets();
+    const auto& inOffsets = graph.getInOffsets();
+    const auto& inSources = graph.getInSources();
+    reach.assign(n, UNBOUNDED);
+    std::vector<unsigned int> longest(n, 0);
+    std::vector<CsrGraph::Id> remaining(n), queue;
+    for (CsrGraph::Id v = 0; v < n; ++v) {
+        remaining[v] = outOffsets[v + 1] - outOffsets[v];
+        if (remaining[v] == 0) {
+            queue.push_back(v);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const CsrGraph::Id v = queue[head];
+        reach[v] = longest[v];
+        for (CsrGraph::Id e = inOffsets[v]; e < inOffsets[v + 1]; ++e) {
+            const CsrGraph::Id u = inSources[e];
+            longest[u] = std::max(longest[u], reach[v] + 1);
+            if (--remaining[u] == 0) {
+                queue.push_back(u);
+            }
+        }
+    }
+}
+
+// ノード集合の状態 (なければ追加)
+int SequenceEnumerator::addState(std::vector<CsrGraph::Id> nodes) {
+    auto [it, inserted] = stateIndex.emplace(std::move(nodes), static_cast<int>(members.size()));
+    if (inserted) {
+        unsigned int maxReach = 0;
+        for (CsrGraph::Id v : it->first) {
+            maxReach = std::max(maxReach, reach[v]);
+        }
+        members.push_back(it->first);
+        stateReach.push_back(maxReach);
+        transitions.resize(transitions.size() + graph.getSymbolCount(), UNKNOWN);
+    }
+    return it->second;
+}
+
+// 始状態 (全ノード)
+int SequenceEnumerator::getInitialState() {
+    if (members.empty()) {
+        std::vector<CsrGraph::Id> all(graph.getNodeCount());
+        std::iota(all.begin(), all.end(), 0);
+        return addState(std::move(all));
+    }
+    return 0;
+}
+
+// 遷移先 (未計算なら状態の全記号の遷移を計算)
+int SequenceEnumerator::getTransition(int state, CsrGraph::Id symbol) {
+    const size_t k = graph.getSymbolCount();
+    if (transitions[state * k + symbol] == UNKNOWN) {
+        expand(state);
+    }
+    return transitions[state * k + symbol];
+}
+
+// 状態の全記号の遷移を計算
+void SequenceEnumerator::expand(int state) {
+    const size_t k = graph.getSymbolCount();
+    const auto& offsets = graph.getOutOffsets();
+    const auto& targets = graph.getOutTargets();
+    const auto& symbols = graph.getOutSymbols();
+    std::vector<std::vector<CsrGraph::Id>> next(k);
+    for (CsrGraph::Id v : members[state]) {
+        for (CsrGraph::Id e = offsets[v]; e < offsets[v + 1]; ++e) {
+            next[symbols[e]].push_back(targets[e]);
+        }
+    }
+    for (CsrGraph::Id s = 0; s < k; ++s) {
+        auto& nodes = next[s];
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        const int target = nodes.empty() ? NONE : addState(std::move(nodes));
+        transitions[state * k + s] = target;
+    }
+}
+
+// 決定化したオートマトン上の反復的な深さ優先探索 (記号は辞書順に辿る)
+// state から残り rest 記号の語を word に続けて visit へ渡す．
+std::uint64_t SequenceEnumerator::search(int state, std::string word, unsigned int rest,
+                                         const Visit& visit) {
+    struct Frame {
+        int state;
+        size_t next;        // 次に辿る記号 (symbolOrder の添字)
+        size_t prefixSize;  // この深さでの語の長さ
+    };
+
+    if (rest == 0) {
+        visit(word);
+        return 1;
+    }
+
+    const size_t k = graph.getSymbolCount();
+    std::uint64_t count = 0;
+    std::vector<Frame> stack{{state, 0, word.size()}};
+    while (!stack.empty()) {
+        if (stack.back().next == k) {
+            stack.pop_back();
+            continue;
+        }
+        const CsrGraph::Id symbol = symbolOrder[stack.back().next++];
+        const int child = getTransition(stack.back().state, symbol);
+        const unsigned int remaining = rest - static_cast<unsigned int>(stack.size());
+        if (child == NONE || stateReach[child] < remaining) {
+            continue;
+        }
+
+        word.resize(stack.back().prefixSize);
+        word += graph.getSymbol(symbol);
+        if (remaining == 0) {
+            visit(word);
+            ++count;
+        } else {
+            stack.push_back({child, 0, word.size()});
+        }
+    }
+    return count;
+}
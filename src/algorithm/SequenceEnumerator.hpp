@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../core/CsrGraph.hpp"
+
+// 許可系列 (長さLの経路の辺ラベルを繋げた語) を重複なく辞書順に列挙
+// 部分集合構成で決定化したオートマトン (始状態は全ノード，遷移先のノード集合を状態とする) を
+// 反復的な深さ優先探索で辿るので，各語はちょうど1つの経路に対応し，作業領域は探索の深さ分で済む．
+// 状態と遷移は必要になった時点で作り，残りの長さの経路がない状態には入らない．
+// 辺ラベルの長さがそろっていない場合は異なるラベル列が同じ語になりうるため，集めて整列してから渡す．
+class SequenceEnumerator {
+   public:
+    using Visit = std::function<void(const std::string&)>;
+
+    static constexpr int NONE = -1;  // 遷移先なし
+
+    // graph は SequenceEnumerator より長く生存すること
+    explicit SequenceEnumerator(const CsrGraph& graph);
+
+    // 長さLの語を辞書順に visit へ渡し，その数を返す (L = 0 なら何も渡さない)
+    std::uint64_t enumerate(unsigned int length, const Visit& visit);
+
+    // 記号列 prefix (記号のID) で始まる長さLの語を辞書順に visit へ渡し，その数を返す
+    std::uint64_t enumerate(unsigned int length, const Visit& visit,
+                            const std::vector<CsrGraph::Id>& prefix);
+
+    // 長さLの語の接頭辞となる記号列を辞書順に返す (分割して列挙する場合の区間)
+    // 数が minCount 以上になるか長さがLになるまで1記号ずつ伸ばす (語がなければ空)．
+    // 辺ラベルの長さがそろっていれば，各接頭辞の語を順に繋げると全体の辞書順になる．
+    std::vector<std::vector<CsrGraph::Id>> genPrefixes(unsigned int length, size_t minCount);
+
+    // 辺ラベルの長さがそろっているか
+    bool hasUniformLabels() const { return uniformLabels; }
+
+    // これまでに作った決定化後の状態数
+    size_t getStateCount() const { return members.size(); }
+
+    // 決定化したオートマトンを辿る (遷移先がなければ NONE，遷移は必要になった時点で作る)
+    int getInitialState();
+    int getTransition(int state, CsrGraph::Id symbol);
+
+    // 状態から辿れる経路の最大長 (閉路に届けば上限値)
+    unsigned int getStateReach(int state) const { return stateReach[state]; }
+
+    // 辺ラベルの辞書順に並べた記号
+    const std::vector<CsrGraph::Id>& getSymbolOrder() const { return symbolOrder; }
+
+   private:
+    static constexpr int UNKNOWN = -2;  // 遷移を未計算
+
+    const CsrGraph& graph;
+    std::vector<CsrGraph::Id> symbolOrder;  // 辺ラベルの辞書順
+    bool uniformLabels = true;              // 辺ラベルの長さがそろっているか
+    std::vector<unsigned int> reach;        // ノードから辿れる経路の最大長 (閉路に届けば上限値)
+
+    std::map<std::vector<CsrGraph::Id>, int> stateIndex;  // ノード集合 -> 状態
+    std::vector<std::vector<CsrGraph::Id>> members;       // 状態 -> ノード集合 (昇順)
+    std::vector<unsigned int> stateReach;                 // 状態から辿れる経路の最大長
+    std::vector<int> transitions;                         // 遷移表 [状態 * 記号数 + 記号]
+
+    void genReach();
+    int addState(std::vector<CsrGraph::Id> nodes);
+    void expand(int state);
+    std::uint64_t search(int state, std::string word, unsigned int rest, const Visit& visit);
+};
@@ -0,0 +1,164 @@
+#include "BlockCyclicMatrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+// ノードごとの巡回クラスを求める
+std::optional<std::vector<unsigned int>> BlockCyclicMatrix::genClasses(const CsrGraph& graph) {
+    const size_t n = graph.getNodeCount();
+    if (n == 0) {
+        return std::nullopt;
+    }
+
+    unsigned int period = 0;
+    for (CsrGraph::Id v = 0; v < n; ++v) {
+        period = std::max(period, graph.getPhase(v) + 1);
+    }
+    if (period < 2) {
+        return std::nullopt;
+    }
+
+    // 各ノードに巡回クラスを割り当て，すべての辺が次のクラスへ向かうかを確認
+    // (Béalのノードの位相は接頭辞の開始位相なので，位相そのものではなく
+    //  弱連結成分ごとに幅優先探索でクラスを伝播させる)
+    const auto& outOffsets = graph.getOutOffsets();
+    const auto& outTargets = graph.getOutTargets();
+    const auto& inOffsets = graph.getInOffsets();
+    const auto& inSources = graph.getInSources();
+
+    const unsigned int unassigned = period;
+    std::vector<unsigned int> cls(n, unassigned);
+    std::queue<CsrGraph::Id> queue;
+    for (CsrGraph::Id start = 0; start < n; ++start) {
+        if (cls[start] != unassigned) {
+            continue;
+        }
+        cls[start] = graph.getPhase(start);
+        queue.push(start);
+        while (!queue.empty()) {
+            CsrGraph::Id v = queue.front();
+            queue.pop();
+            auto visit = [&](CsrGraph::Id u, unsigned int expected) {
+                if (cls[u] == unassigned) {
+                    cls[u] = expected;
+                    queue.push(u);
+                }
+                return cls[u] == expected;
+            };
+            for (auto k = outOffsets[v]; k < outOffsets[v + 1]; ++k) {
+                if (!visit(outTargets[k], (cls[v] + 1) % period)) {
+                    return std::nullopt;
+                }
+            }
+            for (auto k = inOffsets[v]; k < inOffsets[v + 1]; ++k) {
+                if (!visit(inSources[k], (cls[v] + period - 1) % period)) {
+                    return std::nullopt;
+                }
+            }
+        }
+    }
+
+    return cls;
+}
+
+// ブロック巡回構造を検出して構築
+std::optional<BlockCyclicMatrix> BlockCyclicMatrix::fromGraph(const CsrGraph& graph) {
+    const auto classes = genClasses(graph);
+    if (!classes) {
+        return std::nullopt;
+    }
+    const auto& cls = *classes;
+    const size_t n = graph.getNodeCount();
+    unsigned int period = 0;
+    for (CsrGraph::Id v = 0; v < n; ++v) {
+        period = std::max(period, graph.getPhase(v) + 1);
+    }
+
+    // クラス内での添字を割り当て
+    std::vector<size_t> phaseSize(period, 0);
+    std::vector<size_t> localIndex(n);
+    for (CsrGraph::Id v = 0; v < n; ++v) {
+        localIndex[v] = phaseSize[cls[v]]++;
+    }
+
+    std::vector<std::vector<Eigen::Triplet<double>>> triplets(period);
+    for (size_t e = 0; e < graph.getEdgeCount(); ++e) {
+        CsrGraph::Id src = graph.getEdgeSource(e);
+        CsrGraph::Id tgt = graph.getEdgeTarget(e);
+        triplets[cls[src]].emplace_back(localIndex[src], localIndex[tgt], 1.0);
+    }
+
+    BlockCyclicMatrix matrix;
+    matrix.blocks.reserve(period);
+    for (unsigned int i = 0; i < period; ++i) {
+        Block block(phaseSize[i], phaseSize[(i + 1) % period]);
+        block.setFromTriplets(triplets[i].begin(), triplets[i].end());  // 多重辺は加算
+        matrix.blocks.push_back(std::move(block));
+    }
+    return matrix;
+}
+
+// ブロック積を計算
+Eigen::MatrixXd BlockCyclicMatrix::genProduct(unsigned int start) const {
+    const unsigned int period = getPeriod();
+    Eigen::MatrixXd product = Eigen::MatrixXd(blocks[start]);
+    for (unsigned int t = 1; t < period; ++t) {
+        product = product * blocks[(start + t) % period];
+    }
+    return product;
+}
+
+// 最大固有値を計算 (最も小さいクラスから始まるブロック積を用いる)
+double BlockCyclicMatrix::calcMaxEigenvalue(const EigenOptions& options) const {
+    const unsigned int period = getPeriod();
+    unsigned int start = 0;
+    for (unsigned int i = 1; i < period; ++i) {
+        if (getPhaseSize(i) < getPhaseSize(start)) {
+            start = i;
+        }
+    }
+    if (getPhaseSize(start) == 0) {
+        return 0.0;
+    }
+
+    double rho = calculateMaxEigenvalue(genProduct(start), options);
+    return rho > 0.0 ? std::pow(rho, 1.0 / period) : 0.0;
+}
+
+// 長さLの経路の数を計算
+// count_i[v]: クラスiのノードvから出る長さrの経路数とし，count_i <- A_i count_{i+1} を繰り返す
+std::uint64_t BlockCyclicMatrix::countPathsOfLength(unsigned int length) const {
+    if (length == 0) {
+        return 0;
+    }
+
+    const unsigned int period = getPeriod();
+    std::vector<std::vector<std::uint64_t>> count(period), next(period);
+    for (unsigned int i = 0; i < period; ++i) {
+        count[i].assign(getPhaseSize(i), 1);
+        next[i].assign(getPhaseSize(i), 0);
+    }
+
+    for (unsigned int step = 0; step < length; ++step) {
+        for (unsigned int i = 0; i < period; ++i) {
+            const auto& nextCount = count[(i + 1) % period];
+            for (Eigen::Index row = 0; row < blocks[i].outerSize(); ++row) {
+                std::uint64_t sum = 0;
+                for (Block::InnerIterator it(blocks[i], row); it; ++it) {
+                    sum += static_cast<std::uint64_t>(it.value()) * nextCount[it.col()];
+                }
+                next[i][row] = sum;
+            }
+        }
+        count.swap(next);
+    }
+
+    std::uint64_t total = 0;
+    for (const auto& c : count) {
+        for (std::uint64_t value : c) {
+            total += value;
+        }
+    }
+    return total;
+}
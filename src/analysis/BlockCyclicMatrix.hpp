@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../core/CsrGraph.hpp"
+#include "eigenvalues.hpp"
+
+// 位相ごとのブロックに分割した隣接行列
+// ノードを p 個のクラスに分けてすべての辺がクラス i から i+1 mod p へ向かうとき
+// (p は位相の最大値 + 1)，隣接行列はブロック A_0, ..., A_{p-1}
+// (A_i: クラスiのノード -> クラスi+1のノード) で表せる．
+// A^p はブロック積 A_i A_{i+1} ... A_{i-1} を対角に並べたものなので，
+// 最大固有値は最小のブロック積の最大固有値 ρ を用いて ρ^(1/p) となる．
+class BlockCyclicMatrix {
+   public:
+    using Block = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+    // ブロック巡回構造を持つ場合のみ構築 (周期1や構造を持たない場合は std::nullopt)
+    static std::optional<BlockCyclicMatrix> fromGraph(const CsrGraph& graph);
+
+    // ノードごとの巡回クラス (0..p-1) を求める (周期1や構造を持たない場合は std::nullopt)
+    static std::optional<std::vector<unsigned int>> genClasses(const CsrGraph& graph);
+
+    // ゲッター
+    unsigned int getPeriod() const { return blocks.size(); }
+    const Block& getBlock(unsigned int phase) const { return blocks[phase]; }
+    size_t getPhaseSize(unsigned int phase) const { return blocks[phase].rows(); }  // クラスのノード数
+
+    // ブロック積 A_start A_{start+1} ... A_{start-1} を計算
+    Eigen::MatrixXd genProduct(unsigned int start) const;
+
+    // 最大固有値を計算
+    double calcMaxEigenvalue(const EigenOptions& options = {}) const;
+
+    // 長さLの経路の数を計算
+    std::uint64_t countPathsOfLength(unsigned int length) const;
+
+   private:
+    std::vector<Block> blocks;  // ブロック A_i
+};
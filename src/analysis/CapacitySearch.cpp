@@ -0,0 +1,174 @@
+#include "CapacitySearch.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "../core/constants.hpp"
+#include "../utils/CombinationUtils.hpp"
+
+namespace {
+
+// 枝刈りの余裕 (上界と葉の最大固有値の数値誤差で同じ値の禁止集合を落とさない)
+constexpr double BOUND_MARGIN_FACTOR = 10.0;
+
+}  // namespace
+
+// コンストラクタ
+CapacitySearch::CapacitySearch(const io::type::Config& config, const GraphGenerator& generator,
+                               const EigenOptions& options)
+    : generator(generator), options(options) {
+    if (config.generation.mode != "all-patterns") {
+        throw std::invalid_argument("Capacity search requires all-patterns mode.");
+    }
+    words = combine(ALPHABET.substr(0, config.generation.alphabet),
+                    config.generation.forbidden.length, true);
+
+    // 探索の深さ d で位相 slotPhases[d] の語を1つ決める (位相順，位相内は添字の昇順)
+    const auto& position = config.generation.forbidden.position;
+    for (unsigned int p = 0; p < position.size(); ++p) {
+        if (position[p] > words.size()) {
+            throw std::invalid_argument("forbidden.position value exceeds total combinations.");
+        }
+        for (unsigned int i = 0; i < position[p]; ++i) {
+            slotPhases.push_back(p);
+            slotRemaining.push_back(position[p] - i - 1);
+            slotFirst.push_back(i == 0);
+        }
+    }
+    chosen.resize(slotPhases.size());
+}
+
+// 上位 k 個を求める
+std::vector<CapacitySearch::Result> CapacitySearch::run(size_t k, const Accept& accept) {
+    results.clear();
+    current.clear();
+    stats = {};
+    limit = k;
+    acceptFn = accept;
+    if (limit == 0) {
+        return results;
+    }
+
+    const double unbounded = std::numeric_limits<double>::infinity();
+    if (slotPhases.empty()) {
+        // 禁止語を選ばない設定では空集合だけが葉
+        double value;
+        if (evaluate(unbounded, true, value)) {
+            insert(value);
+        }
+    } else {
+        expand(0, unbounded);
+    }
+    return results;
+}
+
+// 深さ depth の語を決めて子を辿る (bound は親の最大固有値)
+void CapacitySearch::expand(size_t depth, double bound) {
+    const unsigned int phase = slotPhases[depth];
+    const size_t first = slotFirst[depth] ? 0 : chosen[depth - 1] + 1;
+    const size_t last = words.size() - slotRemaining[depth];
+    const bool leaf = depth + 1 == slotPhases.size();
+
+    std::vector<std::pair<double, unsigned int>> children;
+    for (size_t w = first; w < last; ++w) {
+        chosen[depth] = w;
+        current.emplace_back(words[w], phase);
+        double value;
+        if (evaluate(bound, leaf, value)) {
+            if (leaf) {
+                insert(value);
+            } else {
+                children.emplace_back(value, w);
+            }
+        }
+        current.pop_back();
+    }
+    if (leaf) {
+        return;
+    }
+
+    // 上界の大きい順に辿る (同じ値なら添字順)
+    std::stable_sort(children.begin(), children.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (const auto& [value, w] : children) {
+        if (value < getThreshold()) {
+            ++stats.boundPruned;
+            continue;
+        }
+        chosen[depth] = w;
+        current.emplace_back(words[w], phase);
+        expand(depth + 1, value);
+        current.pop_back();
+    }
+}
+
+// 現在の禁止集合の上界を安い順に評価し，枝刈りされなければ最大固有値を value に返す
+bool CapacitySearch::evaluate(double parentBound, bool leaf, double& value) {
+    ++stats.visited;
+    const double threshold = getThreshold();
+    if (parentBound < threshold) {
+        ++stats.boundPruned;
+        return false;
+    }
+    if (leaf && acceptFn && !acceptFn(current)) {
+        ++stats.rejected;
+        return false;
+    }
+
+    const Graph graph = generator.generateTrimmed(current);
+    if (boundMaxEigenvalue(graph).upper < threshold) {
+        ++stats.degreePruned;
+        return false;
+    }
+
+    value = calculateMaxEigenvalue(graph, options);
+    ++stats.evaluated;
+    if (value < threshold) {
+        ++stats.boundPruned;
+        return false;
+    }
+    return true;
+}
+
+// 現在の禁止集合 (葉) を上位に加える
+void CapacitySearch::insert(double value) {
+    Result result{genIndex(), current, value};
+    auto better = [](const Result& a, const Result& b) {
+        return a.maxEigenvalue > b.maxEigenvalue ||
+               (a.maxEigenvalue == b.maxEigenvalue && a.index < b.index);
+    };
+    if (results.size() == limit && !better(result, results.back())) {
+        return;
+    }
+    results.insert(std::upper_bound(results.begin(), results.end(), result, better),
+                   std::move(result));
+    if (results.size() > limit) {
+        results.pop_back();
+    }
+}
+
+// これを下回る上界の部分木は上位に入らない (上位が埋まるまでは枝刈りしない)
+double CapacitySearch::getThreshold() const {
+    if (results.size() < limit) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    const double kth = results.back().maxEigenvalue;
+    return kth - BOUND_MARGIN_FACTOR * options.tolerance * kth;
+}
+
+// 現在の禁止集合の列挙順の番号 (位相ごとの組み合わせの順位の混合基数表示，最後の位相が最下位桁)
+std::uint64_t CapacitySearch::genIndex() const {
+    std::uint64_t index = 0;
+    for (size_t begin = 0; begin < slotPhases.size();) {
+        size_t end = begin;
+        while (end < slotPhases.size() && slotPhases[end] == slotPhases[begin]) {
+            ++end;
+        }
+        const std::vector<unsigned int> indices(chosen.begin() + begin, chosen.begin() + end);
+        index = index * binomial(words.size(), indices.size()) +
+                rankCombination(indices, words.size());
+        begin = end;
+    }
+    return index;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../algorithm/GraphGenerator.hpp"
+#include "../core/Node.hpp"
+#include "../io/Config.hpp"
+#include "eigenvalues.hpp"
+
+// all-patternsモードの禁止集合のうち最大固有値の大きいものを上位 k 個求める分枝限定法
+// 禁止集合を位相順・語の添字の昇順に1語ずつ決める探索木を辿り，途中まで決めた禁止集合の
+// 最大固有値 (禁止語を増やしても増えない) をその部分木の上界とする．
+// 上界は親の値，刈り込み後のグラフの最大出次数・最大入次数 (Collatz–Wielandtの上界)，
+// 最大固有値の順に安いものから評価し，上位 k 個の最小値を下回れば部分木ごと枝刈りする．
+// 子は上界の大きい順に辿る (早く良い解を見つけて枝刈りを効かせる)．
+class CapacitySearch {
+   public:
+    struct Result {
+        std::uint64_t index;  // ForbiddenSetEnumerator の列挙順の番号 (summary.csv の番号)
+        std::vector<Node> forbiddenNodes;
+        double maxEigenvalue;
+    };
+
+    // 探索の統計
+    struct Stats {
+        std::uint64_t visited = 0;      // 上界を評価した節点 (葉を含む)
+        std::uint64_t evaluated = 0;    // 最大固有値を計算した節点
+        std::uint64_t degreePruned = 0;  // 次数の上界で枝刈りした節点
+        std::uint64_t boundPruned = 0;   // 親・自身の最大固有値で枝刈りした節点
+        std::uint64_t rejected = 0;      // accept で除いた葉
+    };
+
+    // 上位に数える禁止集合か (nullptr なら全て)
+    using Accept = std::function<bool(const std::vector<Node>&)>;
+
+    // コンストラクタ (all-patternsモード以外や語数が候補を超える設定は std::invalid_argument)
+    CapacitySearch(const io::type::Config& config, const GraphGenerator& generator,
+                   const EigenOptions& options = {});
+
+    // 上位 k 個を最大固有値の降順 (同じ値なら列挙順) で返す
+    std::vector<Result> run(size_t k, const Accept& accept = nullptr);
+
+    // ゲッター
+    const Stats& getStats() const { return stats; }
+
+   private:
+    const GraphGenerator& generator;
+    EigenOptions options;
+    std::vector<std::string> words;          // 禁止語の候補
+    std::vector<unsigned int> slotPhases;    // 探索の深さごとに決める語の位相
+    std::vector<size_t> slotRemaining;       // その位相でその深さより後に決める語の数
+    std::vector<bool> slotFirst;             // その位相で最初に決める語か
+    std::vector<unsigned int> chosen;        // 深さごとに選んだ語の添字
+    std::vector<Node> current;               // 決めた禁止語
+    std::vector<Result> results;             // 上位 (降順)
+    size_t limit = 0;
+    Accept acceptFn;
+    Stats stats;
+
+    void expand(size_t depth, double bound);
+    bool evaluate(double parentBound, bool leaf, double& value);
+    void insert(double value);
+    double getThreshold() const;
+    std::uint64_t genIndex() const;
+};
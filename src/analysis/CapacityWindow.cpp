@@ -0,0 +1,58 @@
+#include "CapacityWindow.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+// コンストラクタ
+CapacityWindow::CapacityWindow(double minCapacity, double maxCapacity, double tolerance)
+    : minCapacity(minCapacity), maxCapacity(maxCapacity), tolerance(tolerance) {
+    if (std::isnan(minCapacity) || std::isnan(maxCapacity) || minCapacity > maxCapacity) {
+        throw std::invalid_argument("Capacity window requires min capacity <= max capacity.");
+    }
+}
+
+// 最大固有値の容量
+double CapacityWindow::calcCapacity(double maxEigenvalue) {
+    return maxEigenvalue > 1.0 ? std::log2(maxEigenvalue) : 0.0;
+}
+
+// 範囲の指定があるか
+bool CapacityWindow::isBounded() const {
+    return minCapacity > 0.0 || maxCapacity < std::numeric_limits<double>::infinity();
+}
+
+// 最大固有値による判定
+CapacityWindow::Decision CapacityWindow::classify(double maxEigenvalue) const {
+    return classify(maxEigenvalue, maxEigenvalue) == Decision::Outside ? Decision::Outside
+                                                                       : Decision::Inside;
+}
+
+// 最大固有値の上下界による判定
+CapacityWindow::Decision CapacityWindow::classify(const PerronRoot& bounds) const {
+    return classify(bounds.lower, bounds.upper);
+}
+
+// グラフの上下界による判定 (次数だけで決まれば反復しない)
+CapacityWindow::Decision CapacityWindow::classify(const Graph& graph) const {
+    if (!isBounded()) {
+        return Decision::Inside;
+    }
+    Decision decision = classify(boundMaxEigenvalue(graph));
+    if (decision == Decision::Unknown) {
+        decision = classify(boundMaxEigenvalue(graph, BOUND_ITERATIONS));
+    }
+    return decision;
+}
+
+// 区間 [lower, upper] (許容誤差の分だけ広げる) が範囲に含まれるか，交わらないか
+CapacityWindow::Decision CapacityWindow::classify(double lower, double upper) const {
+    const double low = calcCapacity(lower * (1.0 - tolerance));
+    const double high = calcCapacity(upper * (1.0 + tolerance));
+    if (high < minCapacity || low > maxCapacity) {
+        return Decision::Outside;
+    }
+    if (low >= minCapacity && high <= maxCapacity) {
+        return Decision::Inside;
+    }
+    return Decision::Unknown;
+}
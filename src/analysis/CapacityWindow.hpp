@@ -0,0 +1,48 @@
+#pragma once
+
+#include <limits>
+
+#include "../core/Graph.hpp"
+#include "eigenvalues.hpp"
+
+// 容量 (最大固有値の log2) の範囲 [minCapacity, maxCapacity] による絞り込み
+// まず安い上下界 (boundMaxEigenvalue) で判定し，上下界が範囲の端をまたぐときだけ
+// 最大固有値が必要になる (Unknown)．最大固有値は許容誤差の分だけ範囲内に寄せて判定する．
+class CapacityWindow {
+   public:
+    enum class Decision { Inside, Outside, Unknown };
+
+    // 上下界を狭めるべき乗法の反復回数
+    static constexpr int BOUND_ITERATIONS = 8;
+
+    // minCapacity > maxCapacity なら std::invalid_argument
+    CapacityWindow(double minCapacity = -std::numeric_limits<double>::infinity(),
+                   double maxCapacity = std::numeric_limits<double>::infinity(),
+                   double tolerance = EigenOptions{}.tolerance);
+
+    // 最大固有値の容量 (1以下なら0: 整数行列の最大固有値は0か1以上)
+    static double calcCapacity(double maxEigenvalue);
+
+    // 範囲の指定があるか (なければすべて Inside)
+    bool isBounded() const;
+
+    // 最大固有値 maxEigenvalue による判定 (Inside か Outside)
+    Decision classify(double maxEigenvalue) const;
+
+    // 最大固有値の上下界による判定
+    Decision classify(const PerronRoot& bounds) const;
+
+    // グラフの次数，続いて数回のべき乗法の上下界による判定
+    Decision classify(const Graph& graph) const;
+
+    // ゲッター
+    double getMinCapacity() const { return minCapacity; }
+    double getMaxCapacity() const { return maxCapacity; }
+
+   private:
+    double minCapacity;
+    double maxCapacity;
+    double tolerance;
+
+    Decision classify(double lower, double upper) const;
+};
@@ -0,0 +1,155 @@
+#include "PathCounter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "eigenvalues.hpp"
+
+namespace {
+
+using Matrix = std::vector<std::vector<BigUint>>;
+
+// 密な行列の積 (0の成分は飛ばす)
+Matrix multiply(const Matrix& lhs, const Matrix& rhs) {
+    const size_t n = lhs.size();
+    Matrix product(n, std::vector<BigUint>(n));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (lhs[i][j].isZero()) {
+                continue;
+            }
+            for (size_t k = 0; k < n; ++k) {
+                if (!rhs[j][k].isZero()) {
+                    product[i][k] += lhs[i][j] * rhs[j][k];
+                }
+            }
+        }
+    }
+    return product;
+}
+
+}  // namespace
+
+// コンストラクタ
+PathCounter::PathCounter(const CsrGraph& graph) : graph(graph) {
+    for (CsrGraph::Id v = 0; v < graph.getNodeCount(); ++v) {
+        phaseCount = std::max(phaseCount, graph.getPhase(v) + 1);
+    }
+}
+
+// 長さLの経路の総数
+BigUint PathCounter::count(unsigned int length, Method method) const {
+    if (method == Method::Auto) {
+        method = chooseMethod(length);
+    }
+    const auto counts = method == Method::Squaring ? countBySquaring(length)
+                                                   : countByDynamicProgramming(length, false);
+    BigUint total;
+    for (const auto& row : counts) {
+        for (const auto& value : row) {
+            total += value;
+        }
+    }
+    return total;
+}
+
+// 始点・終点の位相ごとの経路数
+std::vector<std::vector<BigUint>> PathCounter::countByPhase(unsigned int length,
+                                                            Method method) const {
+    if (method == Method::Auto) {
+        method = chooseMethod(length, true);
+    }
+    return method == Method::Squaring ? countBySquaring(length)
+                                      : countByDynamicProgramming(length, true);
+}
+
+// 計算量の見積もり
+// 経路数の桁数 k (2^32 進) を最大固有値の次数による上界 (boundMaxEigenvalue) から見積もる．
+// 動的計画法は L 回の疎行列積の足し算 (平均 k/2 桁)，繰り返し二乗法は最後の数回の
+// 密な行列積の掛け算 (k^2/4 程度) とみなす．
+PathCounter::Method PathCounter::chooseMethod(unsigned int length, bool byPhase) const {
+    const size_t n = graph.getNodeCount();
+    if (n == 0 || n > SQUARING_LIMIT || length <= 1) {
+        return Method::DynamicProgramming;
+    }
+    const double degree = std::max(1.0, boundMaxEigenvalue(graph).upper);
+    const double limbs = (length * std::log2(degree) + std::log2(n)) / 32.0 + 1.0;
+
+    const double cube = static_cast<double>(n) * n * n;
+    const double dynamicCost = length * static_cast<double>(graph.getEdgeCount() + n) *
+                               (limbs / 2.0 + 1.0) * (byPhase ? phaseCount : 1);
+    const double squaringCost = cube * (2.0 * std::log2(length) + limbs * limbs / 2.0);
+    return squaringCost < dynamicCost ? Method::Squaring : Method::DynamicProgramming;
+}
+
+// 動的計画法
+// byEndPhase なら終点の位相ごとに count_0 を位相の指示ベクトルにして数える (そうでなければ全1)．
+std::vector<std::vector<BigUint>> PathCounter::countByDynamicProgramming(unsigned int length,
+                                                                         bool byEndPhase) const {
+    const size_t n = graph.getNodeCount();
+    std::vector<std::vector<BigUint>> counts(phaseCount, std::vector<BigUint>(phaseCount));
+    if (length == 0) {
+        return counts;
+    }
+
+    const auto& offsets = graph.getOutOffsets();
+    const auto& targets = graph.getOutTargets();
+    const unsigned int groups = byEndPhase ? phaseCount : 1;
+    std::vector<BigUint> count(n), next(n);
+    for (unsigned int group = 0; group < groups; ++group) {
+        for (CsrGraph::Id v = 0; v < n; ++v) {
+            count[v] = !byEndPhase || graph.getPhase(v) == group ? 1 : 0;
+        }
+        for (unsigned int step = 0; step < length; ++step) {
+            for (CsrGraph::Id v = 0; v < n; ++v) {
+                if (offsets[v] == offsets[v + 1]) {
+                    next[v] = BigUint();
+                    continue;
+                }
+                next[v] = count[targets[offsets[v]]];
+                for (CsrGraph::Id e = offsets[v] + 1; e < offsets[v + 1]; ++e) {
+                    next[v] += count[targets[e]];
+                }
+            }
+            count.swap(next);
+        }
+        // 全1から数えた場合は終点の位相0の欄にまとめる
+        for (CsrGraph::Id v = 0; v < n; ++v) {
+            counts[graph.getPhase(v)][group] += count[v];
+        }
+    }
+    return counts;
+}
+
+// 繰り返し二乗法 (A^L の成分を始点・終点の位相ごとに足す)
+std::vector<std::vector<BigUint>> PathCounter::countBySquaring(unsigned int length) const {
+    const size_t n = graph.getNodeCount();
+    std::vector<std::vector<BigUint>> counts(phaseCount, std::vector<BigUint>(phaseCount));
+    if (length == 0) {
+        return counts;
+    }
+
+    Matrix base(n, std::vector<BigUint>(n));
+    for (size_t e = 0; e < graph.getEdgeCount(); ++e) {
+        base[graph.getEdgeSource(e)][graph.getEdgeTarget(e)] += 1;
+    }
+    Matrix power;
+    bool empty = true;
+    for (unsigned int rest = length;; rest >>= 1) {
+        if (rest & 1) {
+            power = empty ? base : multiply(power, base);
+            empty = false;
+        }
+        if (rest <= 1) {
+            break;
+        }
+        base = multiply(base, base);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            counts[graph.getPhase(i)][graph.getPhase(j)] += power[i][j];
+        }
+    }
+    return counts;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include "../core/CsrGraph.hpp"
+#include "../utils/BigUint.hpp"
+
+// 長さLの経路 (L本の辺からなる歩道) の数を任意精度で数える
+// 動的計画法: count_r[v] (v から出る長さ r の経路数) を count_r = A count_{r-1} で L 回更新する．
+// 繰り返し二乗法: A^L を密な行列の二乗と積で求める (ノードが少なく L が長い場合に速い)．
+// 始点・終点の位相ごとの内訳も数えられる (位相はノードの位相，内訳の添字は 0..getPhaseCount()-1)．
+class PathCounter {
+   public:
+    enum class Method { Auto, DynamicProgramming, Squaring };
+
+    // 繰り返し二乗法を使うノード数の上限 (密な行列を保持する)
+    static constexpr size_t SQUARING_LIMIT = 256;
+
+    // graph は PathCounter より長く生存すること
+    explicit PathCounter(const CsrGraph& graph);
+
+    // 長さLの経路の総数 (L = 0 なら0)
+    BigUint count(unsigned int length, Method method = Method::Auto) const;
+
+    // 始点の位相 s，終点の位相 t の長さLの経路数 counts[s][t]
+    std::vector<std::vector<BigUint>> countByPhase(unsigned int length,
+                                                   Method method = Method::Auto) const;
+
+    // 位相の数 (最大の位相 + 1，ノードがなければ0)
+    unsigned int getPhaseCount() const { return phaseCount; }
+
+    // Auto で選ぶ方法 (経路数の桁数の見積もりから計算量を比べる，byPhase は位相ごとの内訳を数える場合)
+    Method chooseMethod(unsigned int length, bool byPhase = false) const;
+
+   private:
+    const CsrGraph& graph;
+    unsigned int phaseCount = 0;
+
+    std::vector<std::vector<BigUint>> countByDynamicProgramming(unsigned int length,
+                                                                bool byEndPhase) const;
+    std::vector<std::vector<BigUint>> countBySquaring(unsigned int length) const;
+};
@@ -0,0 +1,249 @@
+#include "PerronBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "../utils/GraphUtils.hpp"
+#include "BlockCyclicMatrix.hpp"
+
+namespace {
+
+// 上下界を調べて正規化する間隔 (ブロック積の反復回数)
+constexpr int CHECK_INTERVAL = 4;
+
+}  // namespace
+
+// ノードごとの巡回クラス
+std::vector<unsigned int> PerronBatch::genClasses(const CsrGraph& graph) {
+    auto classes = BlockCyclicMatrix::genClasses(graph);
+    return classes ? std::move(*classes) : std::vector<unsigned int>(graph.getNodeCount(), 0);
+}
+
+// コンストラクタ
+PerronBatch::PerronBatch(const std::vector<const CsrGraph*>& graphs)
+    : PerronBatch(graphs, [&]() {
+          std::vector<std::vector<unsigned int>> classes;
+          for (const CsrGraph* graph : graphs) {
+              classes.push_back(genClasses(*graph));
+          }
+          return classes;
+      }()) {}
+
+// 巡回クラスを求め済みの場合
+PerronBatch::PerronBatch(const std::vector<const CsrGraph*>& graphs,
+                         std::vector<std::vector<unsigned int>> classes)
+    : lanes(graphs.size()) {
+    if (lanes > MAX_LANES) {
+        throw std::invalid_argument("PerronBatch accepts at most " + std::to_string(MAX_LANES) +
+                                    " graphs.");
+    }
+    // レーンごとにノードをクラス順の行へ割り当てる
+    std::vector<std::vector<unsigned int>> rows(lanes);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        const CsrGraph& graph = *graphs[lane];
+        const size_t n = graph.getNodeCount();
+        if (n == 0 || n > MAX_NODES || classes[lane].size() != n) {
+            throw std::invalid_argument("PerronBatch requires graphs with 1 to " +
+                                        std::to_string(MAX_NODES) + " nodes.");
+        }
+        const unsigned int lanePeriod =
+            *std::max_element(classes[lane].begin(), classes[lane].end()) + 1;
+        if (lane == 0) {
+            period = lanePeriod;
+        } else if (lanePeriod != period) {
+            throw std::invalid_argument("PerronBatch requires graphs with the same period.");
+        }
+
+        std::vector<unsigned int> counts(period, 0);
+        rows[lane].resize(n);
+        for (size_t v = 0; v < n; ++v) {
+            rows[lane][v] = counts[classes[lane][v]]++;
+        }
+        classSize = std::max<size_t>(classSize, *std::max_element(counts.begin(), counts.end()));
+        startCounts.push_back(counts[0]);
+    }
+
+    // 辺ごとに visit(lane, 行, 列) (列は終点の1つ後のクラス内の行)
+    auto forEachEdge = [&](auto visit) {
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            const auto& offsets = graphs[lane]->getOutOffsets();
+            const auto& outTargets = graphs[lane]->getOutTargets();
+            for (size_t v = 0; v < graphs[lane]->getNodeCount(); ++v) {
+                const size_t row = classes[lane][v] * classSize + rows[lane][v];
+                for (CsrGraph::Id e = offsets[v]; e < offsets[v + 1]; ++e) {
+                    visit(lane, row, rows[lane][outTargets[e]]);
+                }
+            }
+        }
+    };
+
+    // いずれかのレーンに辺がある (行, 列) を行ごとに列の昇順で並べる
+    const size_t rowCount = period * classSize;
+    const unsigned int unused = static_cast<unsigned int>(-1);
+    std::vector<unsigned int> entryOf(rowCount * classSize, unused);
+    forEachEdge([&](size_t, size_t row, size_t column) { entryOf[row * classSize + column] = 0; });
+    columnOffsets.push_back(0);
+    for (size_t row = 0; row < rowCount; ++row) {
+        for (size_t column = 0; column < classSize; ++column) {
+            if (entryOf[row * classSize + column] != unused) {
+                entryOf[row * classSize + column] = columns.size();
+                columns.push_back(column);
+            }
+        }
+        columnOffsets.push_back(columns.size());
+    }
+
+    // 係数 (多重辺は加算，辺のないレーンは0)
+    coefficients.assign(columns.size() * MAX_LANES, 0.0);
+    forEachEdge([&](size_t lane, size_t row, size_t column) {
+        coefficients[entryOf[row * classSize + column] * MAX_LANES + lane] += 1.0;
+    });
+}
+
+// 全レーンの最大固有値を計算
+// x (クラス0の行) はレーンごとに実在するノードで正，詰め物の行で0 (辺がないので0のまま) から始める．
+// クラス p-1, p-2, ..., 0 の順に1つ後のクラスの値から計算すると y = P x となる．
+std::vector<PerronRoot> PerronBatch::solve(const EigenOptions& options) const {
+    const size_t width = classSize * MAX_LANES;
+    std::vector<PerronRoot> results(lanes);
+    std::vector<double> x(width, 0.0), y(width), work(period * width);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        for (size_t r = 0; r < startCounts[lane]; ++r) {
+            x[r * MAX_LANES + lane] = 1.0 / startCounts[lane];
+        }
+    }
+
+    // クラス c の行を1つ後のクラスの値 source から計算して dest に書く
+    auto multiply = [&](unsigned int c, const double* source, double* dest) {
+        for (size_t r = 0; r < classSize; ++r) {
+            const size_t row = c * classSize + r;
+            double sum[MAX_LANES] = {};
+            for (unsigned int k = columnOffsets[row]; k < columnOffsets[row + 1]; ++k) {
+                const double* a = &coefficients[k * MAX_LANES];
+                const double* in = source + columns[k] * MAX_LANES;
+                for (size_t lane = 0; lane < MAX_LANES; ++lane) {
+                    sum[lane] += a[lane] * in[lane];
+                }
+            }
+            std::copy(sum, sum + MAX_LANES, dest + r * MAX_LANES);
+        }
+    };
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const double exponent = 1.0 / period;
+    std::vector<double> lower(lanes), upper(lanes), sumX(lanes), sumY(lanes);
+    size_t remaining = lanes;
+    for (int it = 1; it <= options.maxIterations && remaining > 0; ++it) {
+        // y = P x
+        for (unsigned int c = period; c-- > 0;) {
+            const unsigned int next = (c + 1) % period;
+            multiply(c, next == 0 ? x.data() : &work[next * width],
+                     c == 0 ? y.data() : &work[c * width]);
+        }
+
+        const bool check = it % CHECK_INTERVAL == 0 || it == options.maxIterations;
+        if (check) {
+            // P のCollatz–Wielandtの上下界 (詰め物の行は x = 0 なので除く)
+            std::fill(lower.begin(), lower.end(), inf);
+            std::fill(upper.begin(), upper.end(), 0.0);
+            std::fill(sumX.begin(), sumX.end(), 0.0);
+            std::fill(sumY.begin(), sumY.end(), 0.0);
+            for (size_t r = 0; r < classSize; ++r) {
+                const double* xr = &x[r * MAX_LANES];
+                const double* yr = &y[r * MAX_LANES];
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    const bool present = xr[lane] > 0.0;
+                    const double ratio = present ? yr[lane] / xr[lane] : 0.0;
+                    lower[lane] = std::min(lower[lane], present ? ratio : inf);
+                    upper[lane] = std::max(upper[lane], ratio);
+                    sumX[lane] += xr[lane];
+                    sumY[lane] += yr[lane];
+                }
+            }
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                PerronRoot& result = results[lane];
+                if (result.converged) {
+                    continue;
+                }
+                // λ = ρ(P)^(1/p)
+                result.lower = std::pow(lower[lane], exponent);
+                result.upper = std::pow(upper[lane], exponent);
+                result.value = std::pow(sumY[lane] / sumX[lane], exponent);
+                result.iterations = it;
+                // (クラス0に実在するノードがなければ下界が +inf のまま収束しない)
+                if (result.lower <= result.upper &&
+                    result.upper - result.lower <= options.tolerance * std::max(1.0, result.upper)) {
+                    result.converged = true;
+                    --remaining;
+                }
+            }
+        }
+
+        // x <- (P + I) x (正規化は上下界を調べるときのみ)
+        for (size_t k = 0; k < width; ++k) {
+            x[k] += y[k];
+        }
+        if (check) {
+            for (size_t r = 0; r < classSize; ++r) {
+                double* xr = &x[r * MAX_LANES];
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    xr[lane] /= sumX[lane] + sumY[lane];
+                }
+            }
+        }
+    }
+    return results;
+}
+
+// 複数のグラフの最大固有値を計算
+std::vector<double> calculateMaxEigenvalues(const std::vector<const Graph*>& graphs,
+                                            const EigenOptions& options) {
+    std::vector<double> values(graphs.size(), 0.0);
+    std::vector<bool> solved(graphs.size(), false);
+    std::vector<std::vector<unsigned int>> classes(graphs.size());
+    std::vector<std::tuple<unsigned int, size_t, size_t>> batched;  // (周期, ノード数, 添字)
+    for (size_t g = 0; g < graphs.size(); ++g) {
+        const auto& csr = graphs[g]->getCsr();
+        if (csr.getNodeCount() == 0) {
+            solved[g] = true;
+        } else if (csr.getNodeCount() <= PerronBatch::MAX_NODES && isStronglyConnected(csr)) {
+            classes[g] = PerronBatch::genClasses(csr);
+            const unsigned int period = *std::max_element(classes[g].begin(), classes[g].end()) + 1;
+            batched.emplace_back(period, csr.getNodeCount(), g);
+        }
+    }
+
+    // 周期が同じでノード数の近いグラフを同じバッチにする (詰め物を減らす)
+    std::sort(batched.begin(), batched.end());
+    for (size_t begin = 0; begin < batched.size();) {
+        size_t end = begin;
+        std::vector<const CsrGraph*> csrs;
+        std::vector<std::vector<unsigned int>> batchClasses;
+        while (end < batched.size() && csrs.size() < PerronBatch::MAX_LANES &&
+               std::get<0>(batched[end]) == std::get<0>(batched[begin])) {
+            const size_t g = std::get<2>(batched[end]);
+            csrs.push_back(&graphs[g]->getCsr());
+            batchClasses.push_back(std::move(classes[g]));
+            ++end;
+        }
+        const auto roots = PerronBatch(csrs, std::move(batchClasses)).solve(options);
+        for (size_t k = begin; k < end; ++k) {
+            if (roots[k - begin].converged) {
+                values[std::get<2>(batched[k])] = roots[k - begin].value;
+                solved[std::get<2>(batched[k])] = true;
+            }
+        }
+        begin = end;
+    }
+
+    for (size_t g = 0; g < graphs.size(); ++g) {
+        if (!solved[g]) {
+            values[g] = calculateMaxEigenvalue(*graphs[g], options);
+        }
+    }
+    return values;
+}
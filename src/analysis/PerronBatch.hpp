@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+#include "../core/CsrGraph.hpp"
+#include "../core/Graph.hpp"
+#include "eigenvalues.hpp"
+
+// 小さい非負行列の最大固有値をまとめて求めるべき乗法
+// グラフ1つを1レーンとし，行列をクラスごとのブロック (行と1つ後のクラスの行の組) で持つ．
+// いずれかのレーンに辺がある (行, 列) だけを残し，その係数を MAX_LANES 幅に並べる (SoA)．
+// 列の番号はレーンで共通なので，最内ループは係数と入力ベクトルをレーン方向に連続して読む
+// 固定長の積和になり，添字による間接参照 (gather) がない．
+// GCC 12 は -O2 以上でこのループをSIMD化する (-fopt-info-vec で確認できる．-O0 ではされない)．
+// グラフごとに calculateMaxEigenvalue で解くのとの比較は bench_PerronBatch (Release で約2倍)．
+// 周期 p のブロック巡回構造 (BlockCyclicMatrix と同じ) を持つグラフは行をクラス順に並べ，
+// クラス0のベクトルに A を p 回掛けてブロック積 P = A_0 A_1 ... A_{p-1} を反復する (ρ(P) = λ^p)．
+// 各レーンは P + I の反復でCollatz–Wielandtの上下界が許容誤差内で一致した時点で収束とし，
+// 上下界は結果として返す (一致しなければ未収束のまま返す)．
+class PerronBatch {
+   public:
+    // まとめて扱うノード数の上限 (これより大きいグラフは個別に解く)
+    static constexpr size_t MAX_NODES = 64;
+
+    // まとめて扱うグラフの数の上限 (係数とベクトルはレーン数によらずこの幅で並べる)
+    static constexpr size_t MAX_LANES = 16;
+
+    // ノードごとの巡回クラス (ブロック巡回構造を持たなければすべて0)
+    static std::vector<unsigned int> genClasses(const CsrGraph& graph);
+
+    // MAX_LANES を超える数のグラフ，ノードがない，MAX_NODES を超える，または周期の異なるグラフは
+    // 受け付けない (std::invalid_argument)
+    explicit PerronBatch(const std::vector<const CsrGraph*>& graphs);
+
+    // 巡回クラスを求め済みの場合 (classes[lane] は genClasses の結果)
+    PerronBatch(const std::vector<const CsrGraph*>& graphs,
+                std::vector<std::vector<unsigned int>> classes);
+
+    // ゲッター
+    size_t getLaneCount() const { return lanes; }
+    unsigned int getPeriod() const { return period; }
+    size_t getClassSize() const { return classSize; }  // クラスあたりの行数 (最大のクラスの大きさ)
+    size_t getEntryCount() const { return columns.size(); }  // 係数を持つ (行, 列) の数
+
+    // 全レーンの最大固有値を計算
+    std::vector<PerronRoot> solve(const EigenOptions& options = {}) const;
+
+   private:
+    size_t lanes = 0;
+    unsigned int period = 1;
+    size_t classSize = 0;
+    std::vector<unsigned int> startCounts;    // レーンごとのクラス0のノード数
+    std::vector<unsigned int> columnOffsets;  // 行 (クラス * classSize + 行) -> columns の範囲
+    std::vector<unsigned int> columns;        // 列 (1つ後のクラスの行)
+    std::vector<double> coefficients;         // 係数 (columns の添字 * MAX_LANES + レーン)
+};
+
+// 複数のグラフの最大固有値を計算
+// 強連結で小さいグラフは周期とノード数の近いものを PerronBatch にまとめ，それ以外と
+// 上下界が一致しなかったものは calculateMaxEigenvalue で個別に求める．
+std::vector<double> calculateMaxEigenvalues(const std::vector<const Graph*>& graphs,
+                                            const EigenOptions& options = {});
@@ -1,57 +1,268 @@
 #include "eigenvalues.hpp"
 
 #include <Spectra/GenEigsSolver.h>
-#include <Spectra/MatOp/DenseGenMatProd.h>
+#include <Spectra/MatOp/SparseGenMatProd.h>
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
-#include <unordered_map>
+
+#include "BlockCyclicMatrix.hpp"
+
+namespace {
+
+// 密な固有値分解に切り替えるノード数の上限
+constexpr Eigen::Index DENSE_LIMIT = 2000;
+
+// べき乗法の収束率を見積もる反復回数
+constexpr size_t RATE_WINDOW = 8;
+
+// ウォームスタート時に混ぜる一様ベクトルの重み
+// (前回の解で0の成分がPerron根を与える場合にも収束させるため)
+constexpr double WARM_START_MIX = 1e-6;
+
+}  // namespace
 
 // Graphを引数に取り、最大固有値を返す関数
-double calculateMaxEigenvalue(const Graph& graph) {
+double calculateMaxEigenvalue(const Graph& graph, const EigenOptions& options) {
+    const auto& csr = graph.getCsr();
+
+    // 位相ごとのブロックに分割できる場合はブロック積を用いる
+    if (auto blockMatrix = BlockCyclicMatrix::fromGraph(csr)) {
+        return blockMatrix->calcMaxEigenvalue(options);
+    }
+
     // ノード数を取得
-    const auto& nodes = graph.getNodes();
-    int n = nodes.size();
+    int n = csr.getNodeCount();
 
-    // ノードをインデックスにマッピング
-    std::unordered_map<Node, int> toIdx;
-    for (int i = 0; i < n; ++i) {
-        toIdx[nodes[i]] = i;
+    // 疎な隣接行列を作成 (ノードIDをそのまま行列の添字とし，多重辺は加算)
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(csr.getEdgeCount());
+    for (size_t e = 0; e < csr.getEdgeCount(); ++e) {
+        triplets.emplace_back(csr.getEdgeSource(e), csr.getEdgeTarget(e), 1.0);
     }
+    Eigen::SparseMatrix<double> adjacencyMatrix(n, n);
+    adjacencyMatrix.setFromTriplets(triplets.begin(), triplets.end());
+
+    return calculateMaxEigenvalue(adjacencyMatrix, options);
+}
 
-    // 隣接行列を作成
-    Eigen::MatrixXd adjacencyMatrix = Eigen::MatrixXd::Zero(n, n);
-    for (const auto& edge : graph.getEdges()) {
-        int sourceIndex = toIdx[edge.getSource()];
-        int targetIndex = toIdx[edge.getTarget()];
-        adjacencyMatrix(sourceIndex, targetIndex) += 1;
+// 最大固有値の安い上下界
+PerronRoot boundMaxEigenvalue(const Graph& graph, int iterations) {
+    return boundMaxEigenvalue(graph.getCsr(), iterations);
+}
+
+PerronRoot boundMaxEigenvalue(const CsrGraph& csr, int iterations) {
+    PerronRoot result;
+    const size_t n = csr.getNodeCount();
+    if (n == 0) {
+        return result;
     }
 
-    // Spectraを使用して最大固有値を計算
-    try {
-        const int nev = 1;
-        const int ncv = std::min(std::max(3, 2 * nev + 1), n - 1);
+    // 行和・列和の最小値は下界，最大値は上界 (多重辺は重複して数える)
+    const auto& outOffsets = csr.getOutOffsets();
+    const auto& inOffsets = csr.getInOffsets();
+    CsrGraph::Id minOut = outOffsets[1], maxOut = 0, minIn = inOffsets[1], maxIn = 0;
+    for (size_t v = 0; v < n; ++v) {
+        const CsrGraph::Id out = outOffsets[v + 1] - outOffsets[v];
+        const CsrGraph::Id in = inOffsets[v + 1] - inOffsets[v];
+        minOut = std::min(minOut, out);
+        maxOut = std::max(maxOut, out);
+        minIn = std::min(minIn, in);
+        maxIn = std::max(maxIn, in);
+    }
+    result.lower = std::max(minOut, minIn);
+    result.upper = std::min(maxOut, maxIn);
+    result.value = static_cast<double>(csr.getEdgeCount()) / n;
 
-        Spectra::DenseGenMatProd<double> op(adjacencyMatrix);
-        Spectra::GenEigsSolver<Spectra::DenseGenMatProd<double>> solver(op, nev, ncv);
-        solver.init();
-        int nconv = solver.compute(Spectra::SortRule::LargestReal);
+    // x = (A + I) 1 を正規化して反復 (各成分は正のまま)
+    const auto& outTargets = csr.getOutTargets();
+    std::vector<double> x(n), y(n);
+    const double norm = static_cast<double>(n + csr.getEdgeCount());
+    for (size_t v = 0; v < n; ++v) {
+        x[v] = (1.0 + (outOffsets[v + 1] - outOffsets[v])) / norm;
+    }
+    for (int it = 1; it <= iterations && result.lower < result.upper; ++it) {
+        double lower = std::numeric_limits<double>::infinity();
+        double upper = 0.0;
+        double sum = 0.0;
+        for (size_t v = 0; v < n; ++v) {
+            y[v] = 0.0;
+            for (CsrGraph::Id e = outOffsets[v]; e < outOffsets[v + 1]; ++e) {
+                y[v] += x[outTargets[e]];
+            }
+            lower = std::min(lower, y[v] / x[v]);
+            upper = std::max(upper, y[v] / x[v]);
+            sum += y[v];
+        }
+        result.lower = std::max(result.lower, lower);
+        result.upper = std::min(result.upper, upper);
+        result.value = sum;
+        result.iterations = it;
 
-        if (solver.info() == Spectra::CompInfo::Successful && nconv > 0) {
-            return solver.eigenvalues()[0].real();
-        } else {
-            throw std::runtime_error("Spectra failed to compute eigenvalues.");
+        // x <- (A + I) x を正規化
+        for (size_t v = 0; v < n; ++v) {
+            x[v] = (x[v] + y[v]) / (1.0 + sum);
         }
-    } catch (const std::exception& e) {
-        // Spectraが失敗した場合、Eigenを使用
+    }
+    return result;
+}
+
+// 非負の疎行列の最大固有値を返す関数
+double calculateMaxEigenvalue(const Eigen::SparseMatrix<double>& matrix,
+                              const EigenOptions& options) {
+    const int n = matrix.rows();
+
+    // べき乗法
+    PerronRoot root = calculatePerronRoot(matrix, options);
+    if (root.converged) {
+        return root.value;
+    }
+
+    // べき乗法が収束しない場合、Spectraを使用
+    if (n > 3) {
         try {
-            Eigen::EigenSolver<Eigen::MatrixXd> solver(adjacencyMatrix);
-            if (solver.info() == Eigen::Success) {
-                return solver.eigenvalues().real().maxCoeff();
-            } else {
-                throw std::runtime_error("Eigen failed to compute eigenvalues.");
+            const int nev = 1;
+            const int ncv = std::min(std::max(3, 2 * nev + 1), n - 1);
+
+            Spectra::SparseGenMatProd<double> op(matrix);
+            Spectra::GenEigsSolver<Spectra::SparseGenMatProd<double>> solver(op, nev, ncv);
+            solver.init();
+            int nconv = solver.compute(Spectra::SortRule::LargestReal, options.maxIterations,
+                                       options.tolerance);
+
+            if (solver.info() == Spectra::CompInfo::Successful && nconv > 0) {
+                return solver.eigenvalues()[0].real();
+            }
+        } catch (const std::exception&) {
+            // 下のフォールバックで計算
+        }
+    }
+
+    // Spectraも失敗した場合、小さい行列のみEigenを使用
+    if (n <= DENSE_LIMIT) {
+        Eigen::EigenSolver<Eigen::MatrixXd> solver(Eigen::MatrixXd(matrix), false);
+        if (solver.info() == Eigen::Success) {
+            return solver.eigenvalues().real().maxCoeff();
+        }
+        throw std::runtime_error("Eigen failed to compute eigenvalues.");
+    }
+
+    // 大きな行列では外挿で止めたべき乗法の推定値を上下界とともに警告して返す
+    std::ostringstream message;
+    message << std::setprecision(12) << "the largest eigenvalue of a " << n << "x" << n
+            << " matrix is not bound-verified: estimate " << root.value
+            << ", Collatz-Wielandt bounds [" << root.lower << ", " << root.upper << "] after "
+            << root.iterations << " iterations";
+    if (!root.extrapolated) {
+        throw std::runtime_error("Power iteration did not converge; " + message.str());
+    }
+    std::cerr << "Warning: " << message.str() << std::endl;
+    return root.value;
+}
+
+// 非負の密行列の最大固有値を返す関数
+double calculateMaxEigenvalue(const Eigen::MatrixXd& matrix, const EigenOptions& options) {
+    return calculateMaxEigenvalue(Eigen::SparseMatrix<double>(matrix.sparseView()), options);
+}
+
+// 非負行列の最大固有値をべき乗法で計算
+// 正のベクトル x に対して min (Ax)_i / x_i <= ρ(A) <= max (Ax)_i / x_i (Collatz–Wielandt) が成り立つ．
+// 上下界が一致すれば収束 (converged) とする．可約な行列では下界が ρ に近づかないことがあるため，
+// 推定値の変化量から外挿した誤差が許容誤差を下回った場合も少し後に止めるが，
+// 上下界で確かめられていないので extrapolated として区別する．
+PerronRoot calculatePerronRoot(const Eigen::SparseMatrix<double>& matrix,
+                               const EigenOptions& options) {
+    Eigen::VectorXd vector;
+    return calculatePerronRoot(matrix, options, vector);
+}
+
+// ウォームスタート付きのべき乗法
+PerronRoot calculatePerronRoot(const Eigen::SparseMatrix<double>& matrix,
+                               const EigenOptions& options, Eigen::VectorXd& vector) {
+    PerronRoot result;
+    const Eigen::Index n = matrix.rows();
+    if (n == 0) {
+        result.converged = true;
+        return result;
+    }
+
+    Eigen::VectorXd& x = vector;
+    if (x.size() == n && x.allFinite() && x.minCoeff() >= 0.0 && x.sum() > 0.0) {
+        x = (1.0 - WARM_START_MIX) * x / x.sum() +
+            Eigen::VectorXd::Constant(n, WARM_START_MIX / n);
+    } else {
+        x = Eigen::VectorXd::Constant(n, 1.0 / n);
+    }
+    Eigen::VectorXd y(n);
+    double prevEstimate = 0.0;
+    std::deque<double> diffs;  // 直近の推定値の変化量
+    int stopAt = 0;            // 外挿した誤差が許容誤差を下回った後に止める反復
+
+    for (int it = 1; it <= options.maxIterations; ++it) {
+        y = matrix * x;
+        result.iterations = it;
+
+        // Collatz–Wielandtの上下界
+        double lower = std::numeric_limits<double>::infinity();
+        double upper = 0.0;
+        for (Eigen::Index i = 0; i < n; ++i) {
+            if (x[i] > 0.0) {
+                double ratio = y[i] / x[i];
+                lower = std::min(lower, ratio);
+                upper = std::max(upper, ratio);
+            }
+        }
+        result.lower = lower;
+        result.upper = upper;
+
+        // x の和は1なので sum(Ax) は上下界の間にある推定値
+        double estimate = y.sum();
+        result.value = estimate;
+
+        double scale = std::max(1.0, upper);
+        if (upper - lower <= options.tolerance * scale) {
+            result.converged = true;
+            result.extrapolated = false;
+            return result;
+        }
+
+        // 変化量の比の直近の最大値 r から残りの誤差を diff * r / (1 - r) と見積もる
+        // (複素固有値により収束が振動するため1回分の比では過小評価しうる)
+        double diff = std::abs(estimate - prevEstimate);
+        prevEstimate = estimate;
+        if (it > 1) {
+            diffs.push_back(diff);
+            if (diffs.size() > RATE_WINDOW + 1) {
+                diffs.pop_front();
+            }
+        }
+        if (diffs.size() == RATE_WINDOW + 1) {
+            double rate = 0.0;
+            for (size_t i = 1; i < diffs.size(); ++i) {
+                rate = std::max(rate, diffs[i - 1] > 0.0 ? diffs[i] / diffs[i - 1] : 0.0);
+            }
+            if (!result.extrapolated &&
+                (diff == 0.0 ||
+                 (rate < 1.0 && diff * rate / (1.0 - rate) <= options.tolerance * scale))) {
+                // 既約な行列なら上下界も程なく一致するので，RATE_WINDOW 回だけ反復を続ける
+                result.extrapolated = true;
+                stopAt = it + static_cast<int>(RATE_WINDOW);
             }
-        } catch (const std::exception& eigenEx) {
-            throw std::runtime_error(std::string("[Eigen] exception: ") + eigenEx.what());
         }
+        if (result.extrapolated && it >= stopAt) {
+            return result;
+        }
+
+        // x <- (A + I) x を正規化 (対角の1により周期的な行列でも振動しない)
+        x += y;
+        x /= x.sum();
     }
+
+    return result;
 }
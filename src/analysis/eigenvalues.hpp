@@ -1,8 +1,53 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 #include "../core/Graph.hpp"
 
+// 最大固有値計算のオプション
+struct EigenOptions {
+    double tolerance = 1e-10;   // 収束判定の許容誤差 (相対)
+    int maxIterations = 10000;  // べき乗法の最大反復回数
+};
+
+// べき乗法によるPerron根 (非負行列の最大固有値) の計算結果
+struct PerronRoot {
+    double value = 0.0;  // 推定値
+    double lower = 0.0;  // Collatz–Wielandtの下界
+    double upper = 0.0;  // Collatz–Wielandtの上界
+    int iterations = 0;  // 反復回数
+    bool converged = false;     // 上下界が一致した
+    bool extrapolated = false;  // 上下界は一致せず，変化量から外挿した誤差で止めた
+};
+
 // Graphを引数に取り、最大固有値を返す関数
-double calculateMaxEigenvalue(const Graph& graph);
+// 位相によるブロック巡回構造を持つ場合はブロック積の固有値問題に帰着させる．
+double calculateMaxEigenvalue(const Graph& graph, const EigenOptions& options = {});
+
+// 最大固有値の安い上下界 (PerronRoot の lower, upper)
+// 出次数・入次数の最小値と最大値 (ρ(A) = ρ(A^T)) から始め，A + I を iterations 回反復した
+// 正のベクトルのCollatz–Wielandtの上下界で狭める．上下界が一致しても converged は立てない．
+// (iterations = 0 の upper は次数だけによる上界で，行列を作らずに枝刈りや見積もりに使える)
+PerronRoot boundMaxEigenvalue(const CsrGraph& graph, int iterations = 0);
+PerronRoot boundMaxEigenvalue(const Graph& graph, int iterations = 0);
+
+// 非負の疎行列の最大固有値を返す関数
+// べき乗法の上下界が一致しなければSpectra (疎行列積)，小さい行列なら密な固有値分解に切り替える．
+// どれも使えない大きな行列では，外挿で止めた推定値を上下界とともに警告して返し，
+// 外挿でも止まらなければ std::runtime_error
+double calculateMaxEigenvalue(const Eigen::SparseMatrix<double>& matrix,
+                              const EigenOptions& options = {});
+
+// 非負の密行列の最大固有値を返す関数
+double calculateMaxEigenvalue(const Eigen::MatrixXd& matrix, const EigenOptions& options = {});
+
+// 非負行列の最大固有値をべき乗法で計算
+// A + I を反復することで周期的 (非原始的) な行列でも振動せずに収束する．
+PerronRoot calculatePerronRoot(const Eigen::SparseMatrix<double>& matrix,
+                               const EigenOptions& options = {});
+
+// vector を初期ベクトルとしてべき乗法を行い，終了時のベクトルを vector に書き戻す (ウォームスタート)
+// 大きさが合わなければ一様ベクトルから始める．
+PerronRoot calculatePerronRoot(const Eigen::SparseMatrix<double>& matrix,
+                               const EigenOptions& options, Eigen::VectorXd& vector);
@@ -1,6 +1,9 @@
 #include "Parser.hpp"
 
 #include <cstdlib>
+#include <limits>
+#include <regex>
+#include <stdexcept>
 
 #include "io/utils.hpp"
 
@@ -14,7 +17,54 @@ Parser::Parser() {
     app.add_flag("--pdf", options.pdf, "Generate PDF files");
     app.add_flag("--png", options.png, "Generate PNG files");
     app.add_flag("--max-eig", options.maxEig, "Calculate max eigenvalue");
+    app.add_option("--eig-tol", options.eigTolerance,
+                   "Relative tolerance of the max eigenvalue solver");
+    app.add_option("--eig-max-iter", options.eigMaxIterations,
+                   "Maximum iterations of the max eigenvalue solver");
+    app.add_option("--eig-batch", options.eigBatch,
+                   "Number of forbidden sets whose max eigenvalues are computed together in "
+                   "JSON sweeps (1: one at a time)");
     app.add_option("--sequences", options.seqLength, "Calculate length of edge label sequences");
+    app.add_flag("--dawg", options.dawg,
+                 "Write --sequences as a minimal DAWG in a binary .dawg file instead of CSV");
+    app.add_option("--contains", options.contains,
+                   "Sequences to look up in a .dawg input (prints true or false for each)");
+    app.add_option("--encode", options.encodePath,
+                   "Binary file to encode as allowed sequences of --code-length (lexicographic "
+                   "rank of each word)");
+    app.add_option("--decode", options.decodePath,
+                   "File written by --encode to decode back into the binary file");
+    app.add_option("--code-length", options.codeLength,
+                   "Length of the allowed sequences used by --encode and --decode");
+    app.add_option("--count-paths", options.pathLength,
+                   "Count paths of this length exactly, by start and end phase");
+    app.add_option("--jobs", options.jobs,
+                   "Number of worker threads for JSON sweeps and --sequences "
+                   "(0: all hardware threads)");
+    app.add_option("--cache", options.cacheDir,
+                   "Directory of the result cache for JSON sweeps (graphs and max eigenvalues)");
+    app.add_flag("--resume", options.resume,
+                 "Skip forbidden sets completed in the checkpoint of an all-patterns run");
+    app.add_option("--checkpoint-interval", options.checkpointInterval,
+                   "Seconds between checkpoint saves in all-patterns runs");
+    app.add_option("--shard", options.shard,
+                   "Process only shard i of N (0-based, e.g. 2/8) of an all-patterns run");
+    app.add_flag("--merge", options.merge,
+                 "Merge the shard summaries of an all-patterns run into summary.csv");
+    app.add_flag("--incremental", options.incremental,
+                 "Sweep all-patterns DeBruijn runs in minimal-change order, updating the graph "
+                 "and max eigenvalue incrementally");
+    app.add_flag("--no-prune", options.noPrune,
+                 "Generate all-patterns sets even if they contain a recorded zero-capacity set");
+    app.add_option("--top-k", options.topK,
+                   "Search only the K all-patterns sets with the largest max eigenvalue "
+                   "(branch and bound)");
+    app.add_option("--min-capacity", options.minCapacity,
+                   "Skip all outputs of graphs whose capacity (log2 of the max eigenvalue) is "
+                   "below this value");
+    app.add_option("--max-capacity", options.maxCapacity,
+                   "Skip all outputs of graphs whose capacity (log2 of the max eigenvalue) is "
+                   "above this value");
 }
 
 Parser::ParsedOptions Parser::parse(int argc, char* argv[]) {
@@ -23,17 +73,47 @@ Parser::ParsedOptions Parser::parse(int argc, char* argv[]) {
     } catch (const CLI::ParseError& e) {
         std::exit(app.exit(e));
     }
+    parseShard();
     return options;
 }
 
+// --shard i/N を解釈
+void Parser::parseShard() {
+    if (options.shard.empty()) {
+        return;
+    }
+    std::smatch match;
+    if (!std::regex_match(options.shard, match, std::regex(R"((\d+)/(\d+))"))) {
+        io::utils::printErrorAndExit("Invalid shard specified. Use i/N (e.g. 0/4).");
+    }
+    try {
+        unsigned long index = std::stoul(match[1].str());
+        unsigned long count = std::stoul(match[2].str());
+        if (count == 0 || index >= count || count > std::numeric_limits<unsigned int>::max()) {
+            io::utils::printErrorAndExit("Invalid shard specified. Requires 0 <= i < N.");
+        }
+        options.shardIndex = static_cast<unsigned int>(index);
+        options.shardCount = static_cast<unsigned int>(count);
+    } catch (const std::out_of_range&) {
+        io::utils::printErrorAndExit("Invalid shard specified. Requires 0 <= i < N.");
+    }
+}
+
 void Parser::validate() {
     if (options.format != "edges" && options.format != "matrix") {
         io::utils::printErrorAndExit("Invalid format specified. Use 'edges' or 'matrix'.");
     }
 
-    if (!options.maxEig && options.seqLength == 0 && !options.isMatrix && !options.pdf && !options.png) {
+    const bool coding = !options.encodePath.empty() || !options.decodePath.empty();
+    if (!options.maxEig && options.seqLength == 0 && options.pathLength == 0 && !options.isMatrix &&
+        !options.pdf && !options.png && !coding) {
         io::utils::printErrorAndExit(
-            "No output option specified. Use at least one of --matrix, --pdf, --png, --max-eig, or --sequences.");
+            "No output option specified. Use at least one of --matrix, --pdf, --png, --max-eig, "
+            "--sequences, --count-paths, --encode, or --decode.");
+    }
+
+    if (coding && options.codeLength == 0) {
+        io::utils::printErrorAndExit("--encode and --decode require --code-length.");
     }
 }
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <CLI/CLI.hpp>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace CLI {
 
@@ -14,7 +16,30 @@ class Parser {
         bool pdf = false;
         bool png = false;
         bool maxEig = false;
+        double eigTolerance = 1e-10;
+        int eigMaxIterations = 10000;
+        unsigned int eigBatch = 64;
         unsigned int seqLength = 0;
+        bool dawg = false;                  // 許可系列をDAWGのバイナリ形式で出力
+        std::vector<std::string> contains;  // DAWGの入力で含むか調べる系列
+        std::string encodePath;             // 許可系列に変換するバイナリファイル
+        std::string decodePath;             // バイナリファイルに戻す許可系列のファイル
+        unsigned int codeLength = 0;        // 変換に使う許可系列の長さ
+        unsigned int pathLength = 0;  // 0: 経路数を数えない
+        unsigned int jobs = 1;
+        std::string cacheDir;
+        bool resume = false;
+        unsigned int checkpointInterval = 60;
+        std::string shard;  // "i/N": 禁止集合の列挙を N 分割したうちの i 番目 (0始まり)
+        unsigned int shardIndex = 0;
+        unsigned int shardCount = 1;
+        bool merge = false;
+        bool incremental = false;
+        bool noPrune = false;
+        unsigned int topK = 0;  // 0: 全件を生成
+        // 容量 (最大固有値の log2) の範囲 (既定は無制限)
+        double minCapacity = -std::numeric_limits<double>::infinity();
+        double maxCapacity = std::numeric_limits<double>::infinity();
     };
 
     Parser();
@@ -24,6 +49,8 @@ class Parser {
    private:
     CLI::App app{"PFT-tools"};
     ParsedOptions options;
+
+    void parseShard();
 };
 
 }  // namespace CLI
@@ -0,0 +1,144 @@
+#include "CsrGraph.hpp"
+
+// ノードを追加
+CsrGraph::Id CsrGraph::addNode(const std::string& label, unsigned int phase) {
+    labels.push_back(label);
+    phases.push_back(phase);
+    csrValid = false;
+    reverseValid = false;
+    return static_cast<Id>(labels.size() - 1);
+}
+
+// 辺ラベルを登録
+CsrGraph::Id CsrGraph::addSymbol(const std::string& symbol) {
+    auto [it, inserted] = toSymbol.emplace(symbol, static_cast<Id>(symbolTable.size()));
+    if (inserted) {
+        symbolTable.push_back(symbol);
+    }
+    return it->second;
+}
+
+// エッジを追加
+void CsrGraph::addEdge(Id source, Id target, Id symbol) {
+    edgeSources.push_back(source);
+    edgeTargets.push_back(target);
+    edgeSymbols.push_back(symbol);
+    csrValid = false;
+    reverseValid = false;
+}
+
+// 容量を予約
+void CsrGraph::reserve(size_t nodeCount, size_t edgeCount) {
+    labels.reserve(nodeCount);
+    phases.reserve(nodeCount);
+    edgeSources.reserve(edgeCount);
+    edgeTargets.reserve(edgeCount);
+    edgeSymbols.reserve(edgeCount);
+}
+
+// CSRを構築 (始点ごとの安定な計数ソート)
+void CsrGraph::buildCsr() const {
+    const size_t n = labels.size();
+    const size_t m = edgeSources.size();
+
+    outOffsets.assign(n + 1, 0);
+    for (Id src : edgeSources) {
+        outOffsets[src + 1]++;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        outOffsets[v + 1] += outOffsets[v];
+    }
+
+    outTargets.resize(m);
+    outSymbols.resize(m);
+    std::vector<Id> cursor(outOffsets.begin(), outOffsets.end() - 1);
+    for (size_t e = 0; e < m; ++e) {
+        Id pos = cursor[edgeSources[e]]++;
+        outTargets[pos] = edgeTargets[e];
+        outSymbols[pos] = edgeSymbols[e];
+    }
+
+    csrValid = true;
+}
+
+const std::vector<CsrGraph::Id>& CsrGraph::getOutOffsets() const {
+    if (!csrValid) {
+        buildCsr();
+    }
+    return outOffsets;
+}
+
+const std::vector<CsrGraph::Id>& CsrGraph::getOutTargets() const {
+    if (!csrValid) {
+        buildCsr();
+    }
+    return outTargets;
+}
+
+const std::vector<CsrGraph::Id>& CsrGraph::getOutSymbols() const {
+    if (!csrValid) {
+        buildCsr();
+    }
+    return outSymbols;
+}
+
+// 逆向きCSRを構築 (終点ごとの安定な計数ソート)
+void CsrGraph::buildReverseCsr() const {
+    const size_t n = labels.size();
+    const size_t m = edgeTargets.size();
+
+    inOffsets.assign(n + 1, 0);
+    for (Id tgt : edgeTargets) {
+        inOffsets[tgt + 1]++;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        inOffsets[v + 1] += inOffsets[v];
+    }
+
+    inSources.resize(m);
+    std::vector<Id> cursor(inOffsets.begin(), inOffsets.end() - 1);
+    for (size_t e = 0; e < m; ++e) {
+        inSources[cursor[edgeTargets[e]]++] = edgeSources[e];
+    }
+
+    reverseValid = true;
+}
+
+const std::vector<CsrGraph::Id>& CsrGraph::getInOffsets() const {
+    if (!reverseValid) {
+        buildReverseCsr();
+    }
+    return inOffsets;
+}
+
+const std::vector<CsrGraph::Id>& CsrGraph::getInSources() const {
+    if (!reverseValid) {
+        buildReverseCsr();
+    }
+    return inSources;
+}
+
+// 部分グラフを生成
+CsrGraph CsrGraph::subgraph(const std::vector<bool>& keep) const {
+    const Id removed = static_cast<Id>(-1);
+    std::vector<Id> toNew(labels.size(), removed);
+
+    CsrGraph sub;
+    sub.symbolTable = symbolTable;
+    sub.toSymbol = toSymbol;
+    for (size_t v = 0; v < labels.size(); ++v) {
+        if (keep[v]) {
+            toNew[v] = sub.addNode(labels[v], phases[v]);
+        }
+    }
+
+    for (size_t e = 0; e < edgeSources.size(); ++e) {
+        Id src = toNew[edgeSources[e]];
+        Id tgt = toNew[edgeTargets[e]];
+        if (src != removed && tgt != removed) {
+            sub.addEdge(src, tgt, edgeSymbols[e]);
+        }
+    }
+
+    return sub;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 整数IDで表現したコンパクトなグラフ
+// ノードは 0..n-1 の連番ID，ラベルと位相は別テーブルに保持する．
+// 辺は追加順に保持し，出辺のCSR (offsets + targets + symbols) は必要になった時点で構築する．
+class CsrGraph {
+   public:
+    using Id = std::uint32_t;
+
+    // ノードを追加し，そのIDを返す
+    Id addNode(const std::string& label, unsigned int phase = 0);
+
+    // 辺ラベルを登録し，そのIDを返す (登録済みなら既存のID)
+    Id addSymbol(const std::string& symbol);
+
+    // エッジを追加
+    void addEdge(Id source, Id target, Id symbol);
+
+    // 容量を予約
+    void reserve(size_t nodeCount, size_t edgeCount);
+
+    // サイズ
+    size_t getNodeCount() const { return labels.size(); }
+    size_t getEdgeCount() const { return edgeSources.size(); }
+    size_t getSymbolCount() const { return symbolTable.size(); }
+
+    // ノード・辺ラベルの参照
+    const std::string& getLabel(Id node) const { return labels[node]; }
+    unsigned int getPhase(Id node) const { return phases[node]; }
+    const std::string& getSymbol(Id symbol) const { return symbolTable[symbol]; }
+
+    // 追加順のエッジ
+    Id getEdgeSource(size_t edge) const { return edgeSources[edge]; }
+    Id getEdgeTarget(size_t edge) const { return edgeTargets[edge]; }
+    Id getEdgeSymbol(size_t edge) const { return edgeSymbols[edge]; }
+
+    // CSR: ノードvの出辺は [offsets[v], offsets[v + 1]) (同一始点内は追加順)
+    const std::vector<Id>& getOutOffsets() const;
+    const std::vector<Id>& getOutTargets() const;
+    const std::vector<Id>& getOutSymbols() const;
+
+    // 逆向きのCSR: ノードvの入辺の始点は inSources[inOffsets[v] .. inOffsets[v + 1])
+    const std::vector<Id>& getInOffsets() const;
+    const std::vector<Id>& getInSources() const;
+
+    // keep[v] が真のノードとその間の辺だけを残した部分グラフを生成 (順序は維持)
+    CsrGraph subgraph(const std::vector<bool>& keep) const;
+
+   private:
+    std::vector<std::string> labels;  // ノードラベル
+    std::vector<unsigned int> phases;  // ノード位相
+
+    std::vector<std::string> symbolTable;           // 辺ラベル表
+    std::unordered_map<std::string, Id> toSymbol;  // 辺ラベル -> ID
+
+    std::vector<Id> edgeSources;  // 始点 (追加順)
+    std::vector<Id> edgeTargets;  // 終点 (追加順)
+    std::vector<Id> edgeSymbols;  // 辺ラベルID (追加順)
+
+    // CSRキャッシュ
+    mutable bool csrValid = false;
+    mutable std::vector<Id> outOffsets;
+    mutable std::vector<Id> outTargets;
+    mutable std::vector<Id> outSymbols;
+
+    // 逆向きCSRキャッシュ
+    mutable bool reverseValid = false;
+    mutable std::vector<Id> inOffsets;
+    mutable std::vector<Id> inSources;
+
+    void buildCsr() const;
+    void buildReverseCsr() const;
+};
@@ -1,42 +1,89 @@
 #include "Graph.hpp"
 
-#include <queue>
-#include <unordered_set>
+// コンストラクタ
+Graph::Graph(CsrGraph csr) : csr(std::move(csr)) {}
+
+// キャッシュを無効化
+void Graph::invalidate() {
+    nodesValid = false;
+    edgesValid = false;
+    idEdgesValid = false;
+}
+
+// NodeをIDに解決 (未登録なら追加)
+CsrGraph::Id Graph::resolveNode(const Node& node) {
+    // 索引は初回のみ作成 (CsrGraphから構築した場合は同じ (label, phase) のノードが
+    // 複数ありうるので，ノード数との比較では判定しない)
+    if (!toIdValid) {
+        for (CsrGraph::Id v = 0; v < csr.getNodeCount(); ++v) {
+            toId.emplace(Node(csr.getLabel(v), csr.getPhase(v)), v);
+        }
+        toIdValid = true;
+    }
+
+    auto it = toId.find(node);
+    if (it != toId.end()) {
+        return it->second;
+    }
+
+    CsrGraph::Id id = csr.addNode(node.getLabel(), node.getPhase());
+    toId.emplace(node, id);
+    invalidate();
+    return id;
+}
 
 // ノードを追加
 void Graph::addNode(const Node& node) {
-    nodes.push_back(node);
+    resolveNode(node);
 }
 
 // エッジを追加
 void Graph::addEdge(const Edge& edge) {
-    edges.push_back(edge);
+    CsrGraph::Id src = resolveNode(edge.getSource());
+    CsrGraph::Id tgt = resolveNode(edge.getTarget());
+    csr.addEdge(src, tgt, csr.addSymbol(edge.getLabel()));
+    invalidate();
 }
 
 // ノードリストを取得
 const std::vector<Node>& Graph::getNodes() const {
+    if (!nodesValid) {
+        nodes.clear();
+        nodes.reserve(csr.getNodeCount());
+        for (CsrGraph::Id v = 0; v < csr.getNodeCount(); ++v) {
+            nodes.emplace_back(csr.getLabel(v), csr.getPhase(v));
+        }
+        nodesValid = true;
+    }
     return nodes;
 }
 
 // エッジリストを取得
 const std::vector<Edge>& Graph::getEdges(const mode& mode) const {
     if (mode == mode::ID) {
-        // ノードからインデックスへのマッピングを作成
-        std::unordered_map<Node, size_t> toIdx;
-        for (size_t i = 0; i < nodes.size(); ++i) {
-            toIdx[nodes[i]] = i;
-        }
-
-        // IDモードのエッジリストを生成
-        idEdges.clear();
-        idEdges.reserve(edges.size());
-        for (const auto& edge : edges) {
-            Node src(std::to_string(toIdx.at(edge.getSource())));
-            Node tgt(std::to_string(toIdx.at(edge.getTarget())));
-            idEdges.emplace_back(src, tgt, edge.getLabel());
+        // IDモードではノードIDをそのままラベルとする
+        if (!idEdgesValid) {
+            idEdges.clear();
+            idEdges.reserve(csr.getEdgeCount());
+            for (size_t e = 0; e < csr.getEdgeCount(); ++e) {
+                Node src(std::to_string(csr.getEdgeSource(e)));
+                Node tgt(std::to_string(csr.getEdgeTarget(e)));
+                idEdges.emplace_back(src, tgt, csr.getSymbol(csr.getEdgeSymbol(e)));
+            }
+            idEdgesValid = true;
         }
         return idEdges;
     } else {
+        if (!edgesValid) {
+            const auto& nodeList = getNodes();
+            edges.clear();
+            edges.reserve(csr.getEdgeCount());
+            for (size_t e = 0; e < csr.getEdgeCount(); ++e) {
+                edges.emplace_back(nodeList[csr.getEdgeSource(e)], nodeList[csr.getEdgeTarget(e)],
+                                   csr.getSymbol(csr.getEdgeSymbol(e)));
+            }
+            edgesValid = true;
+        }
         return edges;
     }
 }
@@ -44,75 +91,8 @@ const std::vector<Edge>& Graph::getEdges(const mode& mode) const {
 // 隣接リストを生成
 std::unordered_map<Node, std::unordered_map<std::string, Node>> Graph::genAdjacencyList() const {
     std::unordered_map<Node, std::unordered_map<std::string, Node>> adjList;
-    for (const auto& edge : edges) {
+    for (const auto& edge : getEdges()) {
         adjList[edge.getSource()][edge.getLabel()] = edge.getTarget();
     }
     return adjList;
 }
-
-// 長さLの経路の数を計算
-int Graph::countPathsOfLength(int length) const {
-    if (length <= 0)
-        return 0;
-
-    auto adjList = genAdjacencyList();
-    int pathCount = 0;
-
-    for (const auto& node : nodes) {
-        std::queue<std::pair<Node, int>> queue;
-        queue.push({node, 0});
-
-        while (!queue.empty()) {
-            auto [currentNode, currentLength] = queue.front();
-            queue.pop();
-
-            if (currentLength == length) {
-                pathCount++;
-                continue;
-            }
-
-            if (adjList.find(currentNode) != adjList.end()) {
-                for (const auto& [_, neighbor] : adjList[currentNode]) {
-                    queue.push({neighbor, currentLength + 1});
-                }
-            }
-        }
-    }
-
-    return pathCount;
-}
-
-// 辺のラベルを繋げてできる指定された長さの系列の集合を取得
-// 注意:
-// このアルゴリズムは指数時間計算量を持ち、大きなグラフや長い系列長に対してはメモリや計算時間が膨大になる可能性があります。
-// 必要に応じてlengthやグラフサイズに制限を設けてください。
-std::unordered_set<std::string> Graph::getEdgeLabelSequences(int length) const {
-    if (length <= 0)
-        return {};
-
-    auto adjList = genAdjacencyList();
-    std::unordered_set<std::string> sequences;
-
-    for (const auto& node : nodes) {
-        std::queue<std::tuple<Node, std::string, int>> queue;
-        queue.push({node, "", 0});
-
-        while (!queue.empty()) {
-            auto [currentNode, currentSequence, currentLength] = queue.front();
-            queue.pop();
-
-            if (adjList.find(currentNode) != adjList.end()) {
-                for (const auto& [label, neighbor] : adjList[currentNode]) {
-                    int nextLength = currentLength + 1;
-                    if (nextLength == length) {
-                        sequences.insert(currentSequence + label);
-                    } else if (nextLength < length) {
-                        queue.push({neighbor, currentSequence + label, nextLength});
-                    }
-                }
-            }
-        }
-    }
-
-    return sequences;
-}
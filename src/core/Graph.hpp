@@ -1,20 +1,26 @@
 #pragma once
 
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "CsrGraph.hpp"
 #include "Edge.hpp"
 #include "Node.hpp"
 
+// CsrGraph に対する Node / Edge ベースのビュー
+// 実体は整数IDのコンパクト表現で保持し，Node / Edge のリストは参照時に生成する．
 class Graph {
    public:
     enum class mode { Normal, ID };
 
-    // ノードを追加
+    // コンストラクタ
+    Graph() = default;
+    explicit Graph(CsrGraph csr);
+
+    // ノードを追加 (登録済みのノードは無視)
     void addNode(const Node& node);
 
-    // エッジを追加
+    // エッジを追加 (未登録の端点はノードとして登録)
     void addEdge(const Edge& edge);
 
     // ノードリストを取得
@@ -23,17 +29,25 @@ class Graph {
     // エッジリストを取得
     const std::vector<Edge>& getEdges(const mode& mode = mode::Normal) const;
 
+    // コンパクト表現を取得
+    const CsrGraph& getCsr() const { return csr; }
+
     // 隣接リストを生成
     std::unordered_map<Node, std::unordered_map<std::string, Node>> genAdjacencyList() const;
 
-    // 長さLの経路の数を計算
-    int countPathsOfLength(int length) const;
-
-    // 長さLのエッジラベル列の集合を取得
-    std::unordered_set<std::string> getEdgeLabelSequences(int length) const;
-
    private:
-    std::vector<Node> nodes;            // ノードリスト
-    std::vector<Edge> edges;            // エッジリスト
+    CsrGraph csr;                                  // コンパクト表現
+    std::unordered_map<Node, CsrGraph::Id> toId;  // Node -> ID (Node経由の追加用)
+    bool toIdValid = false;                       // toId を作成済みか
+
+    // Node / Edge ビューのキャッシュ
+    mutable bool nodesValid = false;
+    mutable bool edgesValid = false;
+    mutable bool idEdgesValid = false;
+    mutable std::vector<Node> nodes;    // ノードリスト
+    mutable std::vector<Edge> edges;    // エッジリスト
     mutable std::vector<Edge> idEdges;  // IDモード用のエッジキャッシュ
+
+    CsrGraph::Id resolveNode(const Node& node);
+    void invalidate();
 };
@@ -0,0 +1,127 @@
+#include "Checkpoint.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "io/utils.hpp"
+#include "nlohmann/json.hpp"
+
+namespace io {
+
+using json = nlohmann::json;
+
+Checkpoint::Checkpoint(const std::string& path, const std::string& fingerprint,
+                       std::chrono::seconds interval, std::uint64_t start)
+    : path(path),
+      fingerprint(fingerprint),
+      interval(interval),
+      lastSave(std::chrono::steady_clock::now()),
+      start(start),
+      completedPrefix(start) {}
+
+// 設定の識別子
+std::string Checkpoint::genFingerprint(const io::type::Config& config) {
+    const auto& generation = config.generation;
+    std::ostringstream fingerprint;
+    fingerprint << "mode=" << generation.mode << ";algorithm=" << generation.algorithm
+                << ";opt_mode=" << generation.opt_mode << ";alphabet=" << generation.alphabet
+                << ";period=" << generation.period << ";length=" << generation.forbidden.length
+                << ";position=";
+    for (size_t i = 0; i < generation.forbidden.position.size(); ++i) {
+        if (i > 0) {
+            fingerprint << "-";
+        }
+        fingerprint << generation.forbidden.position[i];
+    }
+    fingerprint << ";symmetry=" << generation.symmetry
+                << ";output_dir=" << config.output.output_dir;
+    return fingerprint.str();
+}
+
+// チェックポイントを読み込む
+bool Checkpoint::load() {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    json data;
+    try {
+        file >> data;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Broken checkpoint: " + path + " - " + e.what());
+    }
+    if (data.at("config").get<std::string>() != fingerprint ||
+        data.value("start", std::uint64_t{0}) != start) {
+        throw std::runtime_error("Checkpoint was written for a different config: " + path);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    completedPrefix = data.at("completed_prefix").get<std::uint64_t>();
+    completed.clear();
+    for (const auto& index : data.at("completed")) {
+        completed.insert(index.get<std::uint64_t>());
+    }
+    return true;
+}
+
+// 完了済みか
+bool Checkpoint::isCompleted(std::uint64_t index) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (start <= index && index < completedPrefix) || completed.count(index) > 0;
+}
+
+// 完了を記録
+void Checkpoint::markCompleted(std::uint64_t index) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index < completedPrefix && index >= start) {
+        return;
+    }
+    completed.insert(index);
+
+    // 連続して完了した部分を先頭の個数にまとめる
+    while (!completed.empty() && *completed.begin() == completedPrefix) {
+        completed.erase(completed.begin());
+        ++completedPrefix;
+    }
+
+    if (std::chrono::steady_clock::now() - lastSave >= interval) {
+        saveLocked(false);
+    }
+}
+
+// 保存
+void Checkpoint::save(bool finished) {
+    std::lock_guard<std::mutex> lock(mutex);
+    saveLocked(finished);
+}
+
+void Checkpoint::saveLocked(bool finished) {
+    json data;
+    data["config"] = fingerprint;
+    data["start"] = start;
+    data["completed_prefix"] = completedPrefix;
+    data["completed"] = json(std::vector<std::uint64_t>(completed.begin(), completed.end()));
+    data["finished"] = finished;
+
+    if (!io::utils::writeFileAtomically(path,
+                                        [&](std::ostream& file) { file << data.dump(2); })) {
+        std::cerr << "Failed to save checkpoint: " << path << std::endl;
+    }
+    lastSave = std::chrono::steady_clock::now();
+}
+
+// 完了済みの個数
+std::uint64_t Checkpoint::getCompletedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return completedPrefix - start + completed.size();
+}
+
+// 先頭から連続して完了した範囲の終端
+std::uint64_t Checkpoint::getCompletedPrefix() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return completedPrefix;
+}
+
+}  // namespace io
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "Config.hpp"
+
+namespace io {
+
+// all-patternsモードの進捗のチェックポイント
+// 禁止集合は列挙順の番号で識別し，完了済みの集合を
+// 「先頭から連続して完了した個数」と「それ以降で完了した番号」で保持する．
+// 並列実行時も後者は実行中のタスク数程度に収まる．
+class Checkpoint {
+   public:
+    // path: チェックポイントファイル，fingerprint: 設定の識別子，interval: 保存間隔 (秒)
+    // start: 担当する最初の番号 (分割実行時の範囲の先頭)
+    Checkpoint(const std::string& path, const std::string& fingerprint,
+               std::chrono::seconds interval, std::uint64_t start = 0);
+
+    // 設定の識別子 (列挙順と出力先を決める項目)
+    static std::string genFingerprint(const io::type::Config& config);
+
+    // チェックポイントを読み込む (ファイルがなければ false，設定が異なれば例外)
+    bool load();
+
+    // 完了済みか
+    bool isCompleted(std::uint64_t index) const;
+
+    // 完了を記録し，前回の保存から保存間隔が経過していれば保存 (スレッドセーフ)
+    void markCompleted(std::uint64_t index);
+
+    // 保存 (一時ファイルに書いてから置き換える)
+    void save(bool finished = false);
+
+    // 完了済みの個数
+    std::uint64_t getCompletedCount() const;
+
+    // 先頭から連続して完了した範囲の終端
+    std::uint64_t getCompletedPrefix() const;
+
+   private:
+    std::string path;
+    std::string fingerprint;
+    std::chrono::seconds interval;
+    std::chrono::steady_clock::time_point lastSave;
+
+    mutable std::mutex mutex;
+    std::uint64_t start;
+    std::uint64_t completedPrefix;      // [start, completedPrefix) は完了済み
+    std::set<std::uint64_t> completed;  // completedPrefix 以降で完了した番号
+
+    void saveLocked(bool finished);
+};
+
+}  // namespace io
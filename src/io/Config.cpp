@@ -42,6 +42,9 @@ void GenericConfig::validate() const {
     if (mode == "custom" && period == 0) {
         throw std::invalid_argument("Period must be greater than 0.");
     }
+    if (symmetry && mode != "all-patterns") {
+        throw std::invalid_argument("Symmetry reduction is only available in all-patterns mode.");
+    }
     forbidden.validate();
 }
 
@@ -140,6 +143,10 @@ void from_json(const json& j, GenericConfig& g) {
         }
     }
 
+    if (j.contains("symmetry")) {
+        j.at("symmetry").get_to(g.symmetry);
+    }
+
     g.period = j.contains("period") ? j.at("period").get<unsigned int>() : g.forbidden.position.size();
 }
 
@@ -40,6 +40,7 @@ struct GenericConfig {
     unsigned int alphabet;
     unsigned int period;
     ForbiddenConfig forbidden;
+    bool symmetry = false;  // 対称な禁止集合は軌道の代表元のみ生成する
 
     void validate() const;
     void formatForDeBruijn();
@@ -1,12 +1,15 @@
 #include "Input.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <sstream>
-#include <unordered_set>
+#include <stdexcept>
 #include <vector>
 
 #include "core/constants.hpp"
+#include "io/Output.hpp"
 #include "io/utils.hpp"
 #include "nlohmann/json.hpp"
 #include "utils/CombinationUtils.hpp"
@@ -81,8 +84,7 @@ bool readEdgesCSV(const std::string& filePath, Graph& graph) {
         return false;
     }
 
-    std::unordered_set<Node> nodes;
-
+    // 端点ノードはaddEdgeで初出順に登録される
     for (const auto& row : csvData) {
         if (row.size() < 3) {
             std::cerr << "Error: Invalid edge data format in file: " << filePath << std::endl;
@@ -91,16 +93,10 @@ bool readEdgesCSV(const std::string& filePath, Graph& graph) {
 
         Node source(row[0]);
         Node target(row[1]);
-        nodes.insert(source);
-        nodes.insert(target);
         std::string label = row[2];
         graph.addEdge(Edge(source, target, label));
     }
 
-    for (const auto& node : nodes) {
-        graph.addNode(node);
-    }
-
     return true;
 }
 
@@ -111,6 +107,11 @@ bool readMatrixCSV(const std::string& filePath, Graph& graph) {
         return false;
     }
 
+    // ノードIDを行番号と一致させるため先に全ノードを登録
+    for (size_t i = 0; i < csvData.size(); ++i) {
+        graph.addNode(Node(std::to_string(i)));
+    }
+
     for (size_t i = 0; i < csvData.size(); ++i) {
         if (csvData[i].size() != csvData.size()) {
             std::cerr << "Error: Adjacency matrix must be square in file: " << filePath
@@ -119,7 +120,6 @@ bool readMatrixCSV(const std::string& filePath, Graph& graph) {
         }
 
         Node source(std::to_string(i));
-        graph.addNode(source);
         for (size_t j = 0; j < csvData[i].size(); ++j) {
             for (size_t n = 0; n < std::stoi(csvData[i][j]); ++n) {
                 Node target(std::to_string(j));
@@ -131,10 +131,108 @@ bool readMatrixCSV(const std::string& filePath, Graph& graph) {
     return true;
 }
 
-std::vector<std::vector<std::vector<Node>>> genForbiddenList(const Config& config) {
-    std::vector<std::vector<std::vector<Node>>> forbiddenNodesList;
-    const auto& words = combine(ALPHABET.substr(0, config.generation.alphabet),
-                                config.generation.forbidden.length, true);
+// 32ビット符号なし整数をリトルエンディアンで読み込む
+bool readUint32(std::istream& in, std::uint32_t& value) {
+    unsigned char bytes[4];
+    if (!in.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+        return false;
+    }
+    value = static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8 |
+            static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    return true;
+}
+
+// count 個の整数を読み込む (ファイルの残りより多ければ確保する前に失敗させる)
+bool readUint32s(std::istream& in, std::uint32_t count, std::uint64_t remaining,
+                 std::vector<std::uint32_t>& values) {
+    if (static_cast<std::uint64_t>(count) * 4 > remaining) {
+        return false;
+    }
+    values.resize(count);
+    for (auto& value : values) {
+        if (!readUint32(in, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 許可系列のDAWG
+bool readSeqDawg(const std::string& filePath, SequenceDawg& dawg) {
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!io::utils::checkFileOpen(file, filePath)) {
+        return false;
+    }
+    const std::uint64_t size = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0);
+    auto remaining = [&]() { return size - static_cast<std::uint64_t>(file.tellg()); };
+    auto fail = [&](const std::string& reason) {
+        std::cerr << "Failed to read sequence DAWG: " << filePath << " - " << reason << std::endl;
+        return false;
+    };
+
+    char magic[sizeof(io::output::SEQ_DAWG_MAGIC) - 1];
+    if (!file.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, io::output::SEQ_DAWG_MAGIC, sizeof(magic)) != 0) {
+        return fail("not a sequence DAWG file");
+    }
+    std::uint32_t length = 0, labelCount = 0;
+    if (!readUint32(file, length) || !readUint32(file, labelCount) ||
+        static_cast<std::uint64_t>(labelCount) * 4 > remaining()) {
+        return fail("truncated header");
+    }
+    std::vector<std::string> labels(labelCount);
+    for (auto& label : labels) {
+        std::uint32_t labelSize = 0;
+        if (!readUint32(file, labelSize) || labelSize > remaining()) {
+            return fail("truncated labels");
+        }
+        label.resize(labelSize);
+        if (!file.read(label.data(), labelSize)) {
+            return fail("truncated labels");
+        }
+    }
+    std::uint32_t nodeCount = 0, edgeCount = 0;
+    std::vector<std::uint32_t> offsets, symbols, targets;
+    if (!readUint32(file, nodeCount) || !readUint32(file, edgeCount) ||
+        nodeCount == UINT32_MAX ||
+        !readUint32s(file, nodeCount + 1, remaining(), offsets) ||
+        !readUint32s(file, edgeCount, remaining(), symbols) ||
+        !readUint32s(file, edgeCount, remaining(), targets)) {
+        return fail("truncated transitions");
+    }
+    if (remaining() != 0) {
+        return fail("trailing data");
+    }
+
+    try {
+        dawg = SequenceDawg(length, std::move(labels), std::move(offsets), std::move(symbols),
+                            std::move(targets));
+    } catch (const std::invalid_argument& e) {
+        return fail(e.what());
+    }
+    return true;
+}
+
+std::vector<std::vector<Node>> genNodesFromConfig(const Config& config) {
+    std::vector<std::vector<Node>> forbiddenNodesList;
+    ForbiddenSetEnumerator enumerator(config);
+    while (enumerator.next()) {
+        forbiddenNodesList.push_back(enumerator.get());
+    }
+    return forbiddenNodesList;
+}
+
+namespace {
+
+// all-patterns モードの禁止語の候補と，語を選ぶ位相ごとの添字・current 内の開始位置を用意
+// (current は選ぶ語の総数の大きさにする)
+void layoutPhases(const Config& config, std::vector<std::string>& words,
+                  std::vector<unsigned int>& phases,
+                  std::vector<std::vector<unsigned int>>& indices, std::vector<size_t>& offsets,
+                  std::vector<Node>& current) {
+    words = combine(ALPHABET.substr(0, config.generation.alphabet),
+                    config.generation.forbidden.length, true);
     const auto& position = config.generation.forbidden.position;
 
     for (unsigned int p = 0; p < position.size(); ++p) {
@@ -144,59 +242,235 @@ std::vector<std::vector<std::vector<Node>>> genForbiddenList(const Config& confi
                 "forbidden.position value exceeds total combinations.");
         }
 
-        std::vector<Node> forbiddenNodes;
-        for (const auto& w : words) {
-            forbiddenNodes.emplace_back(w, p);
+        // 語を選ばない位相は直積に含めない
+        if (n > 0) {
+            phases.push_back(p);
+            indices.emplace_back(n);
+            offsets.push_back(current.size());
+            current.resize(current.size() + n);
         }
+    }
+}
 
-        // 組み合わせを生成
-        if (n > 0) {
-            forbiddenNodesList.emplace_back(n == words.size()
-                                        ? std::vector<std::vector<Node>>{forbiddenNodes}
-                                        : combine(forbiddenNodes, n, false));
+}  // namespace
+
+ForbiddenSetEnumerator::ForbiddenSetEnumerator(const Config& config) {
+    if (config.generation.mode == "custom") {
+        for (const auto& nodes : config.generation.forbidden.nodes) {
+            current.emplace_back(nodes.label, nodes.phase);
+        }
+        if (current.empty()) {
+            io::utils::printErrorAndExit("forbidden.nodes is empty.");
         }
+        return;
+    } else if (config.generation.mode != "all-patterns") {
+        io::utils::printErrorAndExit("Unknown mode '" + config.generation.mode + "'.");
     }
 
-    return forbiddenNodesList;
+    layoutPhases(config, words, phases, indices, offsets, current);
+}
+
+// 位相 phases[phaseIndex] の i 番目に選択中の語を current に反映
+void ForbiddenSetEnumerator::setSlot(size_t phaseIndex, size_t i) {
+    current[offsets[phaseIndex] + i] = Node(words[indices[phaseIndex][i]], phases[phaseIndex]);
 }
 
-std::vector<std::vector<Node>> combineNodes(
-    const std::vector<std::vector<std::vector<Node>>>& forbiddenList) {
-    std::vector<std::vector<Node>> combinedNodes;
-    std::function<void(unsigned int, std::vector<Node>)> dfs = [&](unsigned int depth,
-                                                                   std::vector<Node> current) {
-        if (depth == forbiddenList.size()) {
-            combinedNodes.push_back(current);
-            return;
+// 位相の組み合わせを辞書順で次へ進める (最後の組み合わせなら false)
+bool ForbiddenSetEnumerator::advance(size_t phaseIndex) {
+    auto& idx = indices[phaseIndex];
+    size_t changed = nextCombination(idx, words.size());
+    if (changed == COMBINATION_END) {
+        return false;
+    }
+    for (size_t i = changed; i < idx.size(); ++i) {
+        setSlot(phaseIndex, i);
+    }
+    return true;
+}
+
+// 位相の組み合わせを最初 (0, 1, ..., n-1) に戻す
+void ForbiddenSetEnumerator::reset(size_t phaseIndex) {
+    for (size_t i = 0; i < indices[phaseIndex].size(); ++i) {
+        indices[phaseIndex][i] = i;
+        setSlot(phaseIndex, i);
+    }
+}
+
+bool ForbiddenSetEnumerator::next() {
+    if (finished) {
+        return false;
+    }
+    if (held) {
+        held = false;
+        return true;
+    }
+    if (!started) {
+        started = true;
+        for (size_t k = 0; k < phases.size(); ++k) {
+            reset(k);
         }
-        for (const auto& nodes : forbiddenList[depth]) {
-            auto next = current;
-            next.insert(next.end(), nodes.begin(), nodes.end());
-            dfs(depth + 1, next);
+        return true;
+    }
+
+    // 最後の位相から桁上がりさせる
+    for (size_t k = phases.size(); k-- > 0;) {
+        if (advance(k)) {
+            return true;
         }
-    };
-    std::vector<Node> initial;
-    dfs(0, initial);
-    return combinedNodes;
+        reset(k);
+    }
+    finished = true;
+    return false;
 }
 
-std::vector<std::vector<Node>> genNodesFromConfig(const Config& config) {
-    if (config.generation.mode == "custom") {
-        std::vector<Node> forbiddenNodes;
-        for (const auto& nodes : config.generation.forbidden.nodes) {
-            forbiddenNodes.emplace_back(nodes.label, nodes.phase);
+// 禁止集合の総数
+std::uint64_t ForbiddenSetEnumerator::getCount() const {
+    std::uint64_t count = 1;
+    for (const auto& idx : indices) {
+        std::uint64_t radix = binomial(words.size(), idx.size());
+        if (radix != 0 && count > UINT64_MAX / radix) {
+            throw std::overflow_error("Number of forbidden sets exceeds 64 bits.");
         }
-        if (forbiddenNodes.empty()) {
-            io::utils::printErrorAndExit("forbidden.nodes is empty.");
+        count *= radix;
+    }
+    return count;
+}
+
+// 列挙順で index 番目の禁止集合へ移動
+void ForbiddenSetEnumerator::seek(std::uint64_t index) {
+    started = true;
+    if (index >= getCount()) {
+        finished = true;
+        held = false;
+        return;
+    }
+
+    // 最後の位相が最下位桁
+    for (size_t k = phases.size(); k-- > 0;) {
+        std::uint64_t radix = binomial(words.size(), indices[k].size());
+        indices[k] = unrankCombination(index % radix, words.size(), indices[k].size());
+        index /= radix;
+        for (size_t i = 0; i < indices[k].size(); ++i) {
+            setSlot(k, i);
         }
-        return {std::move(forbiddenNodes)};
-    } else if (config.generation.mode == "all-patterns") {
-        auto forbiddenNodesList = genForbiddenList(config);
-        return combineNodes(forbiddenNodesList);
-    } else {
-        io::utils::printErrorAndExit("Unknown mode '" + config.generation.mode + "'.");
     }
-    return {};
+    finished = false;
+    held = true;
+}
+
+MinimalChangeEnumerator::MinimalChangeEnumerator(const Config& config) {
+    if (config.generation.mode != "all-patterns") {
+        io::utils::printErrorAndExit("Minimal-change order requires all-patterns mode.");
+    }
+
+    layoutPhases(config, words, phases, indices, offsets, current);
+    for (const auto& idx : indices) {
+        radices.push_back(binomial(words.size(), idx.size()));
+    }
+    forward.assign(indices.size(), true);
+}
+
+// 位相 phases[phaseIndex] の選択中の語を current に反映し，previous からの差分を加える
+void MinimalChangeEnumerator::apply(size_t phaseIndex) {
+    const auto& idx = indices[phaseIndex];
+    const unsigned int phase = phases[phaseIndex];
+    for (size_t i = 0; i < idx.size(); ++i) {
+        current[offsets[phaseIndex] + i] = Node(words[idx[i]], phase);
+    }
+
+    // 昇順の添字の対称差
+    size_t i = 0, j = 0;
+    while (i < previous.size() || j < idx.size()) {
+        if (j == idx.size() || (i < previous.size() && previous[i] < idx[j])) {
+            removed.emplace_back(words[previous[i++]], phase);
+        } else if (i == previous.size() || idx[j] < previous[i]) {
+            added.emplace_back(words[idx[j++]], phase);
+        } else {
+            ++i;
+            ++j;
+        }
+    }
+}
+
+bool MinimalChangeEnumerator::next() {
+    if (finished) {
+        return false;
+    }
+    removed.clear();
+    added.clear();
+    changed = false;
+    if (held) {
+        held = false;
+        return true;
+    }
+    if (!started) {
+        started = true;
+        // 回転扉順の最初の組み合わせ (0, 1, ..., n-1)
+        for (size_t k = 0; k < phases.size(); ++k) {
+            std::iota(indices[k].begin(), indices[k].end(), 0u);
+            apply(k);
+        }
+        removed.clear();
+        added.clear();
+        return true;
+    }
+
+    // 進める向きに動ける最後の位相を1つ動かし，それより後の位相の向きを反転
+    // (位相内は回転扉順の前後の組み合わせへ1歩ずつ動かし，順位は使わない)
+    for (size_t k = phases.size(); k-- > 0;) {
+        auto& idx = indices[k];
+        previous.assign(idx.begin(), idx.end());
+        if (forward[k] ? nextRevolvingDoor(idx, words.size())
+                       : prevRevolvingDoor(idx, words.size())) {
+            for (size_t j = k + 1; j < phases.size(); ++j) {
+                forward[j] = !forward[j];
+            }
+            apply(k);
+            changed = true;
+            return true;
+        }
+    }
+    finished = true;
+    return false;
+}
+
+// 禁止集合の総数
+std::uint64_t MinimalChangeEnumerator::getCount() const {
+    std::uint64_t count = 1;
+    for (std::uint64_t radix : radices) {
+        if (radix != 0 && count > UINT64_MAX / radix) {
+            throw std::overflow_error("Number of forbidden sets exceeds 64 bits.");
+        }
+        count *= radix;
+    }
+    return count;
+}
+
+// 列挙順で position 番目の禁止集合へ移動
+// 位相 k 以降の部分の1周の長さを R_k とすると，位相 k は floor(position / R_k) が偶数なら順向き．
+void MinimalChangeEnumerator::seek(std::uint64_t position) {
+    started = true;
+    if (position >= getCount()) {
+        finished = true;
+        held = false;
+        return;
+    }
+
+    std::uint64_t block = getCount();  // R_k
+    for (size_t k = 0; k < phases.size(); ++k) {
+        const std::uint64_t sub = block / radices[k];  // R_{k+1}
+        forward[k] = (position / block) % 2 == 0;
+        const std::uint64_t digit = (position % block) / sub;
+        unrankRevolvingDoor(forward[k] ? digit : radices[k] - 1 - digit, words.size(),
+                            indices[k]);
+        apply(k);
+        block = sub;
+    }
+    removed.clear();
+    added.clear();
+    changed = false;
+    finished = false;
+    held = true;
 }
 
 }  // namespace io::input
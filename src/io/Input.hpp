@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include "Config.hpp"
+#include "algorithm/SequenceDawg.hpp"
 #include "core/Graph.hpp"
 #include "core/Node.hpp"
 
@@ -20,7 +22,89 @@ bool readEdgesCSV(const std::string& filePath, Graph& graph);
 // Adjacency Matrix関連
 bool readMatrixCSV(const std::string& filePath, Graph& graph);
 
+// 許可系列のDAWG (io::output::writeSeqDawg の形式)
+bool readSeqDawg(const std::string& filePath, SequenceDawg& dawg);
+
 // Configからノードリストを生成
 std::vector<std::vector<Node>> genNodesFromConfig(const Config& config);
 
+// Configの禁止集合を1つずつ列挙するイテレータ
+// all-patternsモードでは位相ごとに語の組み合わせを辞書順で選び，その直積を
+// 最後の位相が最も速く進む順 (genNodesFromConfig と同じ順) で列挙する．
+// 保持するのは位相ごとの選択中の添字と現在の禁止集合のみで，1回の更新は償却O(1)．
+class ForbiddenSetEnumerator {
+   public:
+    explicit ForbiddenSetEnumerator(const Config& config);
+
+    // 次の禁止集合へ進める (残っていなければ false)
+    bool next();
+
+    // 現在の禁止集合
+    const std::vector<Node>& get() const { return current; }
+
+    // 禁止集合の総数 (uint64 に収まらなければ std::overflow_error)
+    std::uint64_t getCount() const;
+
+    // 列挙順で index 番目の禁止集合へ移動し，次の next() でそれを返す
+    // 位相ごとの組み合わせの順位を混合基数で表し，組み合わせ数体系で逆ランク付けする．
+    void seek(std::uint64_t index);
+
+   private:
+    std::vector<std::string> words;                  // 禁止語の候補
+    std::vector<unsigned int> phases;                // 組み合わせを選ぶ位相
+    std::vector<std::vector<unsigned int>> indices;  // 位相ごとに選択中の語の添字 (昇順)
+    std::vector<size_t> offsets;                     // 位相ごとの current 内の開始位置
+    std::vector<Node> current;                       // 現在の禁止集合
+    bool started = false;
+    bool finished = false;
+    bool held = false;  // seek 直後 (next() で現在の集合を返す)
+
+    void setSlot(size_t phaseIndex, size_t i);
+    bool advance(size_t phaseIndex);
+    void reset(size_t phaseIndex);
+};
+
+// all-patternsモードの禁止集合を最小変化順に列挙するイテレータ
+// 位相ごとの組み合わせを回転扉順に，位相間の直積を反射混合基数グレイ符号の順に辿るため，
+// 隣り合う禁止集合は1つの位相で語を1つ入れ替えただけが異なる (取り除く語と加える語を返す)．
+// 集合の並び (get()) は ForbiddenSetEnumerator と同じく位相順・語の添字の昇順．
+class MinimalChangeEnumerator {
+   public:
+    explicit MinimalChangeEnumerator(const Config& config);
+
+    // 次の禁止集合へ進める (残っていなければ false)
+    bool next();
+
+    // 現在の禁止集合
+    const std::vector<Node>& get() const { return current; }
+
+    // 直前の禁止集合からの差分 (最初の集合と seek 直後は false)
+    bool hasChanges() const { return changed; }
+    const std::vector<Node>& getRemoved() const { return removed; }
+    const std::vector<Node>& getAdded() const { return added; }
+
+    // 禁止集合の総数 (uint64 に収まらなければ std::overflow_error)
+    std::uint64_t getCount() const;
+
+    // 列挙順で position 番目の禁止集合へ移動し，次の next() でそれを返す
+    void seek(std::uint64_t position);
+
+   private:
+    std::vector<std::string> words;                  // 禁止語の候補
+    std::vector<unsigned int> phases;                // 組み合わせを選ぶ位相
+    std::vector<std::vector<unsigned int>> indices;  // 位相ごとに選択中の語の添字 (昇順)
+    std::vector<std::uint64_t> radices;              // 位相ごとの組み合わせの数
+    std::vector<bool> forward;                       // 位相ごとの順位の進む向き
+    std::vector<size_t> offsets;                     // 位相ごとの current 内の開始位置
+    std::vector<Node> current;                       // 現在の禁止集合
+    std::vector<Node> removed, added;                // 直前からの差分
+    std::vector<unsigned int> previous;              // 差分計算用
+    bool started = false;
+    bool finished = false;
+    bool held = false;
+    bool changed = false;
+
+    void apply(size_t phaseIndex);
+};
+
 }  // namespace io::input
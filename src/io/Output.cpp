@@ -1,15 +1,26 @@
 #include "Output.hpp"
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <regex>
 #include <sstream>
 #include <stdexcept>
 
+#include "algorithm/SequenceDawg.hpp"
+#include "algorithm/SequenceEnumerator.hpp"
+#include "analysis/PathCounter.hpp"
 #include "io/utils.hpp"
 #include "path/utils.hpp"
+#include "utils/ThreadPool.hpp"
 
 #ifndef PYTHON_VENV_PATH
 #define PYTHON_VENV_PATH ""
@@ -31,7 +42,8 @@ bool write(const std::string& path, const std::string& data) {
     try {
         file << data;
     } catch (const std::exception& e) {
-        io::utils::printErrorAndExit("Error writing to file: " + path + " - " + e.what());
+        // ワーカースレッドからも呼ばれるので終了せずに投げる (ThreadPool::wait が再送出する)
+        throw std::runtime_error("Failed to write file: " + path + " - " + e.what());
     }
     return true;
 }
@@ -99,15 +111,244 @@ bool writeMatrixCsv(const std::string& filePath, const Graph& graph) {
     return writeCsv(filePath, data);
 }
 
-bool writeSeqCsv(const std::string& filePath, const Graph& graph, unsigned int length) {
-    auto sequences = graph.getEdgeLabelSequences(length);
-    CsvData data;
-    for (const auto& seq : sequences) {
-        data.push_back({seq});
+// 系列は集めずに辞書順に1行ずつ書き出す
+// 並列の場合は接頭辞で分けた区間をワーカーごとの SequenceEnumerator で列挙する．
+// 区間の出力は bufferBytes までメモリに溜め，超えた分は区間ごとの一時ファイルへ書き出す．
+// 呼び出し元のスレッドが先頭から完了した区間を順に (ロックの外で) 出力ファイルへ繋げる．
+// 辺ラベルの長さがそろっていないと区間を繋げても辞書順にならないので逐次に列挙する．
+bool writeSeqCsv(const std::string& filePath, const Graph& graph, unsigned int length,
+                 size_t threadCount, size_t bufferBytes) {
+    path::utils::genDir(filePath);
+    std::ofstream file(filePath);
+    if (!io::utils::checkFileOpen(file, filePath)) {
+        return false;
+    }
+    SequenceEnumerator enumerator(graph.getCsr());
+    if (threadCount <= 1 || !enumerator.hasUniformLabels()) {
+        enumerator.enumerate(length, [&](const std::string& word) { file << word << '\n'; });
+        return static_cast<bool>(file);
+    }
+
+    const auto prefixes = enumerator.genPrefixes(length, SEQ_SHARDS_PER_THREAD * threadCount);
+    auto genPartPath = [&](size_t i) { return filePath + ".part" + std::to_string(i); };
+    std::vector<std::unique_ptr<SequenceEnumerator>> enumerators;
+    for (size_t i = 0; i < threadCount; ++i) {
+        enumerators.push_back(std::make_unique<SequenceEnumerator>(graph.getCsr()));
+    }
+    std::vector<std::string> chunks(prefixes.size());  // メモリに残った区間の末尾
+    std::vector<bool> spilled(prefixes.size(), false);  // 一時ファイルに書き出したか
+    std::vector<bool> done(prefixes.size(), false);
+    std::mutex mutex;
+    std::condition_variable chunkDone;
+    std::exception_ptr error;
+
+    ThreadPool pool(threadCount);
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+        pool.submit([&, i](size_t worker) {
+            // 失敗しても完了扱いにして書き出し側の待機を止めない
+            std::string chunk;
+            bool hasPart = false;
+            std::exception_ptr failure;
+            try {
+                std::ofstream part;
+                enumerators[worker]->enumerate(
+                    length,
+                    [&](const std::string& word) {
+                        chunk += word;
+                        chunk += '\n';
+                        if (chunk.size() < bufferBytes) {
+                            return;
+                        }
+                        if (!hasPart) {
+                            part.open(genPartPath(i), std::ios::binary);
+                            hasPart = io::utils::checkFileOpen(part, genPartPath(i));
+                        }
+                        part << chunk;
+                        if (!part) {
+                            throw std::runtime_error("Failed to write file: " + genPartPath(i));
+                        }
+                        chunk.clear();
+                    },
+                    prefixes[i]);
+                if (hasPart && !part.flush()) {
+                    throw std::runtime_error("Failed to write file: " + genPartPath(i));
+                }
+            } catch (...) {
+                failure = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (failure && !error) {
+                error = failure;
+            }
+            chunks[i] = std::move(chunk);
+            spilled[i] = hasPart;
+            done[i] = true;
+            chunkDone.notify_all();
+        });
+    }
+
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+        std::string chunk;
+        bool fromPart = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            chunkDone.wait(lock, [&]() { return done[i] || error; });
+            if (error) {
+                break;
+            }
+            chunk = std::move(chunks[i]);
+            fromPart = spilled[i];
+        }
+        if (fromPart) {
+            {
+                std::ifstream part(genPartPath(i), std::ios::binary);
+                file << part.rdbuf();
+            }
+            std::error_code ignored;
+            std::filesystem::remove(genPartPath(i), ignored);
+        }
+        file << chunk;
+    }
+    pool.wait();
+    if (error) {
+        std::error_code ignored;
+        for (size_t i = 0; i < prefixes.size(); ++i) {
+            std::filesystem::remove(genPartPath(i), ignored);
+        }
+        std::rethrow_exception(error);
+    }
+    return static_cast<bool>(file);
+}
+
+// 32ビット符号なし整数をリトルエンディアンで書き出す
+void writeUint32(std::ostream& out, std::uint32_t value) {
+    const char bytes[4] = {static_cast<char>(value), static_cast<char>(value >> 8),
+                           static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+    out.write(bytes, sizeof(bytes));
+}
+
+void writeUint32s(std::ostream& out, const std::vector<std::uint32_t>& values) {
+    for (std::uint32_t value : values) {
+        writeUint32(out, value);
+    }
+}
+
+// 系列を列挙せずに決定化したオートマトンから最小のDAWGを作って書き出す
+bool writeSeqDawg(const std::string& filePath, const Graph& graph, unsigned int length) {
+    const auto dawg = SequenceDawg::build(graph.getCsr(), length);
+    path::utils::genDir(filePath);
+    std::ofstream file(filePath, std::ios::binary);
+    if (!io::utils::checkFileOpen(file, filePath)) {
+        return false;
     }
+    file.write(SEQ_DAWG_MAGIC, sizeof(SEQ_DAWG_MAGIC) - 1);
+    writeUint32(file, dawg.getLength());
+    writeUint32(file, static_cast<std::uint32_t>(dawg.getLabels().size()));
+    for (const auto& label : dawg.getLabels()) {
+        writeUint32(file, static_cast<std::uint32_t>(label.size()));
+        file.write(label.data(), static_cast<std::streamsize>(label.size()));
+    }
+    writeUint32(file, static_cast<std::uint32_t>(dawg.getNodeCount()));
+    writeUint32(file, static_cast<std::uint32_t>(dawg.getEdgeCount()));
+    writeUint32s(file, dawg.getOffsets());
+    writeUint32s(file, dawg.getSymbols());
+    writeUint32s(file, dawg.getTargets());
+    return static_cast<bool>(file);
+}
+
+bool writePathCountsCsv(const std::string& filePath, const Graph& graph, unsigned int length) {
+    PathCounter counter(graph.getCsr());
+    const auto counts = counter.countByPhase(length);
+    const unsigned int phases = counter.getPhaseCount();
+    std::vector<BigUint> startTotals(phases), endTotals(phases);
+    BigUint total;
+    CsvData data{{"start_phase", "end_phase", "count"}};
+    for (unsigned int s = 0; s < phases; ++s) {
+        for (unsigned int t = 0; t < phases; ++t) {
+            data.push_back({std::to_string(s), std::to_string(t), counts[s][t].toString()});
+            startTotals[s] += counts[s][t];
+            endTotals[t] += counts[s][t];
+            total += counts[s][t];
+        }
+    }
+    for (unsigned int s = 0; s < phases; ++s) {
+        data.push_back({std::to_string(s), "*", startTotals[s].toString()});
+    }
+    for (unsigned int t = 0; t < phases; ++t) {
+        data.push_back({"*", std::to_string(t), endTotals[t].toString()});
+    }
+    data.push_back({"*", "*", total.toString()});
     return writeCsv(filePath, data);
 }
 
+bool mergeShardFiles(const std::string& directory) {
+    // (name, N) -> 分割番号 -> パス
+    std::map<std::pair<std::string, unsigned int>, std::map<unsigned int, std::string>> groups;
+    const std::regex pattern(R"((.+)\.shard-(\d+)-of-(\d+)\.csv)");
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        std::smatch match;
+        const std::string fileName = entry.path().filename().string();
+        if (entry.is_regular_file() && std::regex_match(fileName, match, pattern)) {
+            groups[{match[1].str(), std::stoul(match[3].str())}][std::stoul(match[2].str())] =
+                entry.path().string();
+        }
+    }
+
+    bool success = true;
+    for (const auto& [group, shards] : groups) {
+        const auto& [name, shardCount] = group;
+        if (shards.size() != shardCount) {
+            std::cerr << "Missing shards of " << name << ": found " << shards.size() << " of "
+                      << shardCount << std::endl;
+            success = false;
+            continue;
+        }
+
+        std::string header;
+        std::vector<std::string> rows;
+        for (const auto& [shardIndex, shardPath] : shards) {
+            std::ifstream file(shardPath);
+            if (!io::utils::checkFileOpen(file, shardPath)) {
+                return false;
+            }
+            std::string line;
+            if (std::getline(file, line)) {
+                header = line;
+            }
+            while (std::getline(file, line)) {
+                if (!line.empty()) {
+                    rows.push_back(line);
+                }
+            }
+        }
+
+        if (header.rfind("index,", 0) == 0) {
+            std::map<std::uint64_t, std::string> ordered;
+            for (const auto& row : rows) {
+                ordered[std::stoull(row.substr(0, row.find(',')))] = row;
+            }
+            rows.clear();
+            for (auto& [index, row] : ordered) {
+                rows.push_back(std::move(row));
+            }
+        }
+
+        std::ostringstream oss;
+        oss << header << "\n";
+        for (const auto& row : rows) {
+            oss << row << "\n";
+        }
+        const std::string mergedPath = directory + "/" + name + ".csv";
+        if (!write(mergedPath, oss.str())) {
+            return false;
+        }
+        io::utils::logMessage("Merged " + std::to_string(shardCount) + " shards into " +
+                              mergedPath);
+    }
+    return success;
+}
+
 // Graphviz関連
 bool writeDot(const std::string& filePath, const Graph& graph) {
     const auto& nodes = graph.getNodes();
@@ -161,9 +402,11 @@ bool pdfToPNG(const std::string& pdfFilePath) {
 }
 
 bool writePdf(const std::string& filePath, const Graph& graph) {
-    const std::string tempDir = path::utils::extractPath(filePath, 0, true, false, false) + "/temp";
-    path::utils::genDir(tempDir);
+    // 一時ディレクトリはファイルごとに分ける (並列実行時に他の出力の一時ファイルを消さないため)
     const std::string basename = path::utils::extractPath(filePath, 0, false, true, false);
+    const std::string tempDir =
+        path::utils::extractPath(filePath, 0, true, false, false) + "/temp_" + basename;
+    std::filesystem::create_directories(tempDir);
 
     const std::string dotFilePath = tempDir + "/" + basename + ".dot";
     if (!writeDot(dotFilePath, graph)) {
@@ -184,7 +427,7 @@ bool writePdf(const std::string& filePath, const Graph& graph) {
     try {
         std::filesystem::rename(tempPdfPath, finalPdfPath);
     } catch (const std::filesystem::filesystem_error& e) {
-        io::utils::printErrorAndExit("Failed to rename file: " + std::string(e.what()));
+        throw std::runtime_error("Failed to rename file: " + std::string(e.what()));
     }
 
     std::filesystem::remove_all(tempDir);
@@ -193,9 +436,11 @@ bool writePdf(const std::string& filePath, const Graph& graph) {
 }
 
 bool writePng(const std::string& filePath, const Graph& graph) {
-    const std::string tempDir = path::utils::extractPath(filePath, 0, true, false, false) + "/temp";
-    path::utils::genDir(tempDir);
+    // 一時ディレクトリはファイルごとに分ける (並列実行時に他の出力の一時ファイルを消さないため)
     const std::string basename = path::utils::extractPath(filePath, 0, false, true, false);
+    const std::string tempDir =
+        path::utils::extractPath(filePath, 0, true, false, false) + "/temp_" + basename;
+    std::filesystem::create_directories(tempDir);
 
     const std::string tempPdfPath = tempDir + "/" + basename + ".pdf";
     if (!writePdf(tempPdfPath, graph)) {
@@ -211,7 +456,7 @@ bool writePng(const std::string& filePath, const Graph& graph) {
     try {
         std::filesystem::rename(tempPngPath, finalPngPath);
     } catch (const std::filesystem::filesystem_error& e) {
-        io::utils::printErrorAndExit("Failed to rename file: " + std::string(e.what()));
+        throw std::runtime_error("Failed to rename file: " + std::string(e.what()));
     }
 
     std::filesystem::remove_all(tempDir);
@@ -12,16 +12,37 @@ namespace io::output {
 using CsvData = std::vector<std::vector<std::string>>;
 using json = nlohmann::json;
 
+// 許可系列のDAWGのバイナリ形式 (整数はすべて32ビット符号なしのリトルエンディアン)
+// マジック "PFTDAWG1" (8バイト), L, ラベル数, 各ラベルのバイト数とバイト列, 節点数, 遷移数,
+// offsets (節点数 + 1 個), symbols (遷移数), targets (遷移数) の順 (SequenceDawg の配列と同じ)
+inline constexpr char SEQ_DAWG_MAGIC[] = "PFTDAWG1";
+
+// 許可系列を並列に列挙する場合のワーカーあたりの区間数と，区間ごとにメモリに溜めるバイト数
+// (超えた分は区間ごとの一時ファイル <出力ファイル>.part<番号> に書き出す)
+constexpr size_t SEQ_SHARDS_PER_THREAD = 16;
+constexpr size_t SEQ_BUFFER_BYTES = 1 << 20;
+
 // CSV関連
 bool writeEdgesCsv(const std::string& filePath, const Graph& graph);
 bool writeMatrixCsv(const std::string& filePath, const Graph& graph);
-bool writeSeqCsv(const std::string& filePath, const Graph& graph, unsigned int length);
+// 長さLの許可系列を辞書順に出力 (threadCount > 1 なら接頭辞で分けて並列に列挙)
+bool writeSeqCsv(const std::string& filePath, const Graph& graph, unsigned int length,
+                 size_t threadCount = 1, size_t bufferBytes = SEQ_BUFFER_BYTES);
+// 長さLの許可系列を最小のDAWGとしてバイナリ形式で出力 (辺ラベルの長さがそろっていること)
+bool writeSeqDawg(const std::string& filePath, const Graph& graph, unsigned int length);
+// 長さLの経路数を始点・終点の位相ごとに出力 (* はその位相について合計した行)
+bool writePathCountsCsv(const std::string& filePath, const Graph& graph, unsigned int length);
 
 // Graphviz関連
 bool writeDot(const std::string& filePath, const Graph& graph);
 bool writePdf(const std::string& filePath, const Graph& graph);
 bool writePng(const std::string& filePath, const Graph& graph);
 
+// 分割実行の集計ファイル <name>.shard-<i>-of-<N>.csv をまとめて <name>.csv を作成
+// ヘッダーは1度だけ出力し，先頭列が index の場合は番号順に並べる (同じ番号は後のものを使う)．
+// すべての分割がそろっていない集計ファイルがあれば false
+bool mergeShardFiles(const std::string& directory);
+
 template <typename PathGen, typename WriteFunc>
 bool writeGraph(const std::string& type, const std::string& ext, const PathGen& pathGen,
                 WriteFunc writeFunc, const Graph& graph) {
@@ -0,0 +1,145 @@
+#include "ResultCache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "core/CsrGraph.hpp"
+#include "io/utils.hpp"
+#include "nlohmann/json.hpp"
+
+namespace io {
+
+using json = nlohmann::json;
+
+ResultCache::ResultCache(const std::string& directory) : directory(directory) {}
+
+// キャッシュキーを生成
+std::string ResultCache::genKey(const io::type::Config& config, const EigenOptions& eigenOptions,
+                                const std::vector<Node>& forbiddenNodes) {
+    const auto& generation = config.generation;
+
+    std::vector<Node> sorted(forbiddenNodes);
+    std::sort(sorted.begin(), sorted.end(), [](const Node& a, const Node& b) {
+        return a.getPhase() != b.getPhase() ? a.getPhase() < b.getPhase()
+                                            : a.getLabel() < b.getLabel();
+    });
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::ostringstream key;
+    key << "algorithm=" << generation.algorithm << ";alphabet=" << generation.alphabet
+        << ";period=" << generation.period;
+    // De Bruijnグラフのノード集合は語長で決まる
+    if (generation.algorithm == "DeBruijn") {
+        key << ";length=" << generation.forbidden.length;
+    }
+    // 保存する最大固有値は許容誤差と反復回数の上限で変わる
+    key << ";opt_mode=" << generation.opt_mode
+        << ";eig_tol=" << std::setprecision(std::numeric_limits<double>::max_digits10)
+        << eigenOptions.tolerance << ";eig_max_iter=" << eigenOptions.maxIterations
+        << ";forbidden=";
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i > 0) {
+            key << ",";
+        }
+        key << sorted[i].getLabel() << ":" << sorted[i].getPhase();
+    }
+    return key.str();
+}
+
+// キーのハッシュ (FNV-1a 64bit)
+std::uint64_t ResultCache::hashKey(const std::string& key) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string ResultCache::genPath(const std::string& key) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hashKey(key);
+    const std::string hash = name.str();
+    return directory + "/" + hash.substr(0, 2) + "/" + hash + ".json";
+}
+
+// キャッシュを読み込む
+bool ResultCache::load(const std::string& key, Entry& entry) const {
+    const std::string path = genPath(key);
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    try {
+        json data;
+        file >> data;
+        if (data.at("key").get<std::string>() != key) {
+            return false;  // ハッシュの衝突
+        }
+
+        const auto& graph = data.at("graph");
+        CsrGraph csr;
+        for (const auto& symbol : graph.at("symbols")) {
+            csr.addSymbol(symbol.get<std::string>());
+        }
+        const auto& nodes = graph.at("nodes");
+        const auto& edges = graph.at("edges");
+        csr.reserve(nodes.size(), edges.size());
+        for (const auto& node : nodes) {
+            csr.addNode(node.at(0).get<std::string>(), node.at(1).get<unsigned int>());
+        }
+        for (const auto& edge : edges) {
+            auto source = edge.at(0).get<CsrGraph::Id>();
+            auto target = edge.at(1).get<CsrGraph::Id>();
+            auto symbol = edge.at(2).get<CsrGraph::Id>();
+            if (source >= csr.getNodeCount() || target >= csr.getNodeCount() ||
+                symbol >= csr.getSymbolCount()) {
+                return false;
+            }
+            csr.addEdge(source, target, symbol);
+        }
+
+        entry.graph = Graph(std::move(csr));
+        entry.maxEigenvalue.reset();
+        if (data.contains("max_eig") && !data.at("max_eig").is_null()) {
+            entry.maxEigenvalue = data.at("max_eig").get<double>();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Ignoring broken cache entry: " << path << " - " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// キャッシュに保存
+bool ResultCache::store(const std::string& key, const Entry& entry) const {
+    const auto& csr = entry.graph.getCsr();
+
+    json symbols = json::array();
+    for (CsrGraph::Id s = 0; s < csr.getSymbolCount(); ++s) {
+        symbols.push_back(csr.getSymbol(s));
+    }
+    json nodes = json::array();
+    for (CsrGraph::Id v = 0; v < csr.getNodeCount(); ++v) {
+        nodes.push_back({csr.getLabel(v), csr.getPhase(v)});
+    }
+    json edges = json::array();
+    for (size_t e = 0; e < csr.getEdgeCount(); ++e) {
+        edges.push_back({csr.getEdgeSource(e), csr.getEdgeTarget(e), csr.getEdgeSymbol(e)});
+    }
+
+    json data;
+    data["key"] = key;
+    data["graph"] = {{"symbols", symbols}, {"nodes", nodes}, {"edges", edges}};
+    data["max_eig"] = entry.maxEigenvalue ? json(*entry.maxEigenvalue) : json(nullptr);
+
+    // 一時ファイルに書いてから置き換える (同じキーを並列に書いても壊れない)
+    return io::utils::writeFileAtomically(genPath(key),
+                                          [&](std::ostream& file) { file << data.dump(); });
+}
+
+}  // namespace io
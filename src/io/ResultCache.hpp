@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Config.hpp"
+#include "analysis/eigenvalues.hpp"
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+
+namespace io {
+
+// 生成したグラフと最大固有値のディスクキャッシュ
+// キーは (アルゴリズム, アルファベット, 周期, 語長, 最適化モード, 固有値計算の許容誤差と
+// 最大反復回数, 整列した禁止集合) の正規形で，
+// そのFNV-1aハッシュをファイル名とする <directory>/<先頭2桁>/<ハッシュ>.json に保存する．
+// ファイルにはキー自体も保存し，読み込み時に照合してハッシュの衝突を検出する．
+class ResultCache {
+   public:
+    struct Entry {
+        Graph graph;                          // 生成 (・刈り込み・最小化) 後のグラフ
+        std::optional<double> maxEigenvalue;  // 最大固有値 (未計算なら空)
+    };
+
+    explicit ResultCache(const std::string& directory);
+
+    // キャッシュキーを生成
+    static std::string genKey(const io::type::Config& config, const EigenOptions& eigenOptions,
+                              const std::vector<Node>& forbiddenNodes);
+
+    // キーのハッシュ (FNV-1a 64bit)
+    static std::uint64_t hashKey(const std::string& key);
+
+    // キャッシュを読み込む (存在しない・壊れている・衝突した場合は false)
+    bool load(const std::string& key, Entry& entry) const;
+
+    // キャッシュに保存 (一時ファイルに書いてから置き換えるので並列に呼んでもよい)
+    bool store(const std::string& key, const Entry& entry) const;
+
+   private:
+    std::string directory;
+
+    std::string genPath(const std::string& key) const;
+};
+
+}  // namespace io
@@ -0,0 +1,86 @@
+#include "SweepSummary.hpp"
+
+#include <filesystem>
+#include <map>
+#include <sstream>
+
+#include "analysis/CapacityWindow.hpp"
+#include "io/utils.hpp"
+#include "path/Generator.hpp"
+
+namespace io {
+
+namespace {
+
+const std::string HEADER = "index,forbidden_set,nodes,edges,max_eig,capacity,pruned";
+
+}  // namespace
+
+SweepSummary::SweepSummary(const std::string& path) : path(path) {}
+
+// 開く
+void SweepSummary::open(const std::function<bool(std::uint64_t)>& keep) {
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+    // 再開時は完了済みの行だけを残す (同じ番号の行は最後のものを使う)
+    std::map<std::uint64_t, std::string> rows;
+    if (keep) {
+        std::ifstream existing(path);
+        std::string line;
+        while (std::getline(existing, line)) {
+            if (line.empty() || line == HEADER) {
+                continue;
+            }
+            try {
+                std::uint64_t index = std::stoull(line.substr(0, line.find(',')));
+                if (keep(index)) {
+                    rows[index] = line;
+                }
+            } catch (const std::exception&) {
+                // 書き込み途中の行は捨てる
+            }
+        }
+    }
+
+    file.open(path, std::ios::trunc);
+    if (!io::utils::checkFileOpen(file, path)) {
+        io::utils::printErrorAndExit("Failed to open summary: " + path);
+    }
+    file << HEADER << "\n";
+    for (const auto& [index, line] : rows) {
+        file << line << "\n";
+    }
+    file.flush();
+}
+
+// 1行書き込む
+void SweepSummary::write(std::uint64_t index, const std::vector<Node>& forbiddenNodes,
+                         const Graph& graph, const std::optional<double>& maxEigenvalue) {
+    const auto& csr = graph.getCsr();
+    std::ostringstream line;
+    line << index << "," << path::genBaseName(forbiddenNodes) << "," << csr.getNodeCount() << ","
+         << csr.getEdgeCount() << ",";
+    line.precision(12);
+    if (maxEigenvalue) {
+        line << *maxEigenvalue;
+    }
+    line << ",";
+    if (maxEigenvalue) {
+        line << CapacityWindow::calcCapacity(*maxEigenvalue);
+    }
+    line << ",0";
+    writeLine(line.str());
+}
+
+// 生成を省いた禁止集合の行を書き込む
+void SweepSummary::writePruned(std::uint64_t index, const std::vector<Node>& forbiddenNodes) {
+    writeLine(std::to_string(index) + "," + path::genBaseName(forbiddenNodes) + ",,,0,0,1");
+}
+
+void SweepSummary::writeLine(const std::string& line) {
+    std::lock_guard<std::mutex> lock(mutex);
+    file << line << "\n";
+    file.flush();  // 中断されても完了済みの行が残るようにする
+}
+
+}  // namespace io
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/Graph.hpp"
+#include "core/Node.hpp"
+
+namespace io {
+
+// all-patternsモードの集計 (summary.csv)
+// 列: index (列挙順の番号), forbidden_set, nodes, edges, max_eig (未計算なら空),
+//     capacity (CapacityWindow::calcCapacity(max_eig)，未計算なら空),
+//     pruned (容量0の集合を含むため生成を省いたなら1)
+// 行は処理が完了した順に追記する．
+class SweepSummary {
+   public:
+    explicit SweepSummary(const std::string& path);
+
+    // 開く (keep を指定すると既存の行のうち keep(index) が真のものだけを残して追記する)
+    void open(const std::function<bool(std::uint64_t)>& keep = nullptr);
+
+    // 1行書き込む (スレッドセーフ)
+    void write(std::uint64_t index, const std::vector<Node>& forbiddenNodes, const Graph& graph,
+               const std::optional<double>& maxEigenvalue);
+
+    // 生成を省いた禁止集合の行を書き込む (ノード数・エッジ数は空，最大固有値と容量は0)
+    void writePruned(std::uint64_t index, const std::vector<Node>& forbiddenNodes);
+
+    const std::string& getPath() const { return path; }
+
+   private:
+    std::string path;
+    std::ofstream file;
+    std::mutex mutex;
+
+    void writeLine(const std::string& line);
+};
+
+}  // namespace io
@@ -0,0 +1,206 @@
+#include "ZeroCapacitySets.hpp"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "io/utils.hpp"
+#include "path/Generator.hpp"
+
+namespace io {
+
+namespace {
+
+// a が b の部分集合か
+bool isSubset(const std::vector<std::uint64_t>& a, const std::vector<std::uint64_t>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] & ~(i < b.size() ? b[i] : 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string genItem(const Node& node) {
+    return node.getLabel() + ":" + std::to_string(node.getPhase());
+}
+
+// ファイルの排他ロック (flock) を持つ間だけ他のプロセスを待たせる
+class FileLock {
+   public:
+    explicit FileLock(const std::string& path) : fd(::open(path.c_str(), O_RDWR | O_CREAT, 0644)) {
+        while (fd >= 0 && ::flock(fd, LOCK_EX) != 0) {
+            if (errno != EINTR) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    }
+    ~FileLock() {
+        if (fd >= 0) {
+            ::close(fd);  // ロックも解放される
+        }
+    }
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    bool isLocked() const { return fd >= 0; }
+
+   private:
+    int fd;
+};
+
+}  // namespace
+
+ZeroCapacitySets::ZeroCapacitySets(const std::string& path) : path(path) {}
+
+// ファイルから読み込む
+bool ZeroCapacitySets::load() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return readLocked();
+}
+
+// ファイルの集合を極小性を保って取り込む
+bool ZeroCapacitySets::readLocked() {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::vector<Node> nodes;
+        std::istringstream items(line);
+        std::string item;
+        while (std::getline(items, item, '-')) {
+            auto colon = item.find(':');
+            if (colon == std::string::npos) {
+                nodes.clear();
+                break;
+            }
+            try {
+                nodes.emplace_back(item.substr(0, colon), std::stoul(item.substr(colon + 1)));
+            } catch (const std::exception&) {
+                nodes.clear();
+                break;
+            }
+        }
+        if (nodes.empty()) {
+            io::utils::logMessage("Ignoring broken line in " + path + ": " + line);
+            continue;
+        }
+        addLocked(nodes, line);
+    }
+    return true;
+}
+
+// 禁止集合をビット集合に変換 (insert なら未知の語に新しいビットを割り当てる)
+ZeroCapacitySets::Bits ZeroCapacitySets::toBits(const std::vector<Node>& forbiddenNodes,
+                                                bool insert) {
+    if (insert) {
+        for (const auto& node : forbiddenNodes) {
+            toItem.emplace(genItem(node), toItem.size());
+        }
+    }
+    return static_cast<const ZeroCapacitySets*>(this)->toBits(forbiddenNodes);
+}
+
+// 禁止集合をビット集合に変換 (未知の語はどの記録にも含まれないので無視する)
+ZeroCapacitySets::Bits ZeroCapacitySets::toBits(const std::vector<Node>& forbiddenNodes) const {
+    Bits bits((toItem.size() + 63) / 64, 0);
+    for (const auto& node : forbiddenNodes) {
+        auto it = toItem.find(genItem(node));
+        if (it != toItem.end()) {
+            bits[it->second / 64] |= std::uint64_t{1} << (it->second % 64);
+        }
+    }
+    return bits;
+}
+
+// 記録した集合のいずれかを含むか
+bool ZeroCapacitySets::containsSubsetOf(const std::vector<Node>& forbiddenNodes) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (sets.empty()) {
+        return false;
+    }
+    const Bits bits = toBits(forbiddenNodes);
+    for (const auto& set : sets) {
+        if (isSubset(set, bits)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 極小性を保って追加
+bool ZeroCapacitySets::addLocked(const std::vector<Node>& forbiddenNodes,
+                                 const std::string& name) {
+    const Bits bits = toBits(forbiddenNodes, true);
+    for (const auto& set : sets) {
+        if (isSubset(set, bits)) {
+            return false;
+        }
+    }
+
+    // 追加する集合を含む記録を取り除く
+    size_t kept = 0;
+    for (size_t i = 0; i < sets.size(); ++i) {
+        if (!isSubset(bits, sets[i])) {
+            if (kept != i) {
+                sets[kept] = std::move(sets[i]);
+                names[kept] = std::move(names[i]);
+            }
+            ++kept;
+        }
+    }
+    sets.resize(kept);
+    names.resize(kept);
+
+    sets.push_back(bits);
+    names.push_back(name);
+    return true;
+}
+
+// 追加して保存
+bool ZeroCapacitySets::add(const std::vector<Node>& forbiddenNodes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!addLocked(forbiddenNodes, path::genBaseName(forbiddenNodes))) {
+        return false;
+    }
+    if (!save()) {
+        io::utils::logMessage("Failed to save zero-capacity sets: " + path);
+    }
+    return true;
+}
+
+size_t ZeroCapacitySets::getCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sets.size();
+}
+
+// ロックファイルで他のプロセスと排他し，ファイルを読み直して他のプロセスが記録した集合を
+// 取り込んでから，一時ファイルに書いて置き換える
+bool ZeroCapacitySets::save() {
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+    FileLock fileLock(path + ".lock");
+    if (!fileLock.isLocked()) {
+        return false;
+    }
+    readLocked();
+    return io::utils::writeFileAtomically(path, [&](std::ostream& file) {
+        for (const auto& name : names) {
+            file << name << "\n";
+        }
+    });
+}
+
+}  // namespace io
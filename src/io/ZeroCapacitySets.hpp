@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/Node.hpp"
+
+namespace io {
+
+// 容量0 (刈り込むと空になる) の禁止集合のうち極小のものの記録
+// 禁止語を加えるとシフト空間は縮むだけなので，記録した集合を含む禁止集合も容量0になる．
+// all-patternsの1回の実行では位相ごとの語数が同じで包含関係が生じないため，
+// 同じ (アルファベット, 周期, 語長) の実行の間でファイルを共有して語数の多い実行の枝刈りに使う．
+// ファイルは1行に1つの禁止集合 (出力ファイル名と同じ "語:位相-語:位相..." 形式)．
+// 保存のたびにロックファイル (<ファイル>.lock) で排他してファイルを読み直し，並列に実行している
+// 他のプロセスが記録した集合と合わせて書き出す．
+class ZeroCapacitySets {
+   public:
+    explicit ZeroCapacitySets(const std::string& path);
+
+    // ファイルから読み込む (存在しなければ false)
+    bool load();
+
+    // 記録した集合のいずれかを含むか (スレッドセーフ)
+    bool containsSubsetOf(const std::vector<Node>& forbiddenNodes) const;
+
+    // 極小性を保って追加し保存 (記録済みの集合を含むなら追加せず false，スレッドセーフ)
+    // 追加した集合を含む記録済みの集合は取り除く．
+    bool add(const std::vector<Node>& forbiddenNodes);
+
+    // 記録した集合の数
+    size_t getCount() const;
+
+    const std::string& getPath() const { return path; }
+
+   private:
+    using Bits = std::vector<std::uint64_t>;
+
+    std::string path;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, size_t> toItem;  // "語:位相" -> ビット位置
+    std::vector<Bits> sets;                          // 記録した集合 (ビット集合)
+    std::vector<std::string> names;                  // 記録した集合 (ファイルの行)
+
+    Bits toBits(const std::vector<Node>& forbiddenNodes, bool insert);
+    Bits toBits(const std::vector<Node>& forbiddenNodes) const;
+    bool addLocked(const std::vector<Node>& forbiddenNodes, const std::string& name);
+    bool readLocked();
+    bool save();
+};
+
+}  // namespace io
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <cstdlib>  // for exit
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <random>
 #include <string>
 #include <type_traits>
 
@@ -36,6 +41,47 @@ bool checkFileOpen(Stream& file, const std::string& path) {
     return true;
 }
 
+/**
+ * @brief 一時ファイルに書いてから置き換える
+ *
+ * 読み手が書きかけのファイルを見ることはない．一時ファイル名は乱数と通し番号を含むので，
+ * 同じパスへ並列に書く他のスレッドやプロセスとも重ならない (最後に置き換えた内容が残る)．
+ *
+ * @param path 書き込むファイルのパス (親ディレクトリがなければ作成する)
+ * @param write 一時ファイルのストリームに内容を書き込む関数
+ * @return true 置き換えた場合
+ * @return false 書き込みか置き換えに失敗した場合 (一時ファイルは削除する)
+ */
+inline bool writeFileAtomically(const std::string& path,
+                                const std::function<void(std::ostream&)>& write) {
+    static const unsigned int salt = std::random_device{}();
+    static std::atomic<unsigned long> counter{0};
+    const std::string tempPath =
+        path + ".tmp" + std::to_string(salt) + "-" + std::to_string(counter++);
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+    bool written = false;
+    {
+        std::ofstream file(tempPath);
+        if (!checkFileOpen(file, tempPath)) {
+            return false;
+        }
+        write(file);
+        file.flush();
+        written = static_cast<bool>(file);
+    }
+    if (written) {
+        std::filesystem::rename(tempPath, path, error);
+        if (!error) {
+            return true;
+        }
+        std::cerr << "Failed to replace " << path << ": " << error.message() << std::endl;
+    }
+    std::filesystem::remove(tempPath, error);
+    return false;
+}
+
 /**
  * @brief エラーメッセージを出力し、プログラムを終了する
  *
@@ -53,6 +99,8 @@ inline void printErrorAndExit(const std::string& message) {
  * @param message 出力するログメッセージ
  */
 inline void logMessage(const std::string& message) {
+    static std::mutex mutex;  // 複数スレッドからの出力が行の途中で混ざらないようにする
+    std::lock_guard<std::mutex> lock(mutex);
     std::cout << "[INFO] " << message << std::endl;
 }
 
@@ -1,19 +1,396 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>  // std::unique_ptr
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "algorithm/GeneratorFactory.hpp"
+#include "algorithm/IncrementalDeBruijn.hpp"
 #include "algorithm/Moore.hpp"
+#include "algorithm/SequenceCoder.hpp"
+#include "algorithm/SequenceDawg.hpp"
+#include "analysis/CapacitySearch.hpp"
+#include "analysis/CapacityWindow.hpp"
+#include "analysis/PerronBatch.hpp"
 #include "analysis/eigenvalues.hpp"
 #include "cli/Parser.hpp"
 #include "core/Graph.hpp"
+#include "core/constants.hpp"
+#include "io/Checkpoint.hpp"
 #include "io/Config.hpp"
 #include "io/Input.hpp"
 #include "io/Output.hpp"
+#include "io/ResultCache.hpp"
+#include "io/SweepSummary.hpp"
+#include "io/ZeroCapacitySets.hpp"
 #include "io/utils.hpp"
 #include "path/Generator.hpp"
 #include "path/utils.hpp"
 #include "utils/GraphUtils.hpp"
+#include "utils/SymmetryGroup.hpp"
+#include "utils/ThreadPool.hpp"
+
+namespace {
+
+// 対称性による禁止集合の削減
+// 軌道の代表元のみを通し，各禁止集合から代表元への対応を symmetry.csv に，
+// 代表元ごとの軌道の大きさを orbits.csv に書き出す．
+class SymmetryFilter {
+   public:
+    SymmetryFilter(const io::type::Config& config, unsigned int shardIndex, unsigned int shardCount)
+        : group(config.generation.alphabet, config.generation.forbidden.length,
+                config.generation.forbidden.position),
+          alphabet(ALPHABET.substr(0, config.generation.alphabet)) {
+        const std::string baseDir = path::genBaseDir(config);
+        mappingPath = path::genSweepFilePath(config, "symmetry", "csv", shardIndex, shardCount);
+        orbitPath = path::genSweepFilePath(config, "orbits", "csv", shardIndex, shardCount);
+        path::utils::genDir(mappingPath);
+        mappingFile.open(mappingPath);
+        orbitFile.open(orbitPath);
+        if (!io::utils::checkFileOpen(mappingFile, mappingPath) ||
+            !io::utils::checkFileOpen(orbitFile, orbitPath)) {
+            io::utils::printErrorAndExit("Failed to open symmetry output files in: " + baseDir);
+        }
+        mappingFile << "member,representative,transform,orbit_size\n";
+        orbitFile << "representative,orbit_size\n";
+        io::utils::logMessage("Symmetry group order: " + std::to_string(group.getOrder()));
+    }
+
+    // 代表元なら true
+    bool accept(const std::vector<Node>& forbiddenNodes) {
+        size_t transform, orbitSize;
+        auto representative = group.canonicalize(forbiddenNodes, transform, orbitSize);
+        const std::string member = path::genBaseName(forbiddenNodes);
+        const std::string repName = path::genBaseName(representative);
+        mappingFile << member << "," << repName << ","
+                    << group.getTransforms()[transform].toString(alphabet) << "," << orbitSize
+                    << "\n";
+
+        ++total;
+        if (representative != forbiddenNodes) {
+            return false;
+        }
+        ++representatives;
+        orbitFile << repName << "," << orbitSize << "\n";
+        io::utils::logMessage(repName + ": orbit size = " + std::to_string(orbitSize));
+        return true;
+    }
+
+    void report() {
+        mappingFile.flush();
+        orbitFile.flush();
+        io::utils::logMessage("Symmetry reduction: " + std::to_string(representatives) + " of " +
+                              std::to_string(total) + " forbidden sets generated.");
+        io::utils::logMessage("Saved symmetry mapping to " + mappingPath);
+    }
+
+   private:
+    SymmetryGroup group;
+    std::string alphabet;
+    std::string mappingPath, orbitPath;
+    std::ofstream mappingFile, orbitFile;
+    size_t total = 0;
+    size_t representatives = 0;
+};
+
+// スイープ全体で共有する設定と出力先
+struct SweepContext {
+    const io::type::Config& config;
+    const CLI::Parser::ParsedOptions& options;
+    const io::ResultCache* cache;         // キャッシュなしなら nullptr
+    io::SweepSummary* summary;            // 集計なしなら nullptr
+    io::ZeroCapacitySets* zeroCapacity;   // 枝刈りなしなら nullptr
+    const CapacityWindow* window;         // 容量の範囲の指定なしなら nullptr
+};
+
+// まとめて処理する禁止集合 (列挙順の番号, 禁止集合)
+using ForbiddenSetBatch = std::vector<std::pair<std::uint64_t, std::vector<Node>>>;
+
+// 生成したグラフのシフト空間が空か (刈り込んでいないグラフは刈り込んで判定)
+bool isZeroCapacity(const io::type::Config& config, const Graph& graph) {
+    if (config.generation.opt_mode == "none") {
+        return cleanGraph(graph).getCsr().getNodeCount() == 0;
+    }
+    return graph.getCsr().getNodeCount() == 0;
+}
+
+}  // namespace
+
+// 最適化モードに応じてグラフを生成
+Graph generateGraph(const io::type::Config& config, const GraphGenerator& generator,
+                    const std::vector<Node>& forbiddenNodes) {
+    if (config.generation.opt_mode == "sink_less") {
+        io::utils::logMessage("Applying sink-less mode.");
+        return generator.generateTrimmed(forbiddenNodes);
+    } else if (config.generation.opt_mode == "minimize") {
+        io::utils::logMessage("Applying minimize mode.");
+        return Moore::apply(generator.generateTrimmed(forbiddenNodes));
+    } else if (config.generation.opt_mode == "scc") {
+        io::utils::logMessage("Applying SCC mode.");
+        return cleanGraph(generator.generateTrimmed(forbiddenNodes), CleanMode::Scc);
+    }
+    return generator.generate(forbiddenNodes);
+}
+
+// 1つの禁止集合のグラフと最大固有値 (キャッシュから読み込んだものを含む)
+struct ForbiddenSetResult {
+    io::ResultCache::Entry entry;
+    std::string cacheKey;
+    bool updated = false;  // キャッシュに保存し直すか
+    CapacityWindow::Decision window = CapacityWindow::Decision::Inside;  // 容量の範囲の判定
+};
+
+// キャッシュを参照し，なければ generate でグラフを生成
+ForbiddenSetResult loadForbiddenSet(const SweepContext& context,
+                                    const std::vector<Node>& forbiddenNodes,
+                                    const std::function<Graph()>& generate) {
+    ForbiddenSetResult result;
+    bool cached = false;
+    if (context.cache) {
+        const EigenOptions eigenOptions{context.options.eigTolerance,
+                                        context.options.eigMaxIterations};
+        result.cacheKey = io::ResultCache::genKey(context.config, eigenOptions, forbiddenNodes);
+        cached = context.cache->load(result.cacheKey, result.entry);
+    }
+
+    if (cached) {
+        io::utils::logMessage("Loaded graph from cache.");
+    } else {
+        result.entry.graph = generate();
+    }
+    result.updated = !cached;
+    return result;
+}
+
+// 容量の範囲を最大固有値 (キャッシュにあれば) か安い上下界で判定し，最大固有値を求める必要があれば true
+bool classifyForbiddenSet(const SweepContext& context, ForbiddenSetResult& result) {
+    const auto& entry = result.entry;
+    if (context.window) {
+        result.window = entry.maxEigenvalue ? context.window->classify(*entry.maxEigenvalue)
+                                            : context.window->classify(entry.graph);
+    }
+    return !entry.maxEigenvalue &&
+           (context.options.maxEig || result.window == CapacityWindow::Decision::Unknown);
+}
+
+// 最大固有値を求めて (未計算なら calcMaxEigenvalue) キャッシュ・集計・ファイルに出力
+// index は列挙順の番号 (集計の行に使う)．容量の範囲外なら集計とファイルには出力しない．
+// result は classifyForbiddenSet で判定済みとする．
+void saveForbiddenSet(const SweepContext& context, std::uint64_t index,
+                      const std::vector<Node>& forbiddenNodes, ForbiddenSetResult& result,
+                      const std::function<double(const Graph&)>& calcMaxEigenvalue) {
+    const auto& config = context.config;
+    const auto& options = context.options;
+    const io::ResultCache* cache = context.cache;
+    auto& entry = result.entry;
+    const Graph& graph = entry.graph;
+
+    if (!entry.maxEigenvalue &&
+        (options.maxEig || result.window == CapacityWindow::Decision::Unknown)) {
+        entry.maxEigenvalue = calcMaxEigenvalue(graph);
+        result.updated = true;
+    }
+    if (options.maxEig) {
+        io::utils::logMessage(path::genBaseName(forbiddenNodes) + ": Max Eigenvalue = " +
+                              std::to_string(*entry.maxEigenvalue));
+    }
+    if (result.window == CapacityWindow::Decision::Unknown) {
+        result.window = context.window->classify(*entry.maxEigenvalue);
+    }
+
+    if (cache && result.updated && !cache->store(result.cacheKey, entry)) {
+        io::utils::logMessage("Failed to update cache for " + path::genBaseName(forbiddenNodes));
+    }
+
+    if (context.zeroCapacity && isZeroCapacity(config, graph) &&
+        context.zeroCapacity->add(forbiddenNodes)) {
+        io::utils::logMessage(path::genBaseName(forbiddenNodes) +
+                              ": zero capacity, recorded for pruning.");
+    }
+
+    if (result.window == CapacityWindow::Decision::Outside) {
+        io::utils::logMessage(path::genBaseName(forbiddenNodes) +
+                              ": outside the capacity window, skipped.");
+        return;
+    }
+
+    if (context.summary) {
+        context.summary->write(index, forbiddenNodes, graph, entry.maxEigenvalue);
+    }
+
+    path::Generator pathGenerator(config, forbiddenNodes);
+
+    auto generateFilePath = [&](const std::string& type, const std::string& ext) {
+        return pathGenerator.genFilePath(type, ext);
+    };
+
+    if (config.output.edge_list) {
+        if (io::output::writeGraph("edges", "csv", generateFilePath, io::output::writeEdgesCsv,
+                                   graph)) {
+            io::utils::logMessage("Saved edge list to CSV.");
+        }
+    }
+
+    if (config.output.png_file) {
+        if (io::output::writeGraph("graph", "png", generateFilePath, io::output::writePng,
+                                   graph)) {
+            io::utils::logMessage("Saved graph to PNG.");
+        }
+    }
+}
+
+// 1つの禁止集合についてグラフを生成し出力 (キャッシュがあれば生成・解析の前に参照する)
+// generate と calcMaxEigenvalue で生成・解析の方法を差し替える．
+void processForbiddenSet(const SweepContext& context, std::uint64_t index,
+                         const std::vector<Node>& forbiddenNodes,
+                         const std::function<Graph()>& generate,
+                         const std::function<double(const Graph&)>& calcMaxEigenvalue) {
+    ForbiddenSetResult result = loadForbiddenSet(context, forbiddenNodes, generate);
+    classifyForbiddenSet(context, result);
+    saveForbiddenSet(context, index, forbiddenNodes, result, calcMaxEigenvalue);
+}
+
+// 生成器で禁止集合ごとに生成
+void processForbiddenSet(const SweepContext& context, const GraphGenerator& generator,
+                         std::uint64_t index, const std::vector<Node>& forbiddenNodes) {
+    const EigenOptions eigenOptions{context.options.eigTolerance,
+                                    context.options.eigMaxIterations};
+    processForbiddenSet(
+        context, index, forbiddenNodes,
+        [&]() { return generateGraph(context.config, generator, forbiddenNodes); },
+        [&](const Graph& graph) { return calculateMaxEigenvalue(graph, eigenOptions); });
+}
+
+// 生成器で複数の禁止集合をまとめて生成 (最大固有値は小さいグラフをまとめて計算する)
+// 刈り込んでいないグラフ (opt_mode が none) は刈り込んだ複製で計算する (最大固有値は変わらない)．
+void processForbiddenSets(const SweepContext& context, const GraphGenerator& generator,
+                          const ForbiddenSetBatch& sets) {
+    const EigenOptions eigenOptions{context.options.eigTolerance,
+                                    context.options.eigMaxIterations};
+    std::vector<ForbiddenSetResult> results;
+    results.reserve(sets.size());
+    for (const auto& [index, forbiddenNodes] : sets) {
+        results.push_back(loadForbiddenSet(context, forbiddenNodes, [&]() {
+            return generateGraph(context.config, generator, forbiddenNodes);
+        }));
+    }
+
+    // 容量の範囲を上下界で判定できなかったものと --max-eig の未計算のものをまとめて計算
+    const bool trim = context.config.generation.opt_mode == "none";
+    std::vector<Graph> trimmed;
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (classifyForbiddenSet(context, results[i])) {
+            pending.push_back(i);
+            if (trim) {
+                trimmed.push_back(cleanGraph(results[i].entry.graph));
+            }
+        }
+    }
+    std::vector<const Graph*> graphs;
+    for (size_t k = 0; k < pending.size(); ++k) {
+        graphs.push_back(trim ? &trimmed[k] : &results[pending[k]].entry.graph);
+    }
+    const auto values = calculateMaxEigenvalues(graphs, eigenOptions);
+    for (size_t k = 0; k < pending.size(); ++k) {
+        results[pending[k]].entry.maxEigenvalue = values[k];
+        results[pending[k]].updated = true;
+    }
+
+    auto calcMaxEigenvalue = [&](const Graph& graph) {
+        return calculateMaxEigenvalue(graph, eigenOptions);
+    };
+    for (size_t i = 0; i < sets.size(); ++i) {
+        saveForbiddenSet(context, sets[i].first, sets[i].second, results[i], calcMaxEigenvalue);
+    }
+}
+
+// 差分更新済みのDe Bruijnグラフから生成 (最大固有値は刈り込み後の部分グラフで計算)
+void processForbiddenSet(const SweepContext& context, IncrementalDeBruijn& incremental,
+                         std::uint64_t index, const std::vector<Node>& forbiddenNodes) {
+    const auto& optMode = context.config.generation.opt_mode;
+    auto generate = [&]() {
+        if (optMode == "sink_less") {
+            io::utils::logMessage("Applying sink-less mode.");
+            return incremental.generateTrimmed();
+        } else if (optMode == "minimize") {
+            io::utils::logMessage("Applying minimize mode.");
+            return Moore::apply(incremental.generateTrimmed());
+        } else if (optMode == "scc") {
+            io::utils::logMessage("Applying SCC mode.");
+            return cleanGraph(incremental.generateTrimmed(), CleanMode::Scc);
+        }
+        return incremental.generate();
+    };
+    const EigenOptions eigenOptions{context.options.eigTolerance,
+                                    context.options.eigMaxIterations};
+    processForbiddenSet(context, index, forbiddenNodes, generate,
+                        [&](const Graph&) { return incremental.calcMaxEigenvalue(eigenOptions); });
+}
+
+// 最大固有値の大きい上位 k 個の禁止集合を分枝限定法で探索し，top_k.csv に保存して上位のグラフだけを出力
+void searchTopK(const io::type::Config& config, const CLI::Parser::ParsedOptions& options) {
+    const auto generator = GeneratorFactory::create(config);
+    const EigenOptions eigenOptions{options.eigTolerance, options.eigMaxIterations};
+    CapacitySearch search(config, *generator, eigenOptions);
+
+    // 対称性を使う場合は軌道の代表元だけを数える (軌道内で最大固有値は等しい)
+    CapacitySearch::Accept accept;
+    std::unique_ptr<SymmetryGroup> group;
+    if (config.generation.symmetry) {
+        group = std::make_unique<SymmetryGroup>(config.generation.alphabet,
+                                                config.generation.forbidden.length,
+                                                config.generation.forbidden.position);
+        accept = [&](const std::vector<Node>& forbiddenNodes) {
+            size_t transform, orbitSize;
+            return group->canonicalize(forbiddenNodes, transform, orbitSize) == forbiddenNodes;
+        };
+    }
+
+    io::utils::logMessage("Searching top " + std::to_string(options.topK) +
+                          " forbidden sets by max eigenvalue.");
+    const auto results = search.run(options.topK, accept);
+    const auto& stats = search.getStats();
+    io::utils::logMessage(
+        "Visited " + std::to_string(stats.visited) + " search nodes (" +
+        std::to_string(stats.evaluated) + " eigenvalue computations, " +
+        std::to_string(stats.degreePruned) + " pruned by degree bounds, " +
+        std::to_string(stats.boundPruned) + " pruned by eigenvalue bounds) for " +
+        std::to_string(io::input::ForbiddenSetEnumerator(config).getCount()) +
+        " forbidden sets.");
+
+    const std::string topKPath = path::genSweepFilePath(config, "top_k", "csv", 0, 1);
+    path::utils::genDir(topKPath);
+    std::ofstream file(topKPath);
+    if (!io::utils::checkFileOpen(file, topKPath)) {
+        io::utils::printErrorAndExit("Failed to open top-k output: " + topKPath);
+    }
+    file << "rank,index,forbidden_set,max_eig\n";
+    file.precision(12);
+    for (size_t rank = 0; rank < results.size(); ++rank) {
+        const auto& result = results[rank];
+        const std::string name = path::genBaseName(result.forbiddenNodes);
+        file << rank + 1 << "," << result.index << "," << name << "," << result.maxEigenvalue
+             << "\n";
+        io::utils::logMessage("#" + std::to_string(rank + 1) + " " + name +
+                              ": Max Eigenvalue = " + std::to_string(result.maxEigenvalue));
+    }
+    file.close();
+    io::utils::logMessage("Saved top-k results to " + topKPath);
+
+    // 上位の禁止集合のみ通常の生成と同じく出力する
+    const SweepContext context{config, options, nullptr, nullptr, nullptr, nullptr};
+    for (const auto& result : results) {
+        processForbiddenSet(context, *generator, result.index, result.forbiddenNodes);
+    }
+}
 
 void handleInputJson(const CLI::Parser::ParsedOptions& options) {
     io::utils::logMessage("Processing JSON: " + options.inputPath);
@@ -23,41 +400,312 @@ void handleInputJson(const CLI::Parser::ParsedOptions& options) {
         io::utils::printErrorAndExit("Failed to load config: " + options.inputPath);
     }
 
-    std::unique_ptr<GraphGenerator> generator = GeneratorFactory::create(config);
+    const bool allPatterns = config.generation.mode == "all-patterns";
+    const unsigned int shardIndex = options.shardIndex;
+    const unsigned int shardCount = options.shardCount;
+    if (shardCount > 1 && !allPatterns) {
+        io::utils::printErrorAndExit("--shard requires all-patterns mode.");
+    }
+    if (options.incremental) {
+        if (!allPatterns || config.generation.algorithm != "DeBruijn") {
+            io::utils::printErrorAndExit(
+                "--incremental requires all-patterns mode with the DeBruijn algorithm.");
+        }
+        if (shardCount > 1) {
+            io::utils::printErrorAndExit("--incremental cannot be combined with --shard.");
+        }
+    }
 
-    auto forbiddenNodesList = io::input::genNodesFromConfig(config);
-    for (const auto& forbiddenNodes : forbiddenNodesList) {
-        Graph graph = generator->generate(forbiddenNodes);
+    // 容量の範囲外のグラフは出力しない
+    const CapacityWindow window(options.minCapacity, options.maxCapacity, options.eigTolerance);
 
-        if (config.generation.opt_mode == "sink_less") {
-            io::utils::logMessage("Applying sink-less mode.");
-            graph = cleanGraph(graph);
-        } else if (config.generation.opt_mode == "minimize") {
-            io::utils::logMessage("Applying minimize mode.");
-            graph = cleanGraph(graph);
-            graph = Moore::apply(graph);
+    if (options.topK > 0) {
+        if (!allPatterns) {
+            io::utils::printErrorAndExit("--top-k requires all-patterns mode.");
         }
+        if (shardCount > 1 || options.incremental || options.resume || options.merge ||
+            window.isBounded()) {
+            io::utils::printErrorAndExit(
+                "--top-k cannot be combined with --shard, --incremental, --resume, --merge, "
+                "--min-capacity or --max-capacity.");
+        }
+        searchTopK(config, options);
+        return;
+    }
 
-        path::Generator pathGenerator(config, forbiddenNodes);
+    // 各分割の集計ファイルを結合して終了
+    if (options.merge) {
+        if (!io::output::mergeShardFiles(path::genBaseDir(config))) {
+            io::utils::printErrorAndExit("Failed to merge shard files in: " +
+                                         path::genBaseDir(config));
+        }
+        return;
+    }
 
-        auto generateFilePath = [&](const std::string& type, const std::string& ext) {
-            return pathGenerator.genFilePath(type, ext);
-        };
+    // 列挙順の番号 [begin, end) を担当する (分割は総数をほぼ等分した連続区間)
+    // --incremental では最小変化順に列挙し，番号はその順での位置とする
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    std::unique_ptr<io::input::MinimalChangeEnumerator> minimalChange;
+    std::unique_ptr<IncrementalDeBruijn> incremental;
+    if (options.incremental) {
+        minimalChange = std::make_unique<io::input::MinimalChangeEnumerator>(config);
+        incremental = std::make_unique<IncrementalDeBruijn>(
+            config.generation.alphabet, config.generation.period,
+            config.generation.forbidden.length);
+        io::utils::logMessage("Sweeping in minimal-change order with incremental updates.");
+    }
+    const std::uint64_t total = enumerator.getCount();
+    const auto begin = static_cast<std::uint64_t>(
+        static_cast<unsigned __int128>(total) * shardIndex / shardCount);
+    const auto end = static_cast<std::uint64_t>(
+        static_cast<unsigned __int128>(total) * (shardIndex + 1) / shardCount);
+    if (shardCount > 1) {
+        io::utils::logMessage("Shard " + std::to_string(shardIndex) + "/" +
+                              std::to_string(shardCount) + ": forbidden sets [" +
+                              std::to_string(begin) + ", " + std::to_string(end) + ") of " +
+                              std::to_string(total) + ".");
+    }
 
-        if (config.output.edge_list) {
-            if (io::output::writeGraph("edges", "csv", generateFilePath, io::output::writeEdgesCsv,
-                                       graph)) {
-                io::utils::logMessage("Saved edge list to CSV.");
+    std::unique_ptr<io::ResultCache> cache;
+    if (!options.cacheDir.empty()) {
+        cache = std::make_unique<io::ResultCache>(options.cacheDir);
+        io::utils::logMessage("Using result cache: " + options.cacheDir);
+    }
+    std::unique_ptr<SymmetryFilter> symmetry;
+    if (config.generation.symmetry) {
+        symmetry = std::make_unique<SymmetryFilter>(config, shardIndex, shardCount);
+    }
+
+    // 禁止集合ごとに独立したタスクとして並列に処理 (生成器はワーカーごとに持つ)
+    // 出力先は禁止集合から決まるので実行順によらない (差分更新は直前の状態に依存するので逐次)
+    size_t threadCount =
+        options.jobs > 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    if (incremental && threadCount > 1) {
+        io::utils::logMessage("Incremental sweeps run on a single thread.");
+        threadCount = 1;
+    }
+    std::vector<std::unique_ptr<GraphGenerator>> generators;
+    for (size_t i = 0; i < threadCount; ++i) {
+        generators.push_back(GeneratorFactory::create(config));
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if (threadCount > 1) {
+        pool = std::make_unique<ThreadPool>(threadCount, 4 * threadCount);
+        io::utils::logMessage("Running with " + std::to_string(threadCount) + " threads.");
+    }
+
+    // all-patternsモードでは進捗を定期的に保存し，--resume で完了済みの禁止集合を飛ばす
+    std::unique_ptr<io::Checkpoint> checkpoint;
+    std::unique_ptr<io::SweepSummary> summary;
+    std::unique_ptr<io::ZeroCapacitySets> zeroCapacity;
+    if (allPatterns) {
+        const std::string checkpointPath =
+            path::genSweepFilePath(config, "checkpoint", "json", shardIndex, shardCount);
+        std::string fingerprint = io::Checkpoint::genFingerprint(config);
+        if (incremental) {
+            fingerprint += ";order=minimal-change";
+        }
+        checkpoint = std::make_unique<io::Checkpoint>(
+            checkpointPath, fingerprint, std::chrono::seconds(options.checkpointInterval), begin);
+        bool resumed = false;
+        if (options.resume) {
+            resumed = checkpoint->load();
+            if (resumed) {
+                io::utils::logMessage("Resuming from checkpoint: " +
+                                      std::to_string(checkpoint->getCompletedCount()) +
+                                      " forbidden sets already completed.");
+            } else {
+                io::utils::logMessage("No checkpoint found: " + checkpointPath);
             }
         }
 
-        if (config.output.png_file) {
-            if (io::output::writeGraph("graph", "png", generateFilePath, io::output::writePng,
-                                       graph)) {
-                io::utils::logMessage("Saved graph to PNG.");
+        summary = std::make_unique<io::SweepSummary>(
+            path::genSweepFilePath(config, "summary", "csv", shardIndex, shardCount));
+        if (resumed) {
+            summary->open([&](std::uint64_t index) { return checkpoint->isCompleted(index); });
+        } else {
+            summary->open();
+        }
+
+        // 他の実行 (位相ごとの語数が異なる) で見つけた容量0の集合を含む禁止集合は生成しない
+        if (!options.noPrune) {
+            zeroCapacity = std::make_unique<io::ZeroCapacitySets>(
+                path::genSharedFilePath(config, "zero_capacity", "csv"));
+            if (zeroCapacity->load()) {
+                io::utils::logMessage("Loaded " + std::to_string(zeroCapacity->getCount()) +
+                                      " zero-capacity sets from " + zeroCapacity->getPath());
             }
         }
     }
+
+    // 担当範囲の先頭へ移動 (対称性の対応表は全件を書き出すので完了済みの範囲も辿る)
+    std::uint64_t index = begin;
+    if (checkpoint && !symmetry) {
+        index = std::max(begin, checkpoint->getCompletedPrefix());
+    }
+    if (index > 0) {
+        if (minimalChange) {
+            minimalChange->seek(index);
+        } else {
+            enumerator.seek(index);
+        }
+    }
+    auto next = [&]() { return minimalChange ? minimalChange->next() : enumerator.next(); };
+
+    const SweepContext context{config, options, cache.get(), summary.get(), zeroCapacity.get(),
+                               window.isBounded() ? &window : nullptr};
+    std::uint64_t pruned = 0;
+
+    // 最大固有値を求める場合は禁止集合を batchSize 個ずつまとめて1つのタスクにする
+    const size_t batchSize = options.maxEig && !incremental ? std::max(1u, options.eigBatch) : 1;
+    ForbiddenSetBatch batch;
+    auto submitBatch = [&]() {
+        if (batch.empty()) {
+            return;
+        }
+        auto task = [&](size_t worker, const ForbiddenSetBatch& sets) {
+            processForbiddenSets(context, *generators[worker], sets);
+            if (checkpoint) {
+                for (const auto& set : sets) {
+                    checkpoint->markCompleted(set.first);
+                }
+            }
+        };
+        if (pool) {
+            pool->submit([task, sets = std::move(batch)](size_t worker) { task(worker, sets); });
+        } else {
+            task(0, batch);
+        }
+        batch.clear();
+    };
+
+    try {
+        for (; index < end && next(); ++index) {
+            const auto& forbiddenNodes = minimalChange ? minimalChange->get() : enumerator.get();
+            if (incremental) {
+                // 直前の禁止集合との差分を反映 (飛ばす集合でも状態は進める)
+                if (minimalChange->hasChanges()) {
+                    for (const auto& node : minimalChange->getRemoved()) {
+                        incremental->allow(node);
+                    }
+                    for (const auto& node : minimalChange->getAdded()) {
+                        incremental->forbid(node);
+                    }
+                } else {
+                    incremental->reset(forbiddenNodes);
+                }
+            }
+            if (symmetry && !symmetry->accept(forbiddenNodes)) {
+                if (checkpoint) {
+                    checkpoint->markCompleted(index);
+                }
+                continue;
+            }
+            if (checkpoint && checkpoint->isCompleted(index)) {
+                continue;
+            }
+            if (zeroCapacity && zeroCapacity->containsSubsetOf(forbiddenNodes)) {
+                if (window.classify(0.0) == CapacityWindow::Decision::Inside) {
+                    summary->writePruned(index, forbiddenNodes);
+                }
+                checkpoint->markCompleted(index);
+                ++pruned;
+                continue;
+            }
+
+            if (batchSize > 1) {
+                batch.emplace_back(index, forbiddenNodes);
+                if (batch.size() == batchSize) {
+                    submitBatch();
+                }
+                continue;
+            }
+
+            auto task = [&, index](size_t worker, const std::vector<Node>& forbiddenNodes) {
+                if (incremental) {
+                    processForbiddenSet(context, *incremental, index, forbiddenNodes);
+                } else {
+                    processForbiddenSet(context, *generators[worker], index, forbiddenNodes);
+                }
+                if (checkpoint) {
+                    checkpoint->markCompleted(index);
+                }
+            };
+            if (pool) {
+                pool->submit([task, forbiddenNodes](size_t worker) { task(worker, forbiddenNodes); });
+            } else {
+                task(0, forbiddenNodes);
+            }
+        }
+        submitBatch();
+        if (pool) {
+            pool->wait();
+        }
+    } catch (...) {
+        // 途中で失敗しても完了した分は残す
+        if (pool) {
+            try {
+                pool->wait();
+            } catch (...) {
+            }
+        }
+        if (checkpoint) {
+            checkpoint->save();
+        }
+        throw;
+    }
+
+    if (checkpoint) {
+        checkpoint->save(true);
+    }
+
+    if (zeroCapacity) {
+        io::utils::logMessage("Pruned " + std::to_string(pruned) +
+                              " forbidden sets containing a zero-capacity set (" +
+                              std::to_string(zeroCapacity->getCount()) + " minimal sets in " +
+                              zeroCapacity->getPath() + ").");
+    }
+
+    if (summary) {
+        io::utils::logMessage("Saved summary to " + summary->getPath());
+    }
+
+    if (symmetry) {
+        symmetry->report();
+    }
+}
+
+// バイナリファイルと許可系列を順位で相互に変換し (encode なら系列へ)，入力側の速度を表示
+void codeSequences(const SequenceCoder& coder, const std::string& inputPath,
+                   const std::string& outputPath, bool encode) {
+    std::ifstream in(inputPath, std::ios::binary);
+    if (!io::utils::checkFileOpen(in, inputPath)) {
+        return;
+    }
+    path::utils::genDir(outputPath);
+    std::ofstream out(outputPath, std::ios::binary);
+    if (!io::utils::checkFileOpen(out, outputPath)) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t count = encode ? coder.encode(in, out) : coder.decode(in, out);
+    out.flush();
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const std::uint64_t bytes = encode ? std::filesystem::file_size(inputPath) : count;
+    const std::string rate =
+        seconds > 0 ? std::to_string(bytes / seconds / 1e6) + " MB/s" : "- MB/s";
+    const std::string words = std::to_string(coder.getBitsPerWord()) + " bits per sequence";
+    if (encode) {
+        io::utils::logMessage("Encoded " + std::to_string(bytes) + " bytes into " +
+                              std::to_string(count) + " sequences (" + words + ", " + rate +
+                              "): " + outputPath);
+    } else {
+        io::utils::logMessage("Decoded " + std::to_string(bytes) + " bytes (" + words + ", " +
+                              rate + "): " + outputPath);
+    }
 }
 
 void handleInputCSV(const CLI::Parser::ParsedOptions& options, const std::string& extension) {
@@ -71,6 +719,12 @@ void handleInputCSV(const CLI::Parser::ParsedOptions& options, const std::string
         io::utils::printErrorAndExit("No CSV files found: " + options.inputPath);
     }
 
+    const EigenOptions eigenOptions{options.eigTolerance, options.eigMaxIterations};
+    const CapacityWindow window(options.minCapacity, options.maxCapacity, options.eigTolerance);
+    // 許可系列は接頭辞で分けて並列に列挙する
+    const size_t threadCount =
+        options.jobs > 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+
     for (const auto& csvFile : csvFiles) {
         Graph graph;
         bool success = (options.format == "edges") ? io::input::readEdgesCSV(csvFile, graph)
@@ -85,6 +739,18 @@ void handleInputCSV(const CLI::Parser::ParsedOptions& options, const std::string
         std::string directory = path::utils::extractPath(csvFile, 1, true, false, false);
         std::string fileName = path::utils::extractPath(csvFile, 0, false, true, false);
 
+        // 容量の範囲外のグラフは何も出力しない (上下界で判定できなければ最大固有値で判定)
+        std::optional<double> maxEig;
+        CapacityWindow::Decision decision = window.classify(graph);
+        if (decision == CapacityWindow::Decision::Unknown) {
+            maxEig = calculateMaxEigenvalue(graph, eigenOptions);
+            decision = window.classify(*maxEig);
+        }
+        if (decision == CapacityWindow::Decision::Outside) {
+            io::utils::logMessage(fileName + ": outside the capacity window, skipped.");
+            continue;
+        }
+
         auto generateFilePath = [&](const std::string& type, const std::string& ext) {
             return directory + "/" + type + "/" + fileName + "." + ext;
         };
@@ -106,23 +772,73 @@ void handleInputCSV(const CLI::Parser::ParsedOptions& options, const std::string
         }
 
         auto writeSeqCsvWithLength = [&](const std::string& filePath, const Graph& graph) {
-            return io::output::writeSeqCsv(filePath, graph, options.seqLength);
+            return io::output::writeSeqCsv(filePath, graph, options.seqLength, threadCount);
+        };
+        auto writeSeqDawgWithLength = [&](const std::string& filePath, const Graph& graph) {
+            return io::output::writeSeqDawg(filePath, graph, options.seqLength);
         };
 
-        if (options.seqLength > 0 &&
+        if (options.seqLength > 0 && !options.dawg &&
             io::output::writeGraph("sequences_length_" + std::to_string(options.seqLength), "csv",
                                    generateFilePath, writeSeqCsvWithLength, graph)) {
             io::utils::logMessage("Saved sequences of length " + std::to_string(options.seqLength) +
                                   " to CSV.");
         }
 
+        if (options.seqLength > 0 && options.dawg &&
+            io::output::writeGraph("sequences_length_" + std::to_string(options.seqLength), "dawg",
+                                   generateFilePath, writeSeqDawgWithLength, graph)) {
+            io::utils::logMessage("Saved sequences of length " + std::to_string(options.seqLength) +
+                                  " to DAWG.");
+        }
+
+        if (!options.encodePath.empty() || !options.decodePath.empty()) {
+            const SequenceCoder coder(graph.getCsr(), options.codeLength);
+            const std::string length = std::to_string(options.codeLength);
+            if (!options.encodePath.empty()) {
+                codeSequences(coder, options.encodePath,
+                              generateFilePath("encoded_length_" + length, "txt"), true);
+            }
+            if (!options.decodePath.empty()) {
+                codeSequences(coder, options.decodePath,
+                              generateFilePath("decoded_length_" + length, "bin"), false);
+            }
+        }
+
+        auto writePathCountsCsvWithLength = [&](const std::string& filePath, const Graph& graph) {
+            return io::output::writePathCountsCsv(filePath, graph, options.pathLength);
+        };
+
+        if (options.pathLength > 0 &&
+            io::output::writeGraph("paths_length_" + std::to_string(options.pathLength), "csv",
+                                   generateFilePath, writePathCountsCsvWithLength, graph)) {
+            io::utils::logMessage("Saved path counts of length " +
+                                  std::to_string(options.pathLength) + " to CSV.");
+        }
+
         if (options.maxEig) {
-            double maxEig = calculateMaxEigenvalue(graph);
-            io::utils::logMessage(fileName + ": Max Eigenvalue = " + std::to_string(maxEig));
+            if (!maxEig) {
+                maxEig = calculateMaxEigenvalue(graph, eigenOptions);
+            }
+            io::utils::logMessage(fileName + ": Max Eigenvalue = " + std::to_string(*maxEig));
         }
     }
 }
 
+// 許可系列のDAWGの概要を表示し，--contains の系列を含むか調べる
+void handleInputDawg(const CLI::Parser::ParsedOptions& options) {
+    SequenceDawg dawg;
+    if (!io::input::readSeqDawg(options.inputPath, dawg)) {
+        io::utils::printErrorAndExit("Failed to read DAWG: " + options.inputPath);
+    }
+    io::utils::logMessage("Sequences of length " + std::to_string(dawg.getLength()) + ": " +
+                          dawg.count().toString() + " (" + std::to_string(dawg.getNodeCount()) +
+                          " nodes, " + std::to_string(dawg.getEdgeCount()) + " transitions)");
+    for (const auto& word : options.contains) {
+        std::cout << word << "," << (dawg.contains(word) ? "true" : "false") << std::endl;
+    }
+}
+
 int main(int argc, char* argv[]) {
     CLI::Parser cliParser;
     auto options = cliParser.parse(argc, argv);
@@ -132,6 +848,8 @@ int main(int argc, char* argv[]) {
     try {
         if (extension == ".json") {
             handleInputJson(options);
+        } else if (extension == ".dawg") {
+            handleInputDawg(options);
         } else if (extension == ".csv" || extension.empty()) {
             cliParser.validate();
             handleInputCSV(options, extension);
@@ -45,6 +45,34 @@ std::string buildBaseName(const std::vector<Node>& nodes) {
     return name.str();
 }
 
+std::string genBaseDir(const Config& config) {
+    return buildBaseDir(config, getRoot());
+}
+
+std::string genSweepFilePath(const Config& config, const std::string& name, const std::string& ext,
+                             unsigned int shardIndex, unsigned int shardCount) {
+    std::ostringstream path;
+    path << genBaseDir(config) << "/" << name;
+    if (shardCount > 1) {
+        path << ".shard-" << shardIndex << "-of-" << shardCount;
+    }
+    path << "." << ext;
+    return path.str();
+}
+
+std::string genSharedFilePath(const Config& config, const std::string& name,
+                              const std::string& ext) {
+    std::ostringstream path;
+    path << getRoot() << "/" << config.output.output_dir << "/" << config.generation.alphabet
+         << "-" << config.generation.period << "-" << config.generation.forbidden.length << "/"
+         << name << "." << ext;
+    return path.str();
+}
+
+std::string genBaseName(const std::vector<Node>& nodes) {
+    return buildBaseName(nodes);
+}
+
 Generator::Generator(const Config& config, const std::vector<Node>& nodes)
     : baseDir(buildBaseDir(config, getRoot())), baseName(buildBaseName(nodes)) {}
 
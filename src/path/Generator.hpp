@@ -10,6 +10,21 @@ namespace path {
 
 using Config = io::type::Config;
 
+// 設定ごとの出力ディレクトリ (禁止集合によらない集計ファイルの出力先)
+std::string genBaseDir(const Config& config);
+
+// 設定ごとの集計ファイルのパス (分割実行時は <name>.shard-<i>-of-<N>.<ext>)
+std::string genSweepFilePath(const Config& config, const std::string& name, const std::string& ext,
+                             unsigned int shardIndex = 0, unsigned int shardCount = 1);
+
+// (アルファベット, 周期, 語長) が同じ all-patterns の実行で共有するファイルのパス
+// <output_dir>/<アルファベット>-<周期>-<語長>/<name>.<ext>
+std::string genSharedFilePath(const Config& config, const std::string& name,
+                              const std::string& ext);
+
+// 禁止集合から決まるファイル名 (拡張子なし)
+std::string genBaseName(const std::vector<Node>& nodes);
+
 class Generator {
    public:
     Generator(const Config& config, const std::vector<Node>& nodes);
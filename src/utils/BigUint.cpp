@@ -0,0 +1,207 @@
+#include "BigUint.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// 10進表記で1桁 (2^32 進) あたりにまとめる桁数と，その基数
+constexpr size_t DECIMAL_CHUNK = 9;
+constexpr std::uint32_t DECIMAL_BASE = 1000000000;
+
+}  // namespace
+
+// コンストラクタ
+BigUint::BigUint(std::uint64_t value) {
+    while (value > 0) {
+        limbs.push_back(static_cast<std::uint32_t>(value));
+        value >>= 32;
+    }
+}
+
+// 10進表記から生成 (上位から9桁ずつ x <- x * 10^9 + chunk)
+BigUint BigUint::fromString(const std::string& text) {
+    if (text.empty() || !std::all_of(text.begin(), text.end(), [](char c) {
+            return c >= '0' && c <= '9';
+        })) {
+        throw std::invalid_argument("Invalid unsigned integer: " + text);
+    }
+    BigUint result;
+    size_t head = text.size() % DECIMAL_CHUNK;
+    if (head == 0) {
+        head = DECIMAL_CHUNK;
+    }
+    for (size_t pos = 0; pos < text.size(); pos += head, head = DECIMAL_CHUNK) {
+        std::uint32_t chunk = std::stoul(text.substr(pos, head));
+        std::uint32_t scale = 1;
+        for (size_t i = 0; i < head; ++i) {
+            scale *= 10;
+        }
+        result *= scale;
+        result += chunk;
+    }
+    return result;
+}
+
+// 10進表記 (10^9 で割った余りを下位から集める)
+std::string BigUint::toString() const {
+    if (isZero()) {
+        return "0";
+    }
+    BigUint rest = *this;
+    std::vector<std::uint32_t> chunks;
+    while (!rest.isZero()) {
+        chunks.push_back(rest.divide(DECIMAL_BASE));
+    }
+    std::string text = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        const std::string chunk = std::to_string(chunks[i]);
+        text.append(DECIMAL_CHUNK - chunk.size(), '0');
+        text += chunk;
+    }
+    return text;
+}
+
+// 2進での桁数
+size_t BigUint::getBitLength() const {
+    if (isZero()) {
+        return 0;
+    }
+    size_t bits = 32 * (limbs.size() - 1);
+    for (std::uint32_t top = limbs.back(); top > 0; top >>= 1) {
+        ++bits;
+    }
+    return bits;
+}
+
+// 2進の i 桁目を1にする
+void BigUint::setBit(size_t i) {
+    if (i / 32 >= limbs.size()) {
+        limbs.resize(i / 32 + 1, 0);
+    }
+    limbs[i / 32] |= std::uint32_t{1} << (i % 32);
+}
+
+// std::uint64_t の値
+std::uint64_t BigUint::toUint64() const {
+    if (!fitsUint64()) {
+        throw std::overflow_error("BigUint does not fit in 64 bits.");
+    }
+    std::uint64_t value = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        value = (value << 32) | limbs[i];
+    }
+    return value;
+}
+
+// 足し算
+BigUint& BigUint::operator+=(const BigUint& other) {
+    if (limbs.size() < other.limbs.size()) {
+        limbs.resize(other.limbs.size(), 0);
+    }
+    std::uint64_t carry = 0;
+    for (size_t i = 0; i < limbs.size() && (i < other.limbs.size() || carry > 0); ++i) {
+        const std::uint64_t sum =
+            carry + limbs[i] + (i < other.limbs.size() ? other.limbs[i] : 0);
+        limbs[i] = static_cast<std::uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    if (carry > 0) {
+        limbs.push_back(static_cast<std::uint32_t>(carry));
+    }
+    return *this;
+}
+
+// 引き算
+BigUint& BigUint::operator-=(const BigUint& other) {
+    if (compare(*this, other) < 0) {
+        throw std::underflow_error("BigUint subtraction would be negative.");
+    }
+    std::int64_t borrow = 0;
+    for (size_t i = 0; i < limbs.size() && (i < other.limbs.size() || borrow != 0); ++i) {
+        std::int64_t diff = static_cast<std::int64_t>(limbs[i]) - borrow -
+                            (i < other.limbs.size() ? other.limbs[i] : 0);
+        borrow = diff < 0 ? 1 : 0;
+        limbs[i] = static_cast<std::uint32_t>(diff + (borrow << 32));
+    }
+    trim();
+    return *this;
+}
+
+// 掛け算 (筆算)
+BigUint operator*(const BigUint& lhs, const BigUint& rhs) {
+    BigUint result;
+    if (lhs.isZero() || rhs.isZero()) {
+        return result;
+    }
+    result.limbs.assign(lhs.limbs.size() + rhs.limbs.size(), 0);
+    for (size_t i = 0; i < lhs.limbs.size(); ++i) {
+        std::uint64_t carry = 0;
+        for (size_t j = 0; j < rhs.limbs.size(); ++j) {
+            const std::uint64_t product = static_cast<std::uint64_t>(lhs.limbs[i]) * rhs.limbs[j] +
+                                          result.limbs[i + j] + carry;
+            result.limbs[i + j] = static_cast<std::uint32_t>(product);
+            carry = product >> 32;
+        }
+        result.limbs[i + rhs.limbs.size()] = static_cast<std::uint32_t>(carry);
+    }
+    result.trim();
+    return result;
+}
+
+BigUint& BigUint::operator*=(const BigUint& other) {
+    return *this = *this * other;
+}
+
+// 1桁の数との掛け算
+BigUint& BigUint::operator*=(std::uint32_t factor) {
+    if (factor == 0) {
+        limbs.clear();
+        return *this;
+    }
+    std::uint64_t carry = 0;
+    for (auto& limb : limbs) {
+        const std::uint64_t product = static_cast<std::uint64_t>(limb) * factor + carry;
+        limb = static_cast<std::uint32_t>(product);
+        carry = product >> 32;
+    }
+    if (carry > 0) {
+        limbs.push_back(static_cast<std::uint32_t>(carry));
+    }
+    return *this;
+}
+
+// 1桁の数での割り算 (上位から)
+std::uint32_t BigUint::divide(std::uint32_t divisor) {
+    if (divisor == 0) {
+        throw std::invalid_argument("BigUint division by zero.");
+    }
+    std::uint64_t remainder = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        const std::uint64_t current = (remainder << 32) | limbs[i];
+        limbs[i] = static_cast<std::uint32_t>(current / divisor);
+        remainder = current % divisor;
+    }
+    trim();
+    return static_cast<std::uint32_t>(remainder);
+}
+
+// 比較
+int BigUint::compare(const BigUint& lhs, const BigUint& rhs) {
+    if (lhs.limbs.size() != rhs.limbs.size()) {
+        return lhs.limbs.size() < rhs.limbs.size() ? -1 : 1;
+    }
+    for (size_t i = lhs.limbs.size(); i-- > 0;) {
+        if (lhs.limbs[i] != rhs.limbs[i]) {
+            return lhs.limbs[i] < rhs.limbs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// 上位の0の桁を除く
+void BigUint::trim() {
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// 任意精度の非負整数 (経路数などの正確な計数用)
+// 2^32 進の桁を下位から保持する (最上位の桁は0でなく，0は桁なし)．
+class BigUint {
+   public:
+    // コンストラクタ (std::uint64_t からの暗黙の変換を許す)
+    BigUint() = default;
+    BigUint(std::uint64_t value);
+
+    // 10進表記から生成 (数字以外を含むか空なら std::invalid_argument)
+    static BigUint fromString(const std::string& text);
+
+    // 10進表記
+    std::string toString() const;
+
+    bool isZero() const { return limbs.empty(); }
+
+    // 2進での桁数 (0なら0)
+    size_t getBitLength() const;
+
+    // 2進の i 桁目 (最下位が0) の値・1にする
+    bool testBit(size_t i) const {
+        return i / 32 < limbs.size() && (limbs[i / 32] >> (i % 32)) & 1;
+    }
+    void setBit(size_t i);
+
+    // std::uint64_t に収まるか，収まる場合の値 (収まらなければ std::overflow_error)
+    bool fitsUint64() const { return limbs.size() <= 2; }
+    std::uint64_t toUint64() const;
+
+    // 四則演算 (引き算で負になる場合は std::underflow_error)
+    BigUint& operator+=(const BigUint& other);
+    BigUint& operator-=(const BigUint& other);
+    BigUint& operator*=(const BigUint& other);
+    BigUint& operator*=(std::uint32_t factor);
+
+    // divisor で割り，余りを返す (divisor が0なら std::invalid_argument)
+    std::uint32_t divide(std::uint32_t divisor);
+
+    friend BigUint operator+(BigUint lhs, const BigUint& rhs) { return lhs += rhs; }
+    friend BigUint operator-(BigUint lhs, const BigUint& rhs) { return lhs -= rhs; }
+    friend BigUint operator*(const BigUint& lhs, const BigUint& rhs);
+
+    // 比較 (負・0・正)
+    static int compare(const BigUint& lhs, const BigUint& rhs);
+
+    friend bool operator==(const BigUint& lhs, const BigUint& rhs) {
+        return lhs.limbs == rhs.limbs;
+    }
+    friend bool operator!=(const BigUint& lhs, const BigUint& rhs) { return !(lhs == rhs); }
+    friend bool operator<(const BigUint& lhs, const BigUint& rhs) { return compare(lhs, rhs) < 0; }
+    friend bool operator<=(const BigUint& lhs, const BigUint& rhs) {
+        return compare(lhs, rhs) <= 0;
+    }
+    friend bool operator>(const BigUint& lhs, const BigUint& rhs) { return compare(lhs, rhs) > 0; }
+    friend bool operator>=(const BigUint& lhs, const BigUint& rhs) {
+        return compare(lhs, rhs) >= 0;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const BigUint& value) {
+        return os << value.toString();
+    }
+
+   private:
+    std::vector<std::uint32_t> limbs;  // 2^32 進の桁 (下位から)
+
+    void trim();
+};
@@ -1,18 +1,189 @@
 #include "CombinationUtils.hpp"
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 // 文字列に対する組み合わせ生成関数
 std::vector<std::string> combine(const std::string& chars, unsigned int l, bool withRepetition) {
-    std::vector<char> charVec(chars.begin(), chars.end());
+    std::vector<std::string> result;
+    std::string word(l, '\0');
+    auto emit = [&](const std::vector<unsigned int>& indices) {
+        for (unsigned int i = 0; i < l; ++i) {
+            word[i] = chars[indices[i]];
+        }
+        result.push_back(word);
+    };
 
-    auto combinations = combine(charVec, l, withRepetition);
+    if (withRepetition) {
+        forEachTuple(chars.size(), l, emit);
+    } else {
+        forEachCombination(chars.size(), l, emit);
+    }
+    return result;
+}
 
-    std::vector<std::string> result;
-    for (const auto& comb : combinations) {
-        result.emplace_back(comb.begin(), comb.end());
+// 組み合わせを辞書順で次へ
+size_t nextCombination(std::vector<unsigned int>& indices, unsigned int m) {
+    const size_t n = indices.size();
+
+    // 右端から増やせる添字を探す
+    size_t i = n;
+    while (i > 0 && indices[i - 1] == m - n + i - 1) {
+        --i;
+    }
+    if (i == 0) {
+        return COMBINATION_END;
+    }
+
+    ++indices[i - 1];
+    for (size_t j = i; j < n; ++j) {
+        indices[j] = indices[j - 1] + 1;
+    }
+    return i - 1;
+}
+
+// 重複順列を辞書順で次へ
+size_t nextTuple(std::vector<unsigned int>& digits, unsigned int m) {
+    for (size_t i = digits.size(); i-- > 0;) {
+        if (++digits[i] < m) {
+            return i;
+        }
+        digits[i] = 0;
     }
+    return COMBINATION_END;
+}
 
+// 二項係数 C(n, k)
+std::uint64_t binomial(std::uint64_t n, std::uint64_t k) {
+    if (k > n) {
+        return 0;
+    }
+    k = std::min(k, n - k);
+    std::uint64_t result = 1;
+    for (std::uint64_t i = 1; i <= k; ++i) {
+        // result * (n - k + i) / i は常に整数 (C(n - k + i, i))
+        unsigned __int128 next = static_cast<unsigned __int128>(result) * (n - k + i) / i;
+        if (next > UINT64_MAX) {
+            throw std::overflow_error("Binomial coefficient exceeds 64 bits.");
+        }
+        result = static_cast<std::uint64_t>(next);
+    }
     return result;
 }
+
+// 辞書順で rank 番目の組み合わせ
+std::vector<unsigned int> unrankCombination(std::uint64_t rank, unsigned int m, unsigned int n) {
+    if (rank >= binomial(m, n)) {
+        throw std::out_of_range("Combination rank out of range.");
+    }
+    std::vector<unsigned int> indices(n);
+    unsigned int x = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        // 先頭が x の組み合わせは C(m - x - 1, n - i - 1) 個
+        while (true) {
+            std::uint64_t count = binomial(m - x - 1, n - i - 1);
+            if (rank < count) {
+                break;
+            }
+            rank -= count;
+            ++x;
+        }
+        indices[i] = x++;
+    }
+    return indices;
+}
+
+// 組み合わせの辞書順の順位
+std::uint64_t rankCombination(const std::vector<unsigned int>& indices, unsigned int m) {
+    const unsigned int n = indices.size();
+    std::uint64_t rank = 0;
+    unsigned int x = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        // 先頭が indices[i] より小さい組み合わせを数える
+        for (; x < indices[i]; ++x) {
+            rank += binomial(m - x - 1, n - i - 1);
+        }
+        ++x;
+    }
+    return rank;
+}
+
+namespace {
+
+// 回転扉順で1つ進める / 戻す (Knuth, TAOCP 7.2.1.3 Algorithm R の R3〜R5)
+// 位置 j (1 始まり) で c_j を減らすか増やすかは n - j の偶奇で交互に決まる．
+// 減らす手と増やす手は互いに逆なので，戻す向きは偶奇を入れ替えた同じ手順になる．
+bool stepRevolvingDoor(std::vector<unsigned int>& indices, unsigned int m, bool forward) {
+    const size_t n = indices.size();
+    if (n == 0 || n == m) {
+        return false;
+    }
+    // c_j = indices[j - 1]，c_{n + 1} = m は番兵
+    auto upper = [&](size_t j) { return j < n ? indices[j] : m; };
+
+    bool increase = (n % 2 == 1) == forward;
+    for (size_t j = 1; j <= n; ++j) {
+        if (j == 1) {
+            // 容易な場合 (c_1 だけを動かす)
+            if (increase ? indices[0] + 1 < upper(1) : indices[0] > 0) {
+                increase ? ++indices[0] : --indices[0];
+                return true;
+            }
+        } else if (!increase) {
+            // c_j を減らす (c_{j - 1} = c_j - 1)
+            if (indices[j - 1] >= j) {
+                indices[j - 1] = indices[j - 2];
+                indices[j - 2] = j - 2;
+                return true;
+            }
+        } else {
+            // c_j を増やす (c_{j - 1} = j - 2)
+            if (indices[j - 1] + 1 < upper(j)) {
+                indices[j - 2] = indices[j - 1];
+                ++indices[j - 1];
+                return true;
+            }
+        }
+        increase = !increase;
+    }
+    return false;
+}
+
+}  // namespace
+
+bool nextRevolvingDoor(std::vector<unsigned int>& indices, unsigned int m) {
+    return stepRevolvingDoor(indices, m, true);
+}
+
+bool prevRevolvingDoor(std::vector<unsigned int>& indices, unsigned int m) {
+    return stepRevolvingDoor(indices, m, false);
+}
+
+// 回転扉順での順位 (Kreher & Stinson, Algorithm 2.11)
+std::uint64_t rankRevolvingDoor(const std::vector<unsigned int>& indices) {
+    const unsigned int n = indices.size();
+    __int128 rank = -static_cast<__int128>(n % 2);
+    int sign = 1;
+    for (unsigned int i = n; i >= 1; --i) {
+        rank += sign * static_cast<__int128>(binomial(indices[i - 1] + 1, i));
+        sign = -sign;
+    }
+    return static_cast<std::uint64_t>(rank);
+}
+
+// 回転扉順で rank 番目の組み合わせ (Kreher & Stinson, Algorithm 2.12)
+void unrankRevolvingDoor(std::uint64_t rank, unsigned int m, std::vector<unsigned int>& indices) {
+    const unsigned int n = indices.size();
+    if (rank >= binomial(m, n)) {
+        throw std::out_of_range("Combination rank out of range.");
+    }
+    unsigned int x = m;
+    for (unsigned int i = n; i >= 1; --i) {
+        while (binomial(x, i) > rank) {
+            --x;
+        }
+        indices[i - 1] = x;
+        rank = binomial(x + 1, i) - rank - 1;
+    }
+}
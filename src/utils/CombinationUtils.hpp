@@ -1,26 +1,135 @@
 #pragma once
 
 #include <algorithm>
-#include <functional>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <string>
 #include <vector>
 
+// 組み合わせ・重複順列の列挙エンジン
+// 添字の配列をその場で更新し，各要素ごとの確保をせずにコールバックへ渡す．
+// コールバックが bool を返す場合は false で列挙を打ち切る．
+
+namespace combination_detail {
+
+template <typename Visit, typename Arg>
+bool visit(Visit& visitor, const Arg& arg) {
+    if constexpr (std::is_same_v<std::invoke_result_t<Visit&, const Arg&>, bool>) {
+        return visitor(arg);
+    } else {
+        visitor(arg);
+        return true;
+    }
+}
+
+}  // namespace combination_detail
+
+// nextCombination の終端
+constexpr size_t COMBINATION_END = static_cast<size_t>(-1);
+
+// 昇順の添字 indices (m 個から選ぶ組み合わせ) を辞書順で次へ進める
+// 変化した最も左の位置を返し，最後の組み合わせなら COMBINATION_END (indices は変えない)
+size_t nextCombination(std::vector<unsigned int>& indices, unsigned int m);
+
+// 昇順の添字 indices (m 個から選ぶ組み合わせ) を回転扉順で次 / 前へ進める
+// 最後 / 最初の組み合わせなら false (indices は変えない)．1歩はならし定数時間．
+bool nextRevolvingDoor(std::vector<unsigned int>& indices, unsigned int m);
+bool prevRevolvingDoor(std::vector<unsigned int>& indices, unsigned int m);
+
+// 重複順列 digits (各桁 0..m-1) を辞書順で次へ進める (オドメータ，最後の桁が最も速く変わる)
+// 変化した最も左の位置を返し，最後なら COMBINATION_END (digits は 0 に戻る)
+size_t nextTuple(std::vector<unsigned int>& digits, unsigned int m);
+
+// Gosper's hack: 立っているビット数が同じで mask より大きい最小のビット列
+// (m 要素の部分集合を colex 順に辿る．最後の次は m ビットを超える)
+inline std::uint64_t nextSubsetMask(std::uint64_t mask) {
+    const std::uint64_t lowest = mask & (~mask + 1);
+    const std::uint64_t ripple = mask + lowest;
+    return ripple | (((mask ^ ripple) >> 2) / lowest);
+}
+
+// m 個から n 個を選ぶ組み合わせを辞書順に列挙 (visit(const std::vector<unsigned int>&))
+template <typename Visit>
+void forEachCombination(unsigned int m, unsigned int n, Visit visit) {
+    if (n > m) {
+        return;
+    }
+    std::vector<unsigned int> indices(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        indices[i] = i;
+    }
+    do {
+        if (!combination_detail::visit(visit, indices)) {
+            return;
+        }
+    } while (nextCombination(indices, m) != COMBINATION_END);
+}
+
+// m 個から n 個を選ぶ部分集合をビット列として colex 順に列挙 (m <= 64，visit(std::uint64_t))
+template <typename Visit>
+void forEachSubsetMask(unsigned int m, unsigned int n, Visit visit) {
+    if (n > m || m > 64) {
+        return;
+    }
+    if (n == 0) {
+        combination_detail::visit(visit, std::uint64_t{0});
+        return;
+    }
+    const std::uint64_t last = (n == 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << n) - 1))
+                               << (m - n);
+    for (std::uint64_t mask = (n == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1);;
+         mask = nextSubsetMask(mask)) {
+        if (!combination_detail::visit(visit, mask) || mask == last) {
+            return;
+        }
+    }
+}
+
+// m 個から n 個を選ぶ組み合わせを回転扉順 (revolving door) に列挙
+// 隣り合う組み合わせは1要素の入れ替えだけが異なる (Knuth, TAOCP 7.2.1.3 Algorithm R)．
+// visit には昇順の添字を渡す．
+template <typename Visit>
+void forEachRevolvingDoor(unsigned int m, unsigned int n, Visit visit) {
+    if (n > m) {
+        return;
+    }
+    std::vector<unsigned int> indices(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        indices[i] = i;
+    }
+    do {
+        if (!combination_detail::visit(visit, indices)) {
+            return;
+        }
+    } while (nextRevolvingDoor(indices, m));
+}
+
+// 0..m-1 の長さ n の重複順列を辞書順に列挙 (visit(const std::vector<unsigned int>&))
+template <typename Visit>
+void forEachTuple(unsigned int m, unsigned int n, Visit visit) {
+    if (m == 0 && n > 0) {
+        return;
+    }
+    std::vector<unsigned int> digits(n, 0);
+    do {
+        if (!combination_detail::visit(visit, digits)) {
+            return;
+        }
+    } while (nextTuple(digits, m) != COMBINATION_END);
+}
+
 // 復元なしの組み合わせ生成
 template <typename T>
 std::vector<std::vector<typename T::value_type>> combineNoRep(const T& elems, unsigned int n) {
     std::vector<std::vector<typename T::value_type>> result;
-    std::vector<bool> mask(n, true);
-    mask.resize(elems.size(), false);
-
-    do {
-        std::vector<typename T::value_type> comb;
-        for (size_t i = 0; i < elems.size(); ++i) {
-            if (mask[i]) {
-                comb.push_back(*(std::next(elems.begin(), i)));
-            }
+    std::vector<typename T::value_type> comb(n);
+    forEachCombination(elems.size(), n, [&](const std::vector<unsigned int>& indices) {
+        for (unsigned int i = 0; i < n; ++i) {
+            comb[i] = *std::next(elems.begin(), indices[i]);
         }
         result.push_back(comb);
-    } while (std::prev_permutation(mask.begin(), mask.end()));
-
+    });
     return result;
 }
 
@@ -29,18 +138,12 @@ template <typename T>
 std::vector<std::vector<typename T::value_type>> combineWithRep(const T& elems, unsigned int n) {
     std::vector<std::vector<typename T::value_type>> result;
     std::vector<typename T::value_type> comb(n);
-    std::function<void(unsigned int)> dfs = [&](unsigned int depth) {
-        if (depth == n) {
-            result.push_back(comb);
-            return;
-        }
-        for (const auto& e : elems) {
-            comb[depth] = e;
-            dfs(depth + 1);
+    forEachTuple(elems.size(), n, [&](const std::vector<unsigned int>& digits) {
+        for (unsigned int i = 0; i < n; ++i) {
+            comb[i] = *std::next(elems.begin(), digits[i]);
         }
-    };
-    dfs(0);
-
+        result.push_back(comb);
+    });
     return result;
 }
 
@@ -57,3 +160,18 @@ std::vector<std::vector<typename T::value_type>> combine(const T& elems, unsigne
 
 // Declaration only for the string-based combine function
 std::vector<std::string> combine(const std::string& chars, unsigned int l, bool withRepetition);
+
+// 二項係数 C(n, k) (uint64 に収まらなければ std::overflow_error)
+std::uint64_t binomial(std::uint64_t n, std::uint64_t k);
+
+// m 個から n 個を選ぶ組み合わせのうち，辞書順で rank 番目のものの添字 (昇順)
+// combineNoRep と同じ順序 (組み合わせ数体系による逆ランク付け)
+std::vector<unsigned int> unrankCombination(std::uint64_t rank, unsigned int m, unsigned int n);
+
+// unrankCombination の逆 (昇順の添字 indices の辞書順の順位)
+std::uint64_t rankCombination(const std::vector<unsigned int>& indices, unsigned int m);
+
+// 回転扉順 (forEachRevolvingDoor と同じ順序) での順位と逆ランク付け
+// unrankRevolvingDoor は indices (大きさ n) をその場で書き換える．
+std::uint64_t rankRevolvingDoor(const std::vector<unsigned int>& indices);
+void unrankRevolvingDoor(std::uint64_t rank, unsigned int m, std::vector<unsigned int>& indices);
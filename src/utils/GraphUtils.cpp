@@ -1,67 +1,57 @@
 #include "GraphUtils.hpp"
 
-#include "NodeUtils.hpp"
+#include <algorithm>
 
 // 計算: ノードの出次数と入次数
-std::pair<std::unordered_map<Node, int>, std::unordered_map<Node, int>> calcDegrees(
-    const Graph& graph) {
-    const auto& edges = graph.getEdges();
-    const auto& nodes = graph.getNodes();
+std::pair<std::vector<int>, std::vector<int>> calcDegrees(const CsrGraph& graph) {
+    std::vector<int> outDeg(graph.getNodeCount(), 0);
+    std::vector<int> inDeg(graph.getNodeCount(), 0);
 
-    std::unordered_map<Node, int> outDeg;
-    std::unordered_map<Node, int> inDeg;
-
-    for (const auto& node : nodes) {
-        outDeg[node] = 0;
-        inDeg[node] = 0;
-    }
-
-    for (const auto& edge : edges) {
-        outDeg[edge.getSource()]++;
-        inDeg[edge.getTarget()]++;
+    for (size_t e = 0; e < graph.getEdgeCount(); ++e) {
+        outDeg[graph.getEdgeSource(e)]++;
+        inDeg[graph.getEdgeTarget(e)]++;
     }
 
     return {outDeg, inDeg};
 }
 
-// 削除: 孤立ノードを削除
-std::unordered_set<Node> removeZeroDegNodes(const Graph& graph,
-                                            std::unordered_map<Node, int>& outDeg,
-                                            std::unordered_map<Node, int>& inDeg) {
-    const auto& edges = graph.getEdges();
-    const auto& nodes = graph.getNodes();
+// 削除: 孤立ノードを削除 (順方向・逆方向の隣接リストを使った作業リストでO(V+E))
+std::vector<bool> removeZeroDegNodes(const CsrGraph& graph, std::vector<int>& outDeg,
+                                     std::vector<int>& inDeg) {
+    const auto& outOffsets = graph.getOutOffsets();
+    const auto& outTargets = graph.getOutTargets();
+    const auto& inOffsets = graph.getInOffsets();
+    const auto& inSources = graph.getInSources();
 
-    std::unordered_set<Node> removed;
-    std::queue<Node> zeroDegNodes;
+    std::vector<bool> removed(graph.getNodeCount(), false);
+    std::queue<CsrGraph::Id> zeroDegNodes;
 
-    for (const auto& node : nodes) {
+    for (CsrGraph::Id node = 0; node < graph.getNodeCount(); ++node) {
         if (outDeg[node] == 0 || inDeg[node] == 0) {
             zeroDegNodes.push(node);
-            removed.insert(node);
+            removed[node] = true;
         }
     }
 
     while (!zeroDegNodes.empty()) {
-        Node current = zeroDegNodes.front();
+        CsrGraph::Id current = zeroDegNodes.front();
         zeroDegNodes.pop();
 
-        for (const auto& edge : edges) {
-            if (edge.getSource() == current) {
-                Node tgt = edge.getTarget();
-                inDeg[tgt]--;
-                if (inDeg[tgt] == 0 && !containsNode(removed, tgt)) {
-                    zeroDegNodes.push(tgt);
-                    removed.insert(tgt);
-                }
+        for (auto k = outOffsets[current]; k < outOffsets[current + 1]; ++k) {
+            CsrGraph::Id tgt = outTargets[k];
+            inDeg[tgt]--;
+            if (inDeg[tgt] == 0 && !removed[tgt]) {
+                zeroDegNodes.push(tgt);
+                removed[tgt] = true;
             }
+        }
 
-            if (edge.getTarget() == current) {
-                Node src = edge.getSource();
-                outDeg[src]--;
-                if (outDeg[src] == 0 && !containsNode(removed, src)) {
-                    zeroDegNodes.push(src);
-                    removed.insert(src);
-                }
+        for (auto k = inOffsets[current]; k < inOffsets[current + 1]; ++k) {
+            CsrGraph::Id src = inSources[k];
+            outDeg[src]--;
+            if (outDeg[src] == 0 && !removed[src]) {
+                zeroDegNodes.push(src);
+                removed[src] = true;
             }
         }
     }
@@ -69,30 +59,111 @@ std::unordered_set<Node> removeZeroDegNodes(const Graph& graph,
     return removed;
 }
 
-// 構築: 新しいグラフを生成
-Graph buildGraph(const Graph& graph, const std::unordered_set<Node>& removed) {
-    const auto& edges = graph.getEdges();
-    const auto& nodes = graph.getNodes();
-
-    Graph newGraph;
-    for (const auto& node : nodes) {
-        if (!containsNode(removed, node)) {
-            newGraph.addNode(node);
+// 削除: 非自明な強連結成分に属さないノードを削除 (反復版Tarjan法)
+std::vector<bool> removeTrivialSccNodes(const CsrGraph& graph) {
+    const CsrGraph::Id n = graph.getNodeCount();
+    const CsrGraph::Id unvisited = static_cast<CsrGraph::Id>(-1);
+    const auto& offsets = graph.getOutOffsets();
+    const auto& targets = graph.getOutTargets();
+
+    std::vector<CsrGraph::Id> index(n, unvisited);
+    std::vector<CsrGraph::Id> lowLink(n, 0);
+    std::vector<bool> onStack(n, false);
+    std::vector<CsrGraph::Id> sccStack;
+    std::vector<std::pair<CsrGraph::Id, CsrGraph::Id>> callStack;  // (ノード, 次に見る辺)
+    std::vector<bool> removed(n, true);
+    CsrGraph::Id counter = 0;
+
+    for (CsrGraph::Id root = 0; root < n; ++root) {
+        if (index[root] != unvisited) {
+            continue;
         }
-    }
+        callStack.push_back({root, offsets[root]});
+        index[root] = lowLink[root] = counter++;
+        sccStack.push_back(root);
+        onStack[root] = true;
+
+        while (!callStack.empty()) {
+            auto& [v, k] = callStack.back();
+            if (k < offsets[v + 1]) {
+                CsrGraph::Id w = targets[k++];
+                if (index[w] == unvisited) {
+                    index[w] = lowLink[w] = counter++;
+                    sccStack.push_back(w);
+                    onStack[w] = true;
+                    callStack.push_back({w, offsets[w]});
+                } else if (onStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], index[w]);
+                }
+                continue;
+            }
+
+            // vの探索が終了
+            CsrGraph::Id node = v;
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                CsrGraph::Id parent = callStack.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+            }
+            if (lowLink[node] != index[node]) {
+                continue;
+            }
 
-    for (const auto& edge : edges) {
-        if (!containsNode(removed, edge.getSource()) && !containsNode(removed, edge.getTarget())) {
-            newGraph.addEdge(edge);
+            // 強連結成分を取り出す
+            auto begin = std::find(sccStack.rbegin(), sccStack.rend(), node).base() - 1;
+            bool nontrivial = (sccStack.end() - begin) > 1;
+            if (!nontrivial) {
+                for (auto e = offsets[node]; e < offsets[node + 1]; ++e) {
+                    nontrivial |= (targets[e] == node);
+                }
+            }
+            for (auto it = begin; it != sccStack.end(); ++it) {
+                onStack[*it] = false;
+                removed[*it] = !nontrivial;
+            }
+            sccStack.erase(begin, sccStack.end());
         }
     }
 
-    return newGraph;
+    return removed;
+}
+
+// 構築: 新しいグラフを生成
+Graph buildGraph(const CsrGraph& graph, const std::vector<bool>& removed) {
+    std::vector<bool> keep(removed.size());
+    for (size_t v = 0; v < removed.size(); ++v) {
+        keep[v] = !removed[v];
+    }
+    return Graph(graph.subgraph(keep));
 }
 
 // メイン関数: 孤立ノードを削除したグラフを生成
-Graph cleanGraph(const Graph& graph) {
-    auto [outDeg, inDeg] = calcDegrees(graph);
-    auto removed = removeZeroDegNodes(graph, outDeg, inDeg);
-    return buildGraph(graph, removed);
+Graph cleanGraph(const Graph& graph, CleanMode mode) {
+    const auto& csr = graph.getCsr();
+    if (mode == CleanMode::Scc) {
+        return buildGraph(csr, removeTrivialSccNodes(csr));
+    }
+    auto [outDeg, inDeg] = calcDegrees(csr);
+    auto removed = removeZeroDegNodes(csr, outDeg, inDeg);
+    return buildGraph(csr, removed);
+}
+
+// 判定: 強連結か (出辺・入辺の隣接リストで両方向に探索)
+bool isStronglyConnected(const CsrGraph& graph) {
+    const auto& outOffsets = graph.getOutOffsets();
+    const auto& outTargets = graph.getOutTargets();
+    const auto& inOffsets = graph.getInOffsets();
+    const auto& inSources = graph.getInSources();
+    return isStronglyConnected(
+        std::vector<bool>(graph.getNodeCount(), true),
+        [&](std::uint64_t v, const auto& visit) {
+            for (auto k = outOffsets[v]; k < outOffsets[v + 1]; ++k) {
+                visit(outTargets[k]);
+            }
+        },
+        [&](std::uint64_t v, const auto& visit) {
+            for (auto k = inOffsets[v]; k < inOffsets[v + 1]; ++k) {
+                visit(inSources[k]);
+            }
+        });
 }
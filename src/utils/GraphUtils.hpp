@@ -1,22 +1,66 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
-#include "../core/Edge.hpp"
+#include "../core/CsrGraph.hpp"
 #include "../core/Graph.hpp"
-#include "../core/Node.hpp"
+
+// 刈り込みのモード
+enum class CleanMode {
+    SinkLess,  // 入次数または出次数が0のノードを繰り返し除去
+    Scc,       // 非自明な強連結成分 (2ノード以上，または自己ループを持つ) の和のみを残す
+};
 
 // 孤立ノードを削除した新しいGraphを生成する関数
-Graph cleanGraph(const Graph& graph);
-
-// ヘルパー関数の宣言
-std::pair<std::unordered_map<Node, int>, std::unordered_map<Node, int>> calcDegrees(
-    const Graph& graph);  // ノードの出次数と入次数を計算
-std::unordered_set<Node> removeZeroDegNodes(
-    const Graph& graph, std::unordered_map<Node, int>& outDeg,
-    std::unordered_map<Node, int>& inDeg);  // 孤立ノードを削除
-Graph buildGraph(const Graph& graph,
-                 const std::unordered_set<Node>& removed);  // 新しいグラフを構築
+Graph cleanGraph(const Graph& graph, CleanMode mode = CleanMode::SinkLess);
+
+// ヘルパー関数の宣言 (ノードはCsrGraphのIDで扱う)
+std::pair<std::vector<int>, std::vector<int>> calcDegrees(
+    const CsrGraph& graph);  // ノードの出次数と入次数を計算
+std::vector<bool> removeZeroDegNodes(const CsrGraph& graph, std::vector<int>& outDeg,
+                                     std::vector<int>& inDeg);  // 孤立ノードを削除
+std::vector<bool> removeTrivialSccNodes(
+    const CsrGraph& graph);  // 非自明な強連結成分に属さないノードを削除
+Graph buildGraph(const CsrGraph& graph,
+                 const std::vector<bool>& removed);  // 新しいグラフを構築
+
+// 強連結か (ノードがなければ false)
+bool isStronglyConnected(const CsrGraph& graph);
+
+// alive なノードが張る部分グラフが強連結か (alive なノードがなければ false)
+// 明示的な隣接リストを持たないグラフ用で，forEachSuccessor(v, visit) と
+// forEachPredecessor(v, visit) は v の後続・先行ノード w ごとに visit(w) を呼ぶ．
+// alive なノードの1つから前向き・後ろ向きに探索し，どちらもすべての alive なノードへ届くかを調べる．
+template <typename Successors, typename Predecessors>
+bool isStronglyConnected(const std::vector<bool>& alive, Successors forEachSuccessor,
+                         Predecessors forEachPredecessor) {
+    const auto root = std::find(alive.begin(), alive.end(), true);
+    if (root == alive.end()) {
+        return false;
+    }
+    const auto count = static_cast<std::uint64_t>(std::count(alive.begin(), alive.end(), true));
+
+    auto reachesAll = [&](auto forEachAdjacent) {
+        std::vector<bool> seen(alive.size(), false);
+        std::vector<std::uint64_t> pending{static_cast<std::uint64_t>(root - alive.begin())};
+        seen[pending[0]] = true;
+        std::uint64_t reached = 1;
+        while (!pending.empty()) {
+            const std::uint64_t current = pending.back();
+            pending.pop_back();
+            forEachAdjacent(current, [&](std::uint64_t next) {
+                if (alive[next] && !seen[next]) {
+                    seen[next] = true;
+                    ++reached;
+                    pending.push_back(next);
+                }
+            });
+        }
+        return reached == count;
+    };
+    return reachesAll(forEachSuccessor) && reachesAll(forEachPredecessor);
+}
@@ -0,0 +1,162 @@
+#include "SymmetryGroup.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+#include "../core/constants.hpp"
+
+std::string SymmetryGroup::Transform::toString(const std::string& alphabet) const {
+    std::string result;
+    for (unsigned int c : permutation) {
+        result += alphabet[c];
+    }
+    result += "/" + std::to_string(shift) + "/" + (reversed ? "r" : "-");
+    return result;
+}
+
+SymmetryGroup::SymmetryGroup(unsigned int alphabetSize, unsigned int wordLength,
+                             const std::vector<unsigned int>& position)
+    : alphabet(ALPHABET.substr(0, alphabetSize)),
+      wordLength(wordLength),
+      period(position.size()),
+      wordCount(1) {
+    if (period == 0) {
+        throw std::invalid_argument("Symmetry reduction requires forbidden.position.");
+    }
+    for (unsigned int i = 0; i < wordLength; ++i) {
+        wordCount *= alphabetSize;
+    }
+
+    // position を保つ位相の写像 ph -> ±ph + c
+    std::vector<std::pair<unsigned int, bool>> phaseTransforms;
+    for (int reversed = 0; reversed < 2; ++reversed) {
+        for (unsigned int shift = 0; shift < period; ++shift) {
+            std::vector<unsigned int> phaseMap(period);
+            bool compatible = true;
+            for (unsigned int ph = 0; ph < period; ++ph) {
+                // 反転: 位相 ph から始まる長さLの語は位相 -(ph + L - 1) から始まる語になる
+                long long base = reversed ? -static_cast<long long>(ph + wordLength - 1) : ph;
+                long long mapped = ((base + shift) % period + period) % period;
+                phaseMap[ph] = static_cast<unsigned int>(mapped);
+                compatible &= position[phaseMap[ph]] == position[ph];
+            }
+            if (compatible) {
+                phaseTransforms.emplace_back(shift, reversed);
+                phaseMaps.push_back(phaseMap);
+            }
+        }
+    }
+
+    // アルファベットの置換との直積
+    std::vector<std::vector<unsigned int>> phaseMapList;
+    phaseMapList.swap(phaseMaps);
+    std::vector<unsigned int> permutation(alphabetSize);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    do {
+        for (size_t t = 0; t < phaseTransforms.size(); ++t) {
+            Transform transform;
+            transform.permutation = permutation;
+            transform.shift = phaseTransforms[t].first;
+            transform.reversed = phaseTransforms[t].second;
+
+            // 語の写像 (先頭の文字が最上位桁)
+            std::vector<std::uint64_t> wordMap(wordCount);
+            std::vector<unsigned int> digits(wordLength);
+            for (std::uint64_t code = 0; code < wordCount; ++code) {
+                std::uint64_t rest = code;
+                for (size_t i = wordLength; i-- > 0;) {
+                    digits[i] = permutation[rest % alphabetSize];
+                    rest /= alphabetSize;
+                }
+                if (transform.reversed) {
+                    std::reverse(digits.begin(), digits.end());
+                }
+                std::uint64_t mapped = 0;
+                for (unsigned int d : digits) {
+                    mapped = mapped * alphabetSize + d;
+                }
+                wordMap[code] = mapped;
+            }
+
+            transforms.push_back(std::move(transform));
+            phaseMaps.push_back(phaseMapList[t]);
+            wordMaps.push_back(std::move(wordMap));
+        }
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+}
+
+// 禁止集合を (位相, 語) の昇順の番号列に変換
+SymmetryGroup::Key SymmetryGroup::toKey(const std::vector<Node>& nodes) const {
+    Key key;
+    key.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        const std::string& word = node.getLabel();
+        if (word.size() != wordLength || node.getPhase() >= period) {
+            throw std::invalid_argument("Forbidden word does not match the sweep: " + word);
+        }
+        std::uint64_t code = 0;
+        for (char c : word) {
+            auto digit = alphabet.find(c);
+            if (digit == std::string::npos) {
+                throw std::invalid_argument("Forbidden word contains a symbol outside the "
+                                            "alphabet: " + word);
+            }
+            code = code * alphabet.size() + digit;
+        }
+        key.push_back(node.getPhase() * wordCount + code);
+    }
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+std::vector<Node> SymmetryGroup::fromKey(const Key& key) const {
+    std::vector<Node> nodes;
+    nodes.reserve(key.size());
+    for (std::uint64_t value : key) {
+        std::uint64_t code = value % wordCount;
+        std::string word(wordLength, alphabet[0]);
+        for (size_t i = wordLength; i-- > 0;) {
+            word[i] = alphabet[code % alphabet.size()];
+            code /= alphabet.size();
+        }
+        nodes.emplace_back(word, value / wordCount);
+    }
+    return nodes;
+}
+
+SymmetryGroup::Key SymmetryGroup::applyToKey(size_t transform, const Key& key) const {
+    Key mapped;
+    mapped.reserve(key.size());
+    for (std::uint64_t value : key) {
+        unsigned int phase = phaseMaps[transform][value / wordCount];
+        mapped.push_back(phase * wordCount + wordMaps[transform][value % wordCount]);
+    }
+    std::sort(mapped.begin(), mapped.end());
+    return mapped;
+}
+
+// 禁止集合を変換
+std::vector<Node> SymmetryGroup::apply(size_t transform, const std::vector<Node>& nodes) const {
+    return fromKey(applyToKey(transform, toKey(nodes)));
+}
+
+// 軌道の代表元を求める
+std::vector<Node> SymmetryGroup::canonicalize(const std::vector<Node>& nodes, size_t& transform,
+                                              size_t& orbitSize) const {
+    const Key key = toKey(nodes);
+    std::set<Key> orbit;
+    Key best = key;
+    transform = 0;  // 恒等変換
+    for (size_t g = 0; g < transforms.size(); ++g) {
+        Key mapped = applyToKey(g, key);
+        if (mapped < best) {
+            best = mapped;
+            transform = g;
+        }
+        orbit.insert(std::move(mapped));
+    }
+    orbitSize = orbit.size();
+    return fromKey(best);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../core/Node.hpp"
+
+// 禁止集合に作用する対称性の群
+// 次の変換の合成で，位相ごとの禁止語の個数 (position) を保つものからなる:
+//   - アルファベットの置換 (k! 通り)
+//   - 位相の回転 ph -> ph + r
+//   - 語の反転 (時間反転) ph -> -(ph + L - 1)
+// 変換した禁止集合が定めるシフト空間は元と容量が等しい．
+// 禁止集合は (位相, 語) の昇順 (all-patternsの列挙順と同じ) で扱う．
+class SymmetryGroup {
+   public:
+    // 変換
+    struct Transform {
+        std::vector<unsigned int> permutation;  // 文字 c の移り先 permutation[c]
+        unsigned int shift = 0;                 // 位相の回転量
+        bool reversed = false;                  // 語を反転するか (反転後に回転)
+
+        // "<置換>/<回転量>/<反転>" 形式の文字列 (例: "102/1/r")
+        std::string toString(const std::string& alphabet) const;
+    };
+
+    SymmetryGroup(unsigned int alphabetSize, unsigned int wordLength,
+                  const std::vector<unsigned int>& position);
+
+    // 群の位数
+    size_t getOrder() const { return transforms.size(); }
+    const std::vector<Transform>& getTransforms() const { return transforms; }
+
+    // 禁止集合を変換 (結果は (位相, 語) の昇順)
+    std::vector<Node> apply(size_t transform, const std::vector<Node>& nodes) const;
+
+    // 軌道の代表元 (列挙順で最初の元) を求める
+    // transform には nodes を代表元に移す変換の番号，orbitSize には軌道の大きさを格納する．
+    std::vector<Node> canonicalize(const std::vector<Node>& nodes, size_t& transform,
+                                   size_t& orbitSize) const;
+
+   private:
+    using Key = std::vector<std::uint64_t>;  // 位相 * 語数 + 語の番号 の昇順の列
+
+    std::string alphabet;
+    unsigned int wordLength;
+    unsigned int period;
+    std::uint64_t wordCount;
+
+    std::vector<Transform> transforms;
+    std::vector<std::vector<unsigned int>> phaseMaps;   // phaseMaps[g][ph]
+    std::vector<std::vector<std::uint64_t>> wordMaps;   // wordMaps[g][語の番号]
+
+    Key toKey(const std::vector<Node>& nodes) const;
+    std::vector<Node> fromKey(const Key& key) const;
+    Key applyToKey(size_t transform, const Key& key) const;
+};
@@ -0,0 +1,116 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount, size_t maxPending) : maxPending(maxPending) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this, i] { run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// タスクを投入 (キューを順番に選ぶ)
+void ThreadPool::submit(Task task) {
+    size_t target;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        taskFinished.wait(lock, [&] { return maxPending == 0 || pending < maxPending; });
+        ++pending;
+        target = nextQueue;
+        nextQueue = (nextQueue + 1) % queues.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++queued;
+    }
+    taskAvailable.notify_one();
+}
+
+// すべてのタスクの完了を待つ
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    taskFinished.wait(lock, [&] { return pending == 0; });
+    if (error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+// 自分のキューの末尾，なければ他のキューの先頭からタスクを取り出す
+bool ThreadPool::tryPop(size_t worker, Task& task) {
+    {
+        auto& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); ++i) {
+        auto& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+// ワーカーの処理
+void ThreadPool::run(size_t worker) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [&] { return stopping || queued > 0; });
+            if (queued == 0) {
+                return;  // 停止要求かつタスクなし
+            }
+            --queued;  // 取り出す権利を予約
+        }
+
+        // 予約したので必ずどこかのキューにタスクがある
+        Task task;
+        while (!tryPop(worker, task)) {
+            std::this_thread::yield();
+        }
+
+        try {
+            task(worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --pending;
+        }
+        taskFinished.notify_all();
+    }
+}
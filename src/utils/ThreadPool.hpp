@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ワークスティーリング方式のスレッドプール
+// ワーカーごとにタスクの両端キューを持ち，自分のキューの末尾から取り出し，
+// 空になれば他のワーカーのキューの先頭から盗む．
+// 未完了のタスク数が上限に達している間は submit が待機するので，
+// 遅延列挙したタスクを投入し続けてもメモリ使用量は一定に保たれる．
+class ThreadPool {
+   public:
+    // タスク (引数は実行するワーカーの番号)
+    using Task = std::function<void(size_t)>;
+
+    // threadCount: ワーカー数 (0ならハードウェアの並列数)
+    // maxPending: 未完了タスク数の上限 (0なら無制限)
+    explicit ThreadPool(size_t threadCount, size_t maxPending = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // タスクを投入
+    void submit(Task task);
+
+    // すべてのタスクの完了を待つ (タスクが例外を投げていれば最初の例外を再送出)
+    void wait();
+
+    // ワーカー数
+    size_t getThreadCount() const { return workers.size(); }
+
+   private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable taskAvailable;  // タスクが投入された
+    std::condition_variable taskFinished;   // タスクが完了した
+    size_t pending = 0;                     // 未完了のタスク数
+    size_t queued = 0;                      // キュー内のタスク数
+    size_t maxPending;
+    size_t nextQueue = 0;  // 次に投入するキュー
+    bool stopping = false;
+    std::exception_ptr error;
+
+    bool tryPop(size_t worker, Task& task);
+    void run(size_t worker);
+};
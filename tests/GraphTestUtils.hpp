@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Graph.hpp"
+
+// テストで使うグラフの作成
+
+namespace test_utils {
+
+// 辺 (始点, 終点) と各ノードの位相からグラフを作成 (位相を省略するとすべて0)
+inline Graph makeGraph(const std::vector<std::pair<int, int>>& edges,
+                       const std::vector<unsigned int>& phases = {}) {
+    Graph graph;
+    auto node = [&](int v) {
+        return Node(std::to_string(v), phases.empty() ? 0 : phases[v]);
+    };
+    for (const auto& [src, tgt] : edges) {
+        graph.addEdge(Edge(node(src), node(tgt), "0"));
+    }
+    return graph;
+}
+
+}  // namespace test_utils
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "algorithm/SequenceEnumerator.hpp"
+#include "core/CsrGraph.hpp"
+
+// 系列の列挙・DAWG・符号のテストで使うグラフと列挙
+
+namespace test_utils {
+
+// 非決定的な (同じラベルの出辺が複数ある) 無作為なグラフ
+// 記号は labels の逆順に登録し，辞書順と登録順を変える．
+inline CsrGraph makeRandomGraph(std::mt19937& rng, unsigned int nodes,
+                                const std::vector<std::string>& labels) {
+    CsrGraph csr;
+    for (unsigned int v = 0; v < nodes; ++v) {
+        csr.addNode(std::to_string(v));
+    }
+    for (auto it = labels.rbegin(); it != labels.rend(); ++it) {
+        csr.addSymbol(*it);
+    }
+    std::uniform_int_distribution<unsigned int> node(0, nodes - 1);
+    std::uniform_int_distribution<CsrGraph::Id> symbol(0, labels.size() - 1);
+    for (unsigned int e = 0; e < 2 * nodes; ++e) {
+        csr.addEdge(node(rng), node(rng), symbol(rng));
+    }
+    return csr;
+}
+
+// SequenceEnumerator で長さLの系列を辞書順に集める (返す数が系列の数と一致するかも確かめる)
+inline std::vector<std::string> enumerate(const CsrGraph& csr, unsigned int length) {
+    std::vector<std::string> words;
+    SequenceEnumerator enumerator(csr);
+    const auto count =
+        enumerator.enumerate(length, [&](const std::string& word) { words.push_back(word); });
+    EXPECT_EQ(count, words.size());
+    return words;
+}
+
+}  // namespace test_utils
@@ -21,3 +21,47 @@ TEST(BealTest, GenerateNodes) {
         EXPECT_NE(edge.getSource(), Node("012", 0));
     }
 }
+
+TEST(BealTest, TransitionsFollowLongestSuffix) {
+    Beal beal(2, 1);
+
+    Graph graph = beal.generate({Node("10100", 0)});
+
+    // ノードは (ラベル, 位相) の昇順
+    std::vector<Node> expectedNodes = {Node("1", 0),    Node("10", 0),    Node("101", 0),
+                                       Node("1010", 0), Node("10100", 0), Node("E", 0)};
+    EXPECT_EQ(graph.getNodes(), expectedNodes);
+
+    // 1010 -1-> 10101 の最長の接尾辞ノードは 101
+    // 101  -1-> 1011  の最長の接尾辞ノードは 1
+    // 10   -0-> 100   は接尾辞ノードを持たないので空系列へ
+    int found = 0;
+    for (const auto& edge : graph.getEdges()) {
+        if (edge == Edge(Node("1010", 0), Node("101", 0), "1") ||
+            edge == Edge(Node("101", 0), Node("1", 0), "1") ||
+            edge == Edge(Node("10", 0), Node("E", 0), "0")) {
+            found++;
+        }
+    }
+    EXPECT_EQ(found, 3);
+    EXPECT_EQ(graph.getEdges().size(), 10);  // 禁止ノード以外の5ノード * 2
+}
+
+TEST(BealTest, PhaseOfSuffixNode) {
+    Beal beal(2, 3);
+
+    // 位相1から始まる "01" と 位相2から始まる "1"
+    Graph graph = beal.generate({Node("01", 1), Node("1", 2)});
+
+    // (0,1) -0-> 接尾辞 "00", "0" はどちらもノードでないので位相0の空系列へ
+    // (E,1) -1-> 位相1から始まる "1" はノードでないので位相2の空系列へ
+    // (E,2) -1-> 位相2から始まる "1" は禁止語
+    std::vector<Edge> expected = {Edge(Node("0", 1), Node("01", 1), "1"),
+                                  Edge(Node("0", 1), Node("E", 0), "0"),
+                                  Edge(Node("E", 1), Node("E", 2), "1"),
+                                  Edge(Node("E", 2), Node("1", 2), "1")};
+    for (const auto& edge : expected) {
+        const auto& edges = graph.getEdges();
+        EXPECT_NE(std::find(edges.begin(), edges.end(), edge), edges.end()) << edge;
+    }
+}
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include "utils/BigUint.hpp"
+
+#include <random>
+
+// BigUint クラスのテスト
+
+TEST(BigUintTest, MatchesNativeArithmetic) {
+    std::mt19937_64 rng(3);
+    for (int trial = 0; trial < 200; ++trial) {
+        const std::uint64_t a = rng() >> (trial % 64);
+        const std::uint64_t b = rng() >> ((trial * 7) % 64);
+        const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+
+        BigUint x(a), y(b);
+        BigUint expectedProduct = BigUint(static_cast<std::uint64_t>(product >> 64));
+        expectedProduct *= BigUint(std::uint64_t{1} << 32) * BigUint(std::uint64_t{1} << 32);
+        expectedProduct += static_cast<std::uint64_t>(product);
+        EXPECT_EQ(x * y, expectedProduct);
+        EXPECT_EQ(x + y - y, x);
+        EXPECT_EQ(BigUint::compare(x, y), a < b ? -1 : (a > b ? 1 : 0));
+        EXPECT_EQ(x.toString(), std::to_string(a));
+        EXPECT_EQ(BigUint::fromString(std::to_string(b)), y);
+        EXPECT_EQ(x.toUint64(), a);
+    }
+}
+
+TEST(BigUintTest, LargeValues) {
+    // 2^100 と 10^30
+    BigUint power(1);
+    for (int i = 0; i < 100; ++i) {
+        power *= 2u;
+    }
+    EXPECT_EQ(power.toString(), "1267650600228229401496703205376");
+    EXPECT_EQ(power.getBitLength(), 101u);
+    EXPECT_FALSE(power.fitsUint64());
+    EXPECT_THROW(power.toUint64(), std::overflow_error);
+
+    const BigUint ten30 = BigUint::fromString("1000000000000000000000000000000");
+    EXPECT_EQ(ten30.toString(), "1000000000000000000000000000000");
+    EXPECT_EQ((power - ten30).toString(), "267650600228229401496703205376");
+    EXPECT_LT(ten30, power);
+
+    // 10^30 を 10^9 で割る
+    BigUint quotient = ten30;
+    EXPECT_EQ(quotient.divide(1000000000u), 0u);
+    EXPECT_EQ(quotient.toString(), "1000000000000000000000");
+    EXPECT_EQ(BigUint::fromString("000123").toString(), "123");
+}
+
+TEST(BigUintTest, Bits) {
+    BigUint value;
+    value.setBit(100);
+    value.setBit(3);
+    value.setBit(3);
+    BigUint expected(8);
+    BigUint power(1);
+    for (int i = 0; i < 100; ++i) {
+        power *= 2u;
+    }
+    expected += power;
+    EXPECT_EQ(value, expected);
+    EXPECT_EQ(value.getBitLength(), 101u);
+    for (size_t i = 0; i < 160; ++i) {
+        EXPECT_EQ(value.testBit(i), i == 3 || i == 100) << i;
+    }
+    EXPECT_FALSE(BigUint().testBit(0));
+}
+
+TEST(BigUintTest, ZeroAndErrors) {
+    BigUint zero;
+    EXPECT_TRUE(zero.isZero());
+    EXPECT_EQ(zero.toString(), "0");
+    EXPECT_EQ(zero.getBitLength(), 0u);
+    EXPECT_EQ(zero, BigUint(0));
+    EXPECT_EQ(BigUint(5) - BigUint(5), zero);
+    EXPECT_EQ(BigUint(12345) * zero, zero);
+
+    EXPECT_THROW(BigUint(3) - BigUint(4), std::underflow_error);
+    EXPECT_THROW(BigUint::fromString(""), std::invalid_argument);
+    EXPECT_THROW(BigUint::fromString("12a"), std::invalid_argument);
+    EXPECT_THROW(BigUint(1).divide(0), std::invalid_argument);
+}
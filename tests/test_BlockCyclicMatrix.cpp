@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include "algorithm/Beal.hpp"
+#include "algorithm/DeBruijn.hpp"
+#include "analysis/BlockCyclicMatrix.hpp"
+#include "analysis/PathCounter.hpp"
+#include "analysis/eigenvalues.hpp"
+
+// BlockCyclicMatrix クラスのテスト
+
+namespace {
+
+// 隣接行列全体から最大固有値を計算 (比較用)
+double calcDenseMaxEigenvalue(const CsrGraph& csr) {
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(csr.getNodeCount(), csr.getNodeCount());
+    for (size_t e = 0; e < csr.getEdgeCount(); ++e) {
+        matrix(csr.getEdgeSource(e), csr.getEdgeTarget(e)) += 1;
+    }
+    return calculateMaxEigenvalue(matrix);
+}
+
+// 全ノードからの幅優先探索で長さLの経路数を数える (比較用)
+std::uint64_t countPathsByEnumeration(const CsrGraph& csr, unsigned int length) {
+    const auto& offsets = csr.getOutOffsets();
+    const auto& targets = csr.getOutTargets();
+    std::vector<std::uint64_t> count(csr.getNodeCount(), 1), next(csr.getNodeCount());
+    for (unsigned int step = 0; step < length; ++step) {
+        for (CsrGraph::Id v = 0; v < csr.getNodeCount(); ++v) {
+            next[v] = 0;
+            for (auto k = offsets[v]; k < offsets[v + 1]; ++k) {
+                next[v] += count[targets[k]];
+            }
+        }
+        count.swap(next);
+    }
+    std::uint64_t total = 0;
+    for (auto c : count) {
+        total += c;
+    }
+    return total;
+}
+
+}  // namespace
+
+TEST(BlockCyclicMatrixTest, DetectsPhaseStructure) {
+    DeBruijn generator(2, 3, 2);
+    Graph graph = generator.generate({Node("00", 0), Node("11", 2)});
+
+    auto blockMatrix = BlockCyclicMatrix::fromGraph(graph.getCsr());
+    ASSERT_TRUE(blockMatrix.has_value());
+    EXPECT_EQ(blockMatrix->getPeriod(), 3);
+    EXPECT_EQ(blockMatrix->getPhaseSize(0), 3);
+    EXPECT_EQ(blockMatrix->getPhaseSize(1), 4);
+    EXPECT_EQ(blockMatrix->getPhaseSize(2), 3);
+    EXPECT_EQ(blockMatrix->getBlock(0).rows(), 3);
+    EXPECT_EQ(blockMatrix->getBlock(0).cols(), 4);
+}
+
+TEST(BlockCyclicMatrixTest, RejectsNonCyclicGraphs) {
+    // 周期1
+    Graph single;
+    single.addEdge(Edge(Node("A", 0), Node("B", 0), "a"));
+    EXPECT_FALSE(BlockCyclicMatrix::fromGraph(single.getCsr()).has_value());
+
+    // 位相を飛ばす辺を含む
+    Graph skip;
+    skip.addEdge(Edge(Node("A", 0), Node("B", 1), "a"));
+    skip.addEdge(Edge(Node("B", 1), Node("A", 0), "b"));
+    skip.addEdge(Edge(Node("B", 1), Node("C", 2), "c"));
+    skip.addEdge(Edge(Node("C", 2), Node("C", 2), "d"));
+    EXPECT_FALSE(BlockCyclicMatrix::fromGraph(skip.getCsr()).has_value());
+
+    // 空グラフ
+    EXPECT_FALSE(BlockCyclicMatrix::fromGraph(CsrGraph()).has_value());
+}
+
+TEST(BlockCyclicMatrixTest, EigenvalueMatchesDenseSolver) {
+    DeBruijn deBruijn(2, 3, 3);
+    Beal beal(3, 2);
+    std::vector<Graph> graphs = {
+        deBruijn.generate({}),
+        deBruijn.generate({Node("000", 0), Node("011", 1), Node("110", 2)}),
+        beal.generate({Node("01", 0), Node("2", 1)}),
+        beal.generate({Node("0", 0), Node("11", 1)}),
+    };
+
+    for (const auto& graph : graphs) {
+        auto blockMatrix = BlockCyclicMatrix::fromGraph(graph.getCsr());
+        ASSERT_TRUE(blockMatrix.has_value());
+        double expected = calcDenseMaxEigenvalue(graph.getCsr());
+        EXPECT_NEAR(blockMatrix->calcMaxEigenvalue(), expected, 1e-6);
+        EXPECT_NEAR(calculateMaxEigenvalue(graph), expected, 1e-6);
+    }
+    EXPECT_NEAR(calculateMaxEigenvalue(graphs[0]), 2.0, 1e-6);
+}
+
+TEST(BlockCyclicMatrixTest, EmptyPhaseHasZeroEigenvalue) {
+    // 位相0のノードがすべて禁止されている
+    DeBruijn generator(2, 2, 1);
+    Graph graph = generator.generate({Node("0", 0), Node("1", 0)});
+
+    auto blockMatrix = BlockCyclicMatrix::fromGraph(graph.getCsr());
+    ASSERT_TRUE(blockMatrix.has_value());
+    EXPECT_DOUBLE_EQ(blockMatrix->calcMaxEigenvalue(), 0.0);
+}
+
+TEST(BlockCyclicMatrixTest, CountPathsMatchesEnumeration) {
+    DeBruijn generator(2, 3, 2);
+    Graph graph = generator.generate({Node("01", 0), Node("11", 1)});
+
+    auto blockMatrix = BlockCyclicMatrix::fromGraph(graph.getCsr());
+    ASSERT_TRUE(blockMatrix.has_value());
+    EXPECT_EQ(blockMatrix->countPathsOfLength(0), 0);
+    for (unsigned int length = 1; length <= 8; ++length) {
+        EXPECT_EQ(blockMatrix->countPathsOfLength(length),
+                  countPathsByEnumeration(graph.getCsr(), length));
+        EXPECT_EQ(PathCounter(graph.getCsr()).count(length).toUint64(),
+                  countPathsByEnumeration(graph.getCsr(), length));
+    }
+}
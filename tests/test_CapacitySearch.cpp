@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "algorithm/GeneratorFactory.hpp"
+#include "analysis/CapacitySearch.hpp"
+#include "io/Input.hpp"
+
+#include <algorithm>
+
+// CapacitySearch クラスのテスト
+
+namespace {
+
+io::type::Config makeConfig(const std::string& algorithm, unsigned int alphabet,
+                            unsigned int length, const std::vector<unsigned int>& position) {
+    io::type::Config config;
+    config.generation.mode = "all-patterns";
+    config.generation.algorithm = algorithm;
+    config.generation.opt_mode = "none";
+    config.generation.alphabet = alphabet;
+    config.generation.period = position.size();
+    config.generation.forbidden.length = length;
+    config.generation.forbidden.position = position;
+    return config;
+}
+
+// 全件の最大固有値 (列挙順)
+std::vector<double> calcAll(const io::type::Config& config, const GraphGenerator& generator) {
+    std::vector<double> values;
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    while (enumerator.next()) {
+        values.push_back(calculateMaxEigenvalue(generator.generateTrimmed(enumerator.get())));
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST(CapacitySearchTest, MatchesExhaustiveSweep) {
+    for (const auto& config : {makeConfig("DeBruijn", 2, 3, {2, 1}),
+                               makeConfig("Beal", 2, 3, {1, 2}),
+                               makeConfig("DeBruijn", 3, 2, {1, 0, 2})}) {
+        auto generator = GeneratorFactory::create(config);
+        const auto all = calcAll(config, *generator);
+        auto sorted = all;
+        std::sort(sorted.rbegin(), sorted.rend());
+
+        for (size_t k : {1u, 3u, 10u}) {
+            CapacitySearch search(config, *generator);
+            const auto results = search.run(k);
+            ASSERT_EQ(results.size(), std::min(k, all.size()));
+            for (size_t i = 0; i < results.size(); ++i) {
+                EXPECT_NEAR(results[i].maxEigenvalue, sorted[i], 1e-8);
+                // 番号は列挙順の位置と一致する
+                io::input::ForbiddenSetEnumerator enumerator(config);
+                enumerator.seek(results[i].index);
+                ASSERT_TRUE(enumerator.next());
+                EXPECT_EQ(enumerator.get(), results[i].forbiddenNodes);
+                EXPECT_NEAR(all[results[i].index], results[i].maxEigenvalue, 1e-8);
+            }
+        }
+    }
+}
+
+TEST(CapacitySearchTest, PrunesSubtrees) {
+    auto config = makeConfig("DeBruijn", 2, 3, {3, 3});
+    auto generator = GeneratorFactory::create(config);
+    CapacitySearch search(config, *generator);
+    const auto results = search.run(1);
+    ASSERT_EQ(results.size(), 1u);
+
+    const std::uint64_t total = io::input::ForbiddenSetEnumerator(config).getCount();
+    const auto& stats = search.getStats();
+    EXPECT_LT(stats.evaluated, total);
+    EXPECT_GT(stats.degreePruned + stats.boundPruned, 0u);
+}
+
+TEST(CapacitySearchTest, AcceptFiltersLeaves) {
+    auto config = makeConfig("DeBruijn", 2, 2, {1, 1});
+    auto generator = GeneratorFactory::create(config);
+    CapacitySearch search(config, *generator);
+    auto accept = [](const std::vector<Node>& nodes) { return nodes.front().getLabel() != "00"; };
+    const auto results = search.run(16, accept);
+    EXPECT_EQ(results.size(), 12u);
+    EXPECT_EQ(search.getStats().rejected, 4u);
+    for (const auto& result : results) {
+        EXPECT_TRUE(accept(result.forbiddenNodes));
+    }
+}
+
+TEST(CapacitySearchTest, EmptyPositionsAndZeroK) {
+    auto config = makeConfig("DeBruijn", 2, 2, {0, 0});
+    auto generator = GeneratorFactory::create(config);
+    CapacitySearch search(config, *generator);
+    EXPECT_TRUE(search.run(0).empty());
+
+    const auto results = search.run(5);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_TRUE(results[0].forbiddenNodes.empty());
+    EXPECT_EQ(results[0].index, 0u);
+    EXPECT_NEAR(results[0].maxEigenvalue, 2.0, 1e-8);
+}
+
+TEST(CapacitySearchTest, RejectsCustomMode) {
+    auto config = makeConfig("DeBruijn", 2, 2, {1});
+    config.generation.mode = "custom";
+    auto generator = GeneratorFactory::create(config);
+    EXPECT_THROW(CapacitySearch(config, *generator), std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "GraphTestUtils.hpp"
+#include "analysis/CapacityWindow.hpp"
+#include "core/Graph.hpp"
+
+#include <cmath>
+
+// CapacityWindow クラスのテスト
+
+namespace {
+
+using Decision = CapacityWindow::Decision;
+using test_utils::makeGraph;
+
+PerronRoot makeBounds(double lower, double upper) {
+    PerronRoot bounds;
+    bounds.lower = lower;
+    bounds.upper = upper;
+    return bounds;
+}
+
+}  // namespace
+
+TEST(CapacityWindowTest, ClassifiesBounds) {
+    // 容量 [0.5, 1] は最大固有値 [sqrt(2), 2]
+    CapacityWindow window(0.5, 1.0);
+    EXPECT_TRUE(window.isBounded());
+    EXPECT_EQ(window.classify(makeBounds(1.5, 1.9)), Decision::Inside);
+    EXPECT_EQ(window.classify(makeBounds(1.0, 1.3)), Decision::Outside);
+    EXPECT_EQ(window.classify(makeBounds(2.1, 3.0)), Decision::Outside);
+    EXPECT_EQ(window.classify(makeBounds(1.3, 1.5)), Decision::Unknown);
+    EXPECT_EQ(window.classify(makeBounds(1.9, 2.1)), Decision::Unknown);
+    EXPECT_EQ(window.classify(makeBounds(0.0, 0.0)), Decision::Outside);
+}
+
+TEST(CapacityWindowTest, ClassifiesValuesWithTolerance) {
+    // 範囲の端の値は許容誤差の分だけ範囲内とみなす
+    CapacityWindow window(1.0, 1.0, 1e-10);
+    EXPECT_EQ(window.classify(2.0), Decision::Inside);
+    EXPECT_EQ(window.classify(2.0 * (1.0 - 1e-12)), Decision::Inside);
+    EXPECT_EQ(window.classify(2.0 * (1.0 + 1e-12)), Decision::Inside);
+    EXPECT_EQ(window.classify(1.99), Decision::Outside);
+
+    // 容量は最大固有値が1以下なら0
+    EXPECT_EQ(CapacityWindow::calcCapacity(0.0), 0.0);
+    EXPECT_EQ(CapacityWindow::calcCapacity(1.0), 0.0);
+    EXPECT_DOUBLE_EQ(CapacityWindow::calcCapacity(4.0), 2.0);
+    EXPECT_EQ(CapacityWindow(-1.0, 0.0).classify(0.0), Decision::Inside);
+}
+
+TEST(CapacityWindowTest, ClassifiesGraphs) {
+    // 黄金比 (容量 0.694...)
+    Graph golden = makeGraph({{0, 0}, {0, 1}, {1, 0}});
+    const double capacity = std::log2((1.0 + std::sqrt(5.0)) / 2.0);
+    EXPECT_EQ(CapacityWindow(capacity - 0.01, capacity + 0.01).classify(golden), Decision::Inside);
+    EXPECT_EQ(CapacityWindow(0.8).classify(golden), Decision::Outside);
+    EXPECT_EQ(CapacityWindow(0.0, 0.6).classify(golden), Decision::Outside);
+    // 次数の上下界 [1, 2] だけで決まる
+    EXPECT_EQ(CapacityWindow(0.0, 1.0).classify(golden), Decision::Inside);
+    EXPECT_EQ(CapacityWindow(1.5).classify(golden), Decision::Outside);
+
+    // 範囲の指定がなければ常に範囲内
+    CapacityWindow unbounded;
+    EXPECT_FALSE(unbounded.isBounded());
+    EXPECT_EQ(unbounded.classify(golden), Decision::Inside);
+    EXPECT_FALSE(CapacityWindow(0.0).isBounded());
+}
+
+TEST(CapacityWindowTest, RejectsInvertedWindow) {
+    EXPECT_THROW(CapacityWindow(1.0, 0.5), std::invalid_argument);
+    EXPECT_THROW(CapacityWindow(std::nan(""), 1.0), std::invalid_argument);
+}
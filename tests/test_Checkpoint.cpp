@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "io/Checkpoint.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include "nlohmann/json.hpp"
+
+// Checkpoint クラスのテスト
+
+namespace {
+
+class CheckpointTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        directory = (std::filesystem::temp_directory_path() /
+                     ("pft-checkpoint-test-" +
+                      std::to_string(::testing::UnitTest::GetInstance()->random_seed())))
+                        .string();
+        std::filesystem::remove_all(directory);
+        path = directory + "/checkpoint.json";
+    }
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    std::string directory;
+    std::string path;
+};
+
+}  // namespace
+
+TEST_F(CheckpointTest, CompactsCompletedPrefix) {
+    io::Checkpoint checkpoint(path, "config", std::chrono::seconds(3600));
+    checkpoint.markCompleted(1);
+    checkpoint.markCompleted(3);
+    EXPECT_FALSE(checkpoint.isCompleted(0));
+    EXPECT_TRUE(checkpoint.isCompleted(1));
+    EXPECT_EQ(checkpoint.getCompletedCount(), 2);
+
+    checkpoint.markCompleted(0);
+    checkpoint.markCompleted(2);
+    checkpoint.save();
+
+    nlohmann::json data;
+    std::ifstream(path) >> data;
+    EXPECT_EQ(data["completed_prefix"], 4);
+    EXPECT_TRUE(data["completed"].empty());
+    EXPECT_FALSE(data["finished"]);
+}
+
+TEST_F(CheckpointTest, SaveAndLoad) {
+    {
+        io::Checkpoint checkpoint(path, "config", std::chrono::seconds(3600));
+        EXPECT_FALSE(checkpoint.load());
+        for (std::uint64_t i : {0, 1, 2, 5, 7}) {
+            checkpoint.markCompleted(i);
+        }
+        checkpoint.save(true);
+    }
+
+    io::Checkpoint resumed(path, "config", std::chrono::seconds(3600));
+    ASSERT_TRUE(resumed.load());
+    EXPECT_EQ(resumed.getCompletedCount(), 5);
+    for (std::uint64_t i = 0; i < 9; ++i) {
+        EXPECT_EQ(resumed.isCompleted(i), i <= 2 || i == 5 || i == 7) << i;
+    }
+
+    // 設定が異なるチェックポイントは使わない
+    io::Checkpoint other(path, "other", std::chrono::seconds(3600));
+    EXPECT_THROW(other.load(), std::runtime_error);
+}
+
+TEST_F(CheckpointTest, SavesPeriodically) {
+    io::Checkpoint checkpoint(path, "config", std::chrono::seconds(0));
+    checkpoint.markCompleted(0);
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    io::Checkpoint resumed(path, "config", std::chrono::seconds(0));
+    ASSERT_TRUE(resumed.load());
+    EXPECT_TRUE(resumed.isCompleted(0));
+}
+
+TEST(CheckpointFingerprintTest, DependsOnSweep) {
+    io::type::Config config;
+    config.generation.mode = "all-patterns";
+    config.generation.algorithm = "Beal";
+    config.generation.opt_mode = "none";
+    config.generation.alphabet = 2;
+    config.generation.period = 2;
+    config.generation.forbidden.length = 2;
+    config.generation.forbidden.position = {1, 2};
+    config.output.output_dir = "OUT";
+
+    auto fingerprint = io::Checkpoint::genFingerprint(config);
+    config.generation.forbidden.position = {2, 1};
+    EXPECT_NE(io::Checkpoint::genFingerprint(config), fingerprint);
+}
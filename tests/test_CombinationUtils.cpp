@@ -1,5 +1,6 @@
 #include "utils/CombinationUtils.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -70,3 +71,143 @@ TEST(StringCombinationUtilsTest, CombineWithRep) {
 
     EXPECT_EQ(results, expected);
 }
+
+TEST(CombinationUtilsTest, Binomial) {
+    EXPECT_EQ(binomial(5, 2), 10u);
+    EXPECT_EQ(binomial(5, 0), 1u);
+    EXPECT_EQ(binomial(3, 4), 0u);
+    EXPECT_EQ(binomial(64, 32), 1832624140942590534ull);
+    EXPECT_THROW(binomial(200, 100), std::overflow_error);
+}
+
+TEST(CombinationUtilsTest, UnrankMatchesCombineNoRep) {
+    std::vector<unsigned int> elems = {0, 1, 2, 3, 4, 5};
+    auto expected = combineNoRep(elems, 3);
+    ASSERT_EQ(expected.size(), binomial(6, 3));
+    for (std::uint64_t rank = 0; rank < expected.size(); ++rank) {
+        EXPECT_EQ(unrankCombination(rank, 6, 3), expected[rank]);
+    }
+}
+
+TEST(CombinationUtilsTest, RankInvertsUnrank) {
+    for (unsigned int m = 0; m <= 7; ++m) {
+        for (unsigned int n = 0; n <= m; ++n) {
+            for (std::uint64_t rank = 0; rank < binomial(m, n); ++rank) {
+                EXPECT_EQ(rankCombination(unrankCombination(rank, m, n), m), rank);
+            }
+        }
+    }
+}
+
+TEST(CombinationUtilsTest, NextCombinationReportsChangedPosition) {
+    std::vector<unsigned int> indices = {0, 3, 4};
+    EXPECT_EQ(nextCombination(indices, 5), 0u);
+    EXPECT_EQ(indices, (std::vector<unsigned int>{1, 2, 3}));
+    EXPECT_EQ(nextCombination(indices, 5), 2u);
+    EXPECT_EQ(indices, (std::vector<unsigned int>{1, 2, 4}));
+
+    indices = {2, 3, 4};
+    EXPECT_EQ(nextCombination(indices, 5), COMBINATION_END);
+}
+
+TEST(CombinationUtilsTest, SubsetMaskColexOrder) {
+    for (unsigned int m = 0; m <= 8; ++m) {
+        for (unsigned int n = 0; n <= m; ++n) {
+            std::vector<std::uint64_t> masks;
+            forEachSubsetMask(m, n, [&](std::uint64_t mask) { masks.push_back(mask); });
+            ASSERT_EQ(masks.size(), binomial(m, n)) << m << " " << n;
+            for (size_t i = 0; i < masks.size(); ++i) {
+                EXPECT_EQ(__builtin_popcountll(masks[i]), static_cast<int>(n));
+                EXPECT_LT(masks[i], std::uint64_t{1} << m);
+                if (i > 0) {
+                    EXPECT_LT(masks[i - 1], masks[i]);
+                }
+            }
+        }
+    }
+
+    size_t count = 0;
+    forEachSubsetMask(64, 63, [&](std::uint64_t) { ++count; });
+    EXPECT_EQ(count, 64u);
+}
+
+TEST(CombinationUtilsTest, RevolvingDoorSwapsOneElement) {
+    for (unsigned int m = 0; m <= 8; ++m) {
+        for (unsigned int n = 0; n <= m; ++n) {
+            std::vector<std::uint64_t> masks;
+            forEachRevolvingDoor(m, n, [&](const std::vector<unsigned int>& indices) {
+                ASSERT_EQ(indices.size(), n);
+                std::uint64_t mask = 0;
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    if (i > 0) {
+                        EXPECT_LT(indices[i - 1], indices[i]);
+                    }
+                    mask |= std::uint64_t{1} << indices[i];
+                }
+                masks.push_back(mask);
+            });
+
+            ASSERT_EQ(masks.size(), binomial(m, n)) << m << " " << n;
+            std::vector<std::uint64_t> sorted(masks);
+            std::sort(sorted.begin(), sorted.end());
+            EXPECT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+            for (size_t i = 1; i < masks.size(); ++i) {
+                EXPECT_EQ(__builtin_popcountll(masks[i - 1] ^ masks[i]), 2) << m << " " << n;
+            }
+        }
+    }
+}
+
+TEST(CombinationUtilsTest, TupleOdometerAndEarlyStop) {
+    std::vector<std::vector<unsigned int>> tuples;
+    forEachTuple(3, 2, [&](const std::vector<unsigned int>& digits) { tuples.push_back(digits); });
+    ASSERT_EQ(tuples.size(), 9u);
+    EXPECT_EQ(tuples[1], (std::vector<unsigned int>{0, 1}));
+    EXPECT_EQ(tuples[3], (std::vector<unsigned int>{1, 0}));
+
+    // false を返すと打ち切る
+    size_t visited = 0;
+    forEachCombination(6, 3, [&](const std::vector<unsigned int>&) { return ++visited < 5; });
+    EXPECT_EQ(visited, 5u);
+}
+
+TEST(CombinationUtilsTest, RevolvingDoorRankMatchesOrder) {
+    for (unsigned int m = 0; m <= 8; ++m) {
+        for (unsigned int n = 0; n <= m; ++n) {
+            std::uint64_t expected = 0;
+            std::vector<unsigned int> unranked(n);
+            forEachRevolvingDoor(m, n, [&](const std::vector<unsigned int>& indices) {
+                EXPECT_EQ(rankRevolvingDoor(indices), expected) << m << " " << n;
+                unrankRevolvingDoor(expected, m, unranked);
+                EXPECT_EQ(unranked, indices) << m << " " << n;
+                ++expected;
+            });
+        }
+    }
+}
+
+TEST(CombinationUtilsTest, RevolvingDoorStepsBothWays) {
+    for (unsigned int m = 0; m <= 9; ++m) {
+        for (unsigned int n = 0; n <= m; ++n) {
+            std::vector<std::vector<unsigned int>> order;
+            forEachRevolvingDoor(m, n, [&](const std::vector<unsigned int>& indices) {
+                order.push_back(indices);
+            });
+
+            std::vector<unsigned int> indices = order.front();
+            for (size_t i = 1; i < order.size(); ++i) {
+                ASSERT_TRUE(nextRevolvingDoor(indices, m)) << m << " " << n;
+                EXPECT_EQ(indices, order[i]) << m << " " << n;
+            }
+            EXPECT_FALSE(nextRevolvingDoor(indices, m));
+            EXPECT_EQ(indices, order.back());
+
+            for (size_t i = order.size() - 1; i-- > 0;) {
+                ASSERT_TRUE(prevRevolvingDoor(indices, m)) << m << " " << n;
+                EXPECT_EQ(indices, order[i]) << m << " " << n;
+            }
+            EXPECT_FALSE(prevRevolvingDoor(indices, m));
+            EXPECT_EQ(indices, order.front());
+        }
+    }
+}
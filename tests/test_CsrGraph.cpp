@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "core/CsrGraph.hpp"
+
+// CsrGraph クラスのテスト
+
+TEST(CsrGraphTest, AddNodeAndSymbol) {
+    CsrGraph graph;
+    EXPECT_EQ(graph.addNode("00", 0), 0);
+    EXPECT_EQ(graph.addNode("01", 1), 1);
+    EXPECT_EQ(graph.getNodeCount(), 2);
+    EXPECT_EQ(graph.getLabel(1), "01");
+    EXPECT_EQ(graph.getPhase(1), 1);
+
+    // 同じ辺ラベルは同じIDに解決される
+    EXPECT_EQ(graph.addSymbol("0"), 0);
+    EXPECT_EQ(graph.addSymbol("1"), 1);
+    EXPECT_EQ(graph.addSymbol("0"), 0);
+    EXPECT_EQ(graph.getSymbolCount(), 2);
+}
+
+TEST(CsrGraphTest, OutEdgesAreGroupedBySource) {
+    CsrGraph graph;
+    auto a = graph.addNode("A");
+    auto b = graph.addNode("B");
+    auto c = graph.addNode("C");
+    auto x = graph.addSymbol("x");
+    auto y = graph.addSymbol("y");
+
+    graph.addEdge(c, a, x);
+    graph.addEdge(a, b, x);
+    graph.addEdge(a, c, y);
+    graph.addEdge(b, c, x);
+
+    const auto& offsets = graph.getOutOffsets();
+    const auto& targets = graph.getOutTargets();
+    const auto& symbols = graph.getOutSymbols();
+
+    ASSERT_EQ(offsets, (std::vector<CsrGraph::Id>{0, 2, 3, 4}));
+    EXPECT_EQ(targets, (std::vector<CsrGraph::Id>{b, c, c, a}));
+    EXPECT_EQ(symbols, (std::vector<CsrGraph::Id>{x, y, x, x}));
+
+    // 追加順のエッジも保持される
+    EXPECT_EQ(graph.getEdgeSource(0), c);
+    EXPECT_EQ(graph.getEdgeTarget(0), a);
+}
+
+TEST(CsrGraphTest, Subgraph) {
+    CsrGraph graph;
+    auto a = graph.addNode("A");
+    auto b = graph.addNode("B");
+    auto c = graph.addNode("C");
+    auto x = graph.addSymbol("x");
+
+    graph.addEdge(a, b, x);
+    graph.addEdge(b, c, x);
+    graph.addEdge(c, a, x);
+
+    CsrGraph sub = graph.subgraph({true, false, true});
+
+    ASSERT_EQ(sub.getNodeCount(), 2);
+    EXPECT_EQ(sub.getLabel(0), "A");
+    EXPECT_EQ(sub.getLabel(1), "C");
+    ASSERT_EQ(sub.getEdgeCount(), 1);
+    EXPECT_EQ(sub.getEdgeSource(0), 1);
+    EXPECT_EQ(sub.getEdgeTarget(0), 0);
+    EXPECT_EQ(sub.getSymbol(sub.getEdgeSymbol(0)), "x");
+}
+
+TEST(CsrGraphTest, InEdges) {
+    CsrGraph graph;
+    auto a = graph.addNode("A");
+    auto b = graph.addNode("B");
+    auto c = graph.addNode("C");
+    auto x = graph.addSymbol("x");
+
+    graph.addEdge(a, c, x);
+    graph.addEdge(b, c, x);
+    graph.addEdge(c, a, x);
+
+    EXPECT_EQ(graph.getInOffsets(), (std::vector<CsrGraph::Id>{0, 1, 1, 3}));
+    EXPECT_EQ(graph.getInSources(), (std::vector<CsrGraph::Id>{c, a, b}));
+}
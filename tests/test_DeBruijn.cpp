@@ -42,3 +42,31 @@ TEST(DeBruijnTest, GenerateGraphWithForbiddenNodes) {
         EXPECT_TRUE(std::find(forbiddenNodes.begin(), forbiddenNodes.end(), edge.getTarget()) == forbiddenNodes.end());
     }
 }
+
+TEST(DeBruijnTest, SuccessorsShiftWordAndPhase) {
+    DeBruijn generator(2, 3, 3);
+    Graph graph = generator.generate({});
+
+    // (011, 2) からの遷移は (11c, 0)
+    std::vector<Edge> expected = {Edge(Node("011", 2), Node("110", 0), "0"),
+                                  Edge(Node("011", 2), Node("111", 0), "1")};
+    std::vector<Edge> actual;
+    for (const auto& edge : graph.getEdges()) {
+        if (edge.getSource() == Node("011", 2)) {
+            actual.push_back(edge);
+        }
+    }
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(DeBruijnTest, GenerateLargeGraph) {
+    // アルファベット4，語長6，周期4
+    DeBruijn generator(4, 4, 6);
+
+    std::vector<Node> forbiddenNodes = {Node("000000", 0), Node("333333", 3)};
+    Graph graph = generator.generate(forbiddenNodes);
+
+    EXPECT_EQ(graph.getCsr().getNodeCount(), 4096 * 4 - 2);
+    // 各禁止ノードは自己ループを持たない4本の出辺と4本の入辺を失う
+    EXPECT_EQ(graph.getCsr().getEdgeCount(), 4096 * 4 * 4 - 2 * 8);
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "algorithm/DeBruijn.hpp"
+#include "algorithm/DeBruijnView.hpp"
+#include "analysis/PathCounter.hpp"
+#include "analysis/eigenvalues.hpp"
+#include "utils/GraphUtils.hpp"
+
+// DeBruijnView クラスのテスト
+
+TEST(DeBruijnViewTest, EncodeDecode) {
+    DeBruijnView view(3, 2, 3);
+    EXPECT_EQ(view.getNodeCount(), 54);
+
+    std::uint64_t index;
+    ASSERT_TRUE(view.encode(Node("102", 1), index));
+    EXPECT_EQ(index, (1 * 9 + 0 * 3 + 2) * 2 + 1);
+    EXPECT_EQ(view.decode(index), Node("102", 1));
+
+    // グラフに存在しないノード
+    EXPECT_FALSE(view.encode(Node("13", 0), index));
+    EXPECT_FALSE(view.encode(Node("103", 0), index));
+    EXPECT_FALSE(view.encode(Node("102", 2), index));
+}
+
+TEST(DeBruijnViewTest, PredecessorsAreInverseOfSuccessors) {
+    DeBruijnView view(3, 2, 2);
+    for (std::uint64_t v = 0; v < view.getNodeCount(); ++v) {
+        view.forEachSuccessor(v, [&](std::uint64_t tgt, unsigned int symbol) {
+            bool found = false;
+            view.forEachPredecessor(tgt, [&](std::uint64_t src, unsigned int s) {
+                found |= (src == v && s == symbol);
+            });
+            EXPECT_TRUE(found);
+        });
+    }
+}
+
+TEST(DeBruijnViewTest, TrimMatchesCleanGraph) {
+    DeBruijn generator(2, 3, 3);
+    const auto& view = generator.getView();
+    std::vector<Node> forbiddenNodes = {Node("000", 0), Node("011", 1), Node("110", 2),
+                                        Node("101", 0)};
+
+    Graph expected = cleanGraph(generator.generate(forbiddenNodes));
+    Graph actual = generator.generateTrimmed(forbiddenNodes);
+
+    EXPECT_EQ(actual.getNodes(), expected.getNodes());
+    EXPECT_EQ(actual.getEdges(), expected.getEdges());
+
+    // 実体化せずに求めた値が実体化したグラフの値と一致する
+    auto alive = view.genAliveMask(forbiddenNodes);
+    view.trim(alive);
+    EXPECT_NEAR(view.calcMaxEigenvalue(alive), calculateMaxEigenvalue(expected), 1e-8);
+    EXPECT_EQ(view.countPathsOfLength(alive, 5), PathCounter(expected.getCsr()).count(5).toUint64());
+}
+
+TEST(DeBruijnViewTest, EmptyAfterTrim) {
+    DeBruijn generator(2, 1, 1);
+    // 0 と 1 を両方禁止するとすべて消える
+    std::vector<Node> forbiddenNodes = {Node("0", 0), Node("1", 0)};
+    const auto& view = generator.getView();
+    auto alive = view.genAliveMask(forbiddenNodes);
+    view.trim(alive);
+
+    EXPECT_EQ(view.calcMaxEigenvalue(alive), 0.0);
+    EXPECT_EQ(view.countPathsOfLength(alive, 3), 0);
+    EXPECT_EQ(generator.generateTrimmed(forbiddenNodes).getNodes().size(), 0);
+}
@@ -29,3 +29,64 @@ TEST(GraphTest, AddEdge) {
     EXPECT_EQ(edges.size(), 1);
     EXPECT_EQ(edges[0], edge);
 }
+
+TEST(GraphTest, AddEdgeRegistersNodes) {
+    Graph graph;
+    Node node1("Node1", 1);
+    Node node2("Node2", 2);
+
+    graph.addNode(node1);
+    graph.addEdge(Edge(node1, node2, "a"));
+    graph.addNode(node2);
+
+    // 登録済みのノードは重複しない
+    const auto& nodes = graph.getNodes();
+    ASSERT_EQ(nodes.size(), 2);
+    EXPECT_EQ(nodes[0], node1);
+    EXPECT_EQ(nodes[1], node2);
+
+    const auto& idEdges = graph.getEdges(Graph::mode::ID);
+    ASSERT_EQ(idEdges.size(), 1);
+    EXPECT_EQ(idEdges[0].getSource().getLabel(), "0");
+    EXPECT_EQ(idEdges[0].getTarget().getLabel(), "1");
+    EXPECT_EQ(idEdges[0].getLabel(), "a");
+}
+
+TEST(GraphTest, ViewOfCsrGraph) {
+    CsrGraph csr;
+    auto a = csr.addNode("A", 0);
+    auto b = csr.addNode("B", 1);
+    csr.addEdge(a, b, csr.addSymbol("0"));
+    csr.addEdge(b, a, csr.addSymbol("1"));
+
+    Graph graph(std::move(csr));
+
+    ASSERT_EQ(graph.getNodes().size(), 2);
+    EXPECT_EQ(graph.getNodes()[1], Node("B", 1));
+    ASSERT_EQ(graph.getEdges().size(), 2);
+    EXPECT_EQ(graph.getEdges()[1], Edge(Node("B", 1), Node("A", 0), "1"));
+    EXPECT_EQ(graph.getCsr().getEdgeCount(), 2);
+
+    // ビューへのNode経由の追加
+    graph.addEdge(Edge(Node("A", 0), Node("C", 0), "1"));
+    EXPECT_EQ(graph.getNodes().size(), 3);
+    EXPECT_EQ(graph.getEdges().size(), 3);
+}
+
+TEST(GraphTest, ViewOfCsrGraphWithDuplicateNodes) {
+    // 同じ (label, phase) のノードが2つある場合，Node経由では最初のノードを指す
+    CsrGraph csr;
+    csr.addNode("A", 0);
+    csr.addNode("A", 0);
+    Graph graph(std::move(csr));
+
+    graph.addEdge(Edge(Node("A", 0), Node("B", 0), "0"));
+    graph.addEdge(Edge(Node("B", 0), Node("A", 0), "1"));
+    graph.addEdge(Edge(Node("B", 0), Node("C", 0), "0"));
+    EXPECT_EQ(graph.getNodes().size(), 4);
+    const CsrGraph& result = graph.getCsr();
+    ASSERT_EQ(result.getEdgeCount(), 3);
+    EXPECT_EQ(result.getEdgeSource(0), 0);
+    EXPECT_EQ(result.getEdgeTarget(1), 0);
+    EXPECT_EQ(result.getEdgeTarget(2), 3);
+}
@@ -66,3 +66,85 @@ TEST(GraphUtilsTest, CleanGraph_RemovesSinkNodes) {
         ASSERT_NE(node.getLabel(), "D");
     }
 }
+
+// 長い鎖の先にあるシンクを連鎖的に削除するテスト
+TEST(GraphUtilsTest, CleanGraph_RemovesChains) {
+    Graph graph;
+
+    // A <-> B のサイクルから C -> D -> E と伸びる鎖，F -> A の流入
+    graph.addEdge(Edge(Node("A"), Node("B")));
+    graph.addEdge(Edge(Node("B"), Node("A")));
+    graph.addEdge(Edge(Node("B"), Node("C")));
+    graph.addEdge(Edge(Node("C"), Node("D")));
+    graph.addEdge(Edge(Node("D"), Node("E")));
+    graph.addEdge(Edge(Node("F"), Node("A")));
+
+    Graph cleanedGraph = cleanGraph(graph);
+
+    std::vector<Node> expected = {Node("A"), Node("B")};
+    EXPECT_EQ(cleanedGraph.getNodes(), expected);
+    EXPECT_EQ(cleanedGraph.getEdges().size(), 2);
+}
+
+// 非自明な強連結成分のみを残すテスト
+TEST(GraphUtilsTest, CleanGraph_SccMode) {
+    Graph graph;
+
+    // {A, B} と {D} (自己ループ) は非自明，C はその間の経由ノード
+    graph.addEdge(Edge(Node("A"), Node("B")));
+    graph.addEdge(Edge(Node("B"), Node("A")));
+    graph.addEdge(Edge(Node("B"), Node("C")));
+    graph.addEdge(Edge(Node("C"), Node("D")));
+    graph.addEdge(Edge(Node("D"), Node("D")));
+    graph.addEdge(Edge(Node("A"), Node("D")));
+
+    // シンクレスモードでは C も残る
+    EXPECT_EQ(cleanGraph(graph).getNodes().size(), 4);
+
+    Graph cleanedGraph = cleanGraph(graph, CleanMode::Scc);
+
+    std::vector<Node> expected = {Node("A"), Node("B"), Node("D")};
+    EXPECT_EQ(cleanedGraph.getNodes(), expected);
+    // A -> B, B -> A, D -> D, A -> D
+    EXPECT_EQ(cleanedGraph.getEdges().size(), 4);
+}
+
+// 強連結かの判定のテスト
+TEST(GraphUtilsTest, IsStronglyConnected) {
+    Graph graph;
+    graph.addEdge(Edge(Node("A"), Node("B")));
+    graph.addEdge(Edge(Node("B"), Node("C")));
+    EXPECT_FALSE(isStronglyConnected(graph.getCsr()));
+
+    graph.addEdge(Edge(Node("C"), Node("A")));
+    EXPECT_TRUE(isStronglyConnected(graph.getCsr()));
+
+    // 前向きにはすべて届くが，D へ戻る辺がない
+    graph.addEdge(Edge(Node("D"), Node("A")));
+    EXPECT_FALSE(isStronglyConnected(graph.getCsr()));
+
+    EXPECT_FALSE(isStronglyConnected(CsrGraph()));
+}
+
+// 一部のノードだけが張る暗黙的なグラフの判定のテスト
+TEST(GraphUtilsTest, IsStronglyConnected_AliveSubgraph) {
+    // 長さ4の閉路 0 -> 1 -> 2 -> 3 -> 0 と弦 0 -> 2
+    auto successors = [](std::uint64_t v, const auto& visit) {
+        visit((v + 1) % 4);
+        if (v == 0) {
+            visit(2);
+        }
+    };
+    auto predecessors = [](std::uint64_t v, const auto& visit) {
+        visit((v + 3) % 4);
+        if (v == 2) {
+            visit(0);
+        }
+    };
+    EXPECT_TRUE(isStronglyConnected(std::vector<bool>(4, true), successors, predecessors));
+    // 1 を除いても弦で閉路が残る
+    EXPECT_TRUE(isStronglyConnected({true, false, true, true}, successors, predecessors));
+    // 3 を除くと 0 へ戻れない
+    EXPECT_FALSE(isStronglyConnected({true, true, true, false}, successors, predecessors));
+    EXPECT_FALSE(isStronglyConnected(std::vector<bool>(4, false), successors, predecessors));
+}
@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include "algorithm/IncrementalDeBruijn.hpp"
+#include "analysis/eigenvalues.hpp"
+
+#include <random>
+#include <set>
+#include <tuple>
+
+// IncrementalDeBruijn クラスのテスト
+
+namespace {
+
+// 禁止集合から全体を作り直した刈り込み結果
+std::vector<bool> trimFromScratch(const DeBruijnView& view, const std::set<std::uint64_t>& forbidden) {
+    std::vector<Node> nodes;
+    for (std::uint64_t index : forbidden) {
+        nodes.push_back(view.decode(index));
+    }
+    auto alive = view.genAliveMask(nodes);
+    view.trim(alive);
+    return alive;
+}
+
+}  // namespace
+
+TEST(IncrementalDeBruijnTest, RandomUpdatesMatchTrim) {
+    for (auto [k, period, length] : {std::tuple{2u, 1u, 3u}, {2u, 3u, 2u}, {3u, 2u, 2u}}) {
+        IncrementalDeBruijn incremental(k, period, length);
+        const auto& view = incremental.getView();
+        std::mt19937 rng(k * 100 + period * 10 + length);
+        std::uniform_int_distribution<std::uint64_t> pick(0, view.getNodeCount() - 1);
+
+        std::set<std::uint64_t> forbidden;
+        for (int step = 0; step < 300; ++step) {
+            std::uint64_t index = pick(rng);
+            if (forbidden.count(index)) {
+                forbidden.erase(index);
+                incremental.allow(view.decode(index));
+            } else {
+                forbidden.insert(index);
+                incremental.forbid(view.decode(index));
+            }
+            ASSERT_EQ(incremental.getTrimmedMask(), trimFromScratch(view, forbidden))
+                << "k=" << k << " period=" << period << " step=" << step;
+        }
+    }
+}
+
+TEST(IncrementalDeBruijnTest, WarmStartedEigenvalueMatchesFromScratch) {
+    IncrementalDeBruijn incremental(2, 2, 3);
+    const auto& view = incremental.getView();
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::uint64_t> pick(0, view.getNodeCount() - 1);
+
+    std::set<std::uint64_t> forbidden;
+    for (int step = 0; step < 100; ++step) {
+        std::uint64_t index = pick(rng);
+        if (forbidden.count(index)) {
+            forbidden.erase(index);
+            incremental.allow(view.decode(index));
+        } else {
+            forbidden.insert(index);
+            incremental.forbid(view.decode(index));
+        }
+        double expected = calculateMaxEigenvalue(incremental.generateTrimmed());
+        EXPECT_NEAR(incremental.calcMaxEigenvalue(), expected, 1e-8) << "step " << step;
+    }
+}
+
+TEST(IncrementalDeBruijnTest, ResetAndIgnoredNodes) {
+    IncrementalDeBruijn incremental(2, 2, 2);
+    incremental.reset({Node("00", 0), Node("11", 1)});
+    const auto& view = incremental.getView();
+
+    auto alive = view.genAliveMask({Node("00", 0), Node("11", 1)});
+    EXPECT_EQ(incremental.getAliveMask(), alive);
+    view.trim(alive);
+    EXPECT_EQ(incremental.getTrimmedMask(), alive);
+
+    // グラフにない語と禁止されていない語の削除は無視する
+    incremental.forbid(Node("000", 0));
+    incremental.allow(Node("01", 0));
+    EXPECT_EQ(incremental.getTrimmedMask(), alive);
+}
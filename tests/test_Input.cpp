@@ -0,0 +1,217 @@
+#include "gtest/gtest.h"
+#include "io/Input.hpp"
+
+#include <algorithm>
+
+// 入力関連 (禁止集合の列挙) のテスト
+
+namespace {
+
+io::type::Config makeAllPatternsConfig(unsigned int alphabet, unsigned int length,
+                                       const std::vector<unsigned int>& position) {
+    io::type::Config config;
+    config.generation.mode = "all-patterns";
+    config.generation.alphabet = alphabet;
+    config.generation.period = position.size();
+    config.generation.forbidden.length = length;
+    config.generation.forbidden.position = position;
+    return config;
+}
+
+// 語の添字集合を辞書順に列挙 (比較用)
+std::vector<std::vector<int>> enumerateSubsets(int m, int n) {
+    std::vector<std::vector<int>> subsets;
+    std::vector<bool> mask(m, false);
+    std::fill(mask.begin(), mask.begin() + n, true);
+    do {
+        std::vector<int> subset;
+        for (int i = 0; i < m; ++i) {
+            if (mask[i]) {
+                subset.push_back(i);
+            }
+        }
+        subsets.push_back(subset);
+    } while (std::prev_permutation(mask.begin(), mask.end()));
+    return subsets;
+}
+
+}  // namespace
+
+TEST(ForbiddenSetEnumeratorTest, LastPhaseAdvancesFastest) {
+    const std::vector<std::string> words = {"00", "01", "10", "11"};
+    auto config = makeAllPatternsConfig(2, 2, {1, 2});
+
+    std::vector<std::vector<Node>> expected;
+    for (const auto& s0 : enumerateSubsets(4, 1)) {
+        for (const auto& s1 : enumerateSubsets(4, 2)) {
+            std::vector<Node> nodes;
+            for (int i : s0) {
+                nodes.emplace_back(words[i], 0);
+            }
+            for (int i : s1) {
+                nodes.emplace_back(words[i], 1);
+            }
+            expected.push_back(nodes);
+        }
+    }
+
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    std::vector<std::vector<Node>> actual;
+    while (enumerator.next()) {
+        actual.push_back(enumerator.get());
+    }
+    EXPECT_EQ(actual.size(), 24);
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(io::input::genNodesFromConfig(config), expected);
+}
+
+TEST(ForbiddenSetEnumeratorTest, SkipsEmptyAndFullPhases) {
+    // 位相1は語を選ばず，位相2はすべての語を選ぶ
+    auto config = makeAllPatternsConfig(2, 1, {1, 0, 2});
+
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    ASSERT_TRUE(enumerator.next());
+    EXPECT_EQ(enumerator.get(),
+              (std::vector<Node>{Node("0", 0), Node("0", 2), Node("1", 2)}));
+    ASSERT_TRUE(enumerator.next());
+    EXPECT_EQ(enumerator.get(),
+              (std::vector<Node>{Node("1", 0), Node("0", 2), Node("1", 2)}));
+    EXPECT_FALSE(enumerator.next());
+    EXPECT_FALSE(enumerator.next());
+}
+
+TEST(ForbiddenSetEnumeratorTest, NoForbiddenWords) {
+    auto config = makeAllPatternsConfig(2, 1, {0, 0});
+
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    ASSERT_TRUE(enumerator.next());
+    EXPECT_TRUE(enumerator.get().empty());
+    EXPECT_FALSE(enumerator.next());
+}
+
+TEST(ForbiddenSetEnumeratorTest, CustomMode) {
+    io::type::Config config;
+    config.generation.mode = "custom";
+    config.generation.forbidden.nodes = {io::type::Node("01", 0), io::type::Node("1", 1)};
+
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    ASSERT_TRUE(enumerator.next());
+    EXPECT_EQ(enumerator.get(), (std::vector<Node>{Node("01", 0), Node("1", 1)}));
+    EXPECT_FALSE(enumerator.next());
+}
+
+TEST(ForbiddenSetEnumeratorTest, SeekMatchesEnumeration) {
+    auto config = makeAllPatternsConfig(2, 2, {2, 1, 1});
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    std::vector<std::vector<Node>> all;
+    while (enumerator.next()) {
+        all.push_back(enumerator.get());
+    }
+    ASSERT_EQ(enumerator.getCount(), all.size());
+
+    for (std::uint64_t index = 0; index < all.size(); ++index) {
+        io::input::ForbiddenSetEnumerator seeker(config);
+        seeker.seek(index);
+        ASSERT_TRUE(seeker.next());
+        EXPECT_EQ(seeker.get(), all[index]) << "index " << index;
+        if (index + 1 < all.size()) {
+            ASSERT_TRUE(seeker.next());
+            EXPECT_EQ(seeker.get(), all[index + 1]);
+        }
+    }
+
+    io::input::ForbiddenSetEnumerator past(config);
+    past.seek(all.size());
+    EXPECT_FALSE(past.next());
+}
+
+TEST(ForbiddenSetEnumeratorTest, ShardsPartitionSweep) {
+    auto config = makeAllPatternsConfig(3, 2, {1, 2});
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    std::vector<std::vector<Node>> all;
+    while (enumerator.next()) {
+        all.push_back(enumerator.get());
+    }
+
+    // 分割を順に連結すると全体の列挙に一致する
+    const std::uint64_t total = all.size();
+    for (std::uint64_t shardCount : {1u, 4u, 7u}) {
+        std::vector<std::vector<Node>> joined;
+        for (std::uint64_t i = 0; i < shardCount; ++i) {
+            std::uint64_t begin = total * i / shardCount;
+            std::uint64_t end = total * (i + 1) / shardCount;
+            io::input::ForbiddenSetEnumerator shard(config);
+            shard.seek(begin);
+            for (std::uint64_t index = begin; index < end && shard.next(); ++index) {
+                joined.push_back(shard.get());
+            }
+        }
+        EXPECT_EQ(joined, all) << shardCount << " shards";
+    }
+}
+
+TEST(MinimalChangeEnumeratorTest, VisitsAllSetsWithOneSwap) {
+    auto config = makeAllPatternsConfig(2, 2, {2, 0, 1});
+    io::input::ForbiddenSetEnumerator lexicographic(config);
+    std::vector<std::vector<Node>> expected;
+    while (lexicographic.next()) {
+        expected.push_back(lexicographic.get());
+    }
+
+    io::input::MinimalChangeEnumerator enumerator(config);
+    ASSERT_EQ(enumerator.getCount(), expected.size());
+    std::vector<std::vector<Node>> visited;
+    while (enumerator.next()) {
+        const auto& current = enumerator.get();
+        if (visited.empty()) {
+            EXPECT_FALSE(enumerator.hasChanges());
+        } else {
+            ASSERT_TRUE(enumerator.hasChanges());
+            ASSERT_EQ(enumerator.getRemoved().size(), 1u);
+            ASSERT_EQ(enumerator.getAdded().size(), 1u);
+
+            // 直前の集合から1語を入れ替えると現在の集合になる
+            std::vector<Node> applied;
+            for (const auto& node : visited.back()) {
+                if (!(node == enumerator.getRemoved()[0])) {
+                    applied.push_back(node);
+                }
+            }
+            applied.push_back(enumerator.getAdded()[0]);
+            std::sort(applied.begin(), applied.end());
+            std::vector<Node> sorted(current);
+            std::sort(sorted.begin(), sorted.end());
+            EXPECT_EQ(applied, sorted);
+        }
+        visited.push_back(current);
+    }
+
+    // 並びは異なるが同じ集合をちょうど1回ずつ辿る
+    std::sort(expected.begin(), expected.end());
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, expected);
+}
+
+TEST(MinimalChangeEnumeratorTest, SeekMatchesEnumeration) {
+    auto config = makeAllPatternsConfig(2, 2, {1, 2, 1});
+    io::input::MinimalChangeEnumerator enumerator(config);
+    std::vector<std::vector<Node>> all;
+    while (enumerator.next()) {
+        all.push_back(enumerator.get());
+    }
+
+    for (std::uint64_t position = 0; position < all.size(); ++position) {
+        io::input::MinimalChangeEnumerator seeker(config);
+        seeker.seek(position);
+        ASSERT_TRUE(seeker.next());
+        EXPECT_FALSE(seeker.hasChanges());
+        EXPECT_EQ(seeker.get(), all[position]) << "position " << position;
+
+        // seek 後も同じ向きで進む
+        for (std::uint64_t next = position + 1; next < all.size() && next < position + 4; ++next) {
+            ASSERT_TRUE(seeker.next());
+            EXPECT_TRUE(seeker.hasChanges());
+            EXPECT_EQ(seeker.get(), all[next]) << "position " << position << " -> " << next;
+        }
+    }
+}
@@ -75,3 +75,39 @@ TEST(MooreTest, Apply2) {
     //     std::cout << node << std::endl;
     // }
 }
+
+// 同値類の計算テスト
+TEST(MooreTest, ComputeClasses) {
+    Graph graph;
+
+    // A, B は同じ振る舞い (a で互いに遷移)，C は b の遷移も持つ
+    graph.addEdge(Edge(Node("A"), Node("B"), "a"));
+    graph.addEdge(Edge(Node("B"), Node("A"), "a"));
+    graph.addEdge(Edge(Node("C"), Node("A"), "a"));
+    graph.addEdge(Edge(Node("C"), Node("C"), "b"));
+
+    auto classes = Moore::computeClasses(graph.getCsr());
+
+    ASSERT_EQ(classes.size(), 3);
+    EXPECT_EQ(classes[0], 0);
+    EXPECT_EQ(classes[1], 0);
+    EXPECT_EQ(classes[2], 1);
+}
+
+// 出辺を持たないノードを含むグラフの最小化テスト
+TEST(MooreTest, ApplyWithSinkNodes) {
+    Graph graph;
+
+    graph.addEdge(Edge(Node("A"), Node("C"), "a"));
+    graph.addEdge(Edge(Node("B"), Node("D"), "a"));
+    graph.addNode(Node("C"));
+    graph.addNode(Node("D"));
+
+    Graph newGraph = Moore::apply(graph);
+
+    // {A, B} と {C, D} の2つにまとまる
+    std::vector<Node> expectedNodes = {Node("A"), Node("C")};
+    EXPECT_EQ(newGraph.getNodes(), expectedNodes);
+    ASSERT_EQ(newGraph.getEdges().size(), 1);
+    EXPECT_EQ(newGraph.getEdges()[0], Edge(Node("A"), Node("C"), "a"));
+}
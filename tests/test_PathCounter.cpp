@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "analysis/PathCounter.hpp"
+#include "core/Graph.hpp"
+
+#include <functional>
+#include <random>
+
+// PathCounter クラスのテスト
+
+namespace {
+
+using Method = PathCounter::Method;
+
+// 経路を列挙して始点・終点の位相ごとに数える (比較用)
+std::vector<std::vector<std::uint64_t>> countByEnumeration(const CsrGraph& csr, unsigned int length,
+                                                           unsigned int phases) {
+    std::vector<std::vector<std::uint64_t>> counts(phases, std::vector<std::uint64_t>(phases, 0));
+    const auto& offsets = csr.getOutOffsets();
+    const auto& targets = csr.getOutTargets();
+    std::function<void(CsrGraph::Id, CsrGraph::Id, unsigned int)> walk =
+        [&](CsrGraph::Id start, CsrGraph::Id v, unsigned int rest) {
+            if (rest == 0) {
+                ++counts[csr.getPhase(start)][csr.getPhase(v)];
+                return;
+            }
+            for (CsrGraph::Id e = offsets[v]; e < offsets[v + 1]; ++e) {
+                walk(start, targets[e], rest - 1);
+            }
+        };
+    for (CsrGraph::Id v = 0; v < csr.getNodeCount(); ++v) {
+        walk(v, v, length);
+    }
+    return counts;
+}
+
+// 位相つきの無作為なグラフ (多重辺を含む)
+CsrGraph makeRandomGraph(std::mt19937& rng, unsigned int nodes, unsigned int phases) {
+    CsrGraph csr;
+    std::uniform_int_distribution<unsigned int> phase(0, phases - 1), node(0, nodes - 1);
+    for (unsigned int v = 0; v < nodes; ++v) {
+        csr.addNode(std::to_string(v), v < phases ? v : phase(rng));
+    }
+    const CsrGraph::Id symbol = csr.addSymbol("0");
+    for (unsigned int e = 0; e < 2 * nodes; ++e) {
+        csr.addEdge(node(rng), node(rng), symbol);
+    }
+    return csr;
+}
+
+}  // namespace
+
+TEST(PathCounterTest, MatchesEnumeration) {
+    std::mt19937 rng(5);
+    for (int trial = 0; trial < 20; ++trial) {
+        const unsigned int phases = 1 + trial % 3;
+        CsrGraph csr = makeRandomGraph(rng, 3 + trial % 5, phases);
+        PathCounter counter(csr);
+        ASSERT_EQ(counter.getPhaseCount(), phases);
+        for (unsigned int length = 1; length <= 6; ++length) {
+            const auto expected = countByEnumeration(csr, length, phases);
+            std::uint64_t total = 0;
+            for (const auto& row : expected) {
+                for (std::uint64_t value : row) {
+                    total += value;
+                }
+            }
+            for (Method method : {Method::DynamicProgramming, Method::Squaring}) {
+                const auto counts = counter.countByPhase(length, method);
+                for (unsigned int s = 0; s < phases; ++s) {
+                    for (unsigned int t = 0; t < phases; ++t) {
+                        EXPECT_EQ(counts[s][t], expected[s][t]);
+                    }
+                }
+                EXPECT_EQ(counter.count(length, method), total);
+            }
+        }
+        EXPECT_EQ(counter.count(0), 0);
+    }
+}
+
+TEST(PathCounterTest, ExactBeyond64Bits) {
+    // 2本の自己ループを持つ1ノード: 長さLの経路は 2^L
+    CsrGraph csr;
+    csr.addNode("0");
+    const CsrGraph::Id symbol = csr.addSymbol("0");
+    csr.addEdge(0, 0, symbol);
+    csr.addEdge(0, 0, symbol);
+    PathCounter counter(csr);
+
+    BigUint expected(1);
+    for (int i = 0; i < 200; ++i) {
+        expected *= 2u;
+    }
+    EXPECT_EQ(counter.count(200, Method::DynamicProgramming), expected);
+    EXPECT_EQ(counter.count(200, Method::Squaring), expected);
+    EXPECT_EQ(counter.count(200), expected);
+}
+
+TEST(PathCounterTest, LongCycleUsesSquaring) {
+    // 位相つきの長さ5の閉路: どの長さでも経路は5本で，始点の位相から終点の位相が決まる
+    CsrGraph csr;
+    for (unsigned int v = 0; v < 5; ++v) {
+        csr.addNode(std::to_string(v), v);
+    }
+    const CsrGraph::Id symbol = csr.addSymbol("0");
+    for (unsigned int v = 0; v < 5; ++v) {
+        csr.addEdge(v, (v + 1) % 5, symbol);
+    }
+    PathCounter counter(csr);
+    const unsigned int length = 1000003;
+    EXPECT_EQ(counter.chooseMethod(length), Method::Squaring);
+    EXPECT_EQ(counter.count(length), 5);
+    const auto counts = counter.countByPhase(length);
+    for (unsigned int s = 0; s < 5; ++s) {
+        for (unsigned int t = 0; t < 5; ++t) {
+            EXPECT_EQ(counts[s][t], (s + length) % 5 == t ? 1 : 0);
+        }
+    }
+}
+
+TEST(PathCounterTest, GraphCountsPaths) {
+    Graph graph;
+    graph.addEdge(Edge(Node("A", 0), Node("B", 0), "0"));
+    graph.addEdge(Edge(Node("B", 0), Node("A", 0), "1"));
+    graph.addEdge(Edge(Node("B", 0), Node("B", 0), "0"));
+    // 隣接行列 [[0,1],[1,1]] の L 乗の成分和はフィボナッチ数 F(L + 3)
+    PathCounter counter(graph.getCsr());
+    EXPECT_EQ(counter.count(1), 3);
+    EXPECT_EQ(counter.count(10), 233);
+    EXPECT_EQ(counter.count(100).toString(), "1500520536206896083277");
+    EXPECT_EQ(counter.count(0), 0);
+}
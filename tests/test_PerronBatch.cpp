@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "GraphTestUtils.hpp"
+#include "algorithm/DeBruijn.hpp"
+#include "analysis/PerronBatch.hpp"
+#include "core/Graph.hpp"
+
+#include <random>
+
+// PerronBatch クラスのテスト
+
+namespace {
+
+using test_utils::makeGraph;
+
+// 密な固有値分解による最大固有値 (比較用)
+double calcDense(const Graph& graph) {
+    const auto& csr = graph.getCsr();
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(csr.getNodeCount(), csr.getNodeCount());
+    for (size_t e = 0; e < csr.getEdgeCount(); ++e) {
+        matrix(csr.getEdgeSource(e), csr.getEdgeTarget(e)) += 1.0;
+    }
+    Eigen::EigenSolver<Eigen::MatrixXd> solver(matrix, false);
+    return solver.eigenvalues().cwiseAbs().maxCoeff();
+}
+
+// 周期2のDe Bruijnグラフから語を無作為に禁止して刈り込んだグラフ (空でないもの)
+std::vector<Graph> makeDeBruijnGraphs(size_t count) {
+    DeBruijn generator(2, 2, 3);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> word(0, 7), phase(0, 1);
+    std::vector<Graph> graphs;
+    while (graphs.size() < count) {
+        std::vector<Node> forbidden;
+        for (int i = 0; i < 3; ++i) {
+            int w = word(rng);
+            std::string label;
+            for (int b = 2; b >= 0; --b) {
+                label += (w >> b & 1) ? '1' : '0';
+            }
+            forbidden.emplace_back(label, phase(rng));
+        }
+        Graph graph = generator.generateTrimmed(forbidden);
+        if (graph.getCsr().getNodeCount() > 0) {
+            graphs.push_back(std::move(graph));
+        }
+    }
+    return graphs;
+}
+
+}  // namespace
+
+TEST(PerronBatchTest, BoundsContainDenseEigenvalue) {
+    auto graphs = makeDeBruijnGraphs(40);
+    std::vector<const Graph*> ptrs;
+    for (const auto& graph : graphs) {
+        ptrs.push_back(&graph);
+    }
+    const auto values = calculateMaxEigenvalues(ptrs);
+    for (size_t g = 0; g < graphs.size(); ++g) {
+        EXPECT_NEAR(values[g], calcDense(graphs[g]), 1e-8);
+    }
+
+    // 収束したレーンは上下界が真の値を挟む (可約なグラフは収束しないことがある)
+    std::vector<const CsrGraph*> lanes;
+    std::vector<size_t> indices;
+    for (size_t g = 0; g < graphs.size() && lanes.size() < 16; ++g) {
+        if (PerronBatch(std::vector<const CsrGraph*>{&graphs[g].getCsr()}).getPeriod() == 2) {
+            lanes.push_back(&graphs[g].getCsr());
+            indices.push_back(g);
+        }
+    }
+    PerronBatch batch(lanes);
+    EXPECT_EQ(batch.getPeriod(), 2u);
+    const auto roots = batch.solve();
+    size_t converged = 0;
+    for (size_t lane = 0; lane < lanes.size(); ++lane) {
+        if (!roots[lane].converged) {
+            continue;
+        }
+        ++converged;
+        const double expected = calcDense(graphs[indices[lane]]);
+        EXPECT_LE(roots[lane].lower, expected * (1.0 + 1e-12));
+        EXPECT_GE(roots[lane].upper, expected * (1.0 - 1e-12));
+        EXPECT_NEAR(roots[lane].value, expected, 1e-9);
+    }
+    EXPECT_GT(converged, 0u);
+}
+
+TEST(PerronBatchTest, PeriodicCycles) {
+    // 位相つきの長さ3の閉路 (周期3) と，2つの閉路を共有する周期3のグラフ
+    Graph cycle = makeGraph({{0, 1}, {1, 2}, {2, 0}}, {0, 1, 2});
+    Graph doubled = makeGraph({{0, 1}, {1, 2}, {2, 0}, {0, 3}, {3, 2}}, {0, 1, 2, 1});
+    PerronBatch batch({&cycle.getCsr(), &doubled.getCsr()});
+    EXPECT_EQ(batch.getPeriod(), 3u);
+    EXPECT_EQ(batch.getLaneCount(), 2u);
+
+    const auto roots = batch.solve();
+    ASSERT_TRUE(roots[0].converged);
+    ASSERT_TRUE(roots[1].converged);
+    EXPECT_NEAR(roots[0].value, 1.0, 1e-9);
+    EXPECT_NEAR(roots[1].value, std::cbrt(2.0), 1e-9);
+    EXPECT_LE(roots[1].lower, std::cbrt(2.0) + 1e-12);
+    EXPECT_GE(roots[1].upper, std::cbrt(2.0) - 1e-12);
+}
+
+TEST(PerronBatchTest, RejectsMixedPeriodsAndLargeGraphs) {
+    Graph cycle3 = makeGraph({{0, 1}, {1, 2}, {2, 0}}, {0, 1, 2});
+    Graph loop = makeGraph({{0, 0}});
+    EXPECT_THROW(PerronBatch({&cycle3.getCsr(), &loop.getCsr()}), std::invalid_argument);
+
+    std::vector<std::pair<int, int>> edges;
+    for (int v = 0; v <= static_cast<int>(PerronBatch::MAX_NODES); ++v) {
+        edges.emplace_back(v, (v + 1) % (PerronBatch::MAX_NODES + 1));
+    }
+    Graph large = makeGraph(edges);
+    EXPECT_THROW(PerronBatch({&large.getCsr()}), std::invalid_argument);
+
+    std::vector<const CsrGraph*> many(PerronBatch::MAX_LANES + 1, &loop.getCsr());
+    EXPECT_THROW(PerronBatch{many}, std::invalid_argument);
+}
+
+TEST(PerronBatchTest, CalculateMaxEigenvaluesKeepsOrder) {
+    // 強連結・可約・空・大きいグラフが混在しても入力順に返す
+    Graph golden = makeGraph({{0, 0}, {0, 1}, {1, 0}});
+    Graph reducible = makeGraph({{0, 0}, {0, 1}, {1, 1}, {1, 2}, {2, 1}});
+    Graph empty;
+    std::vector<std::pair<int, int>> edges;
+    for (int v = 0; v < 100; ++v) {
+        edges.emplace_back(v, (v + 1) % 100);
+        edges.emplace_back(v, (v + 2) % 100);
+    }
+    Graph large = makeGraph(edges);
+    Graph cycle3 = makeGraph({{0, 1}, {1, 2}, {2, 0}}, {0, 1, 2});
+
+    const auto values = calculateMaxEigenvalues({&golden, &reducible, &empty, &large, &cycle3});
+    ASSERT_EQ(values.size(), 5u);
+    EXPECT_NEAR(values[0], (1.0 + std::sqrt(5.0)) / 2.0, 1e-9);
+    EXPECT_NEAR(values[1], (1.0 + std::sqrt(5.0)) / 2.0, 1e-8);
+    EXPECT_EQ(values[2], 0.0);
+    EXPECT_NEAR(values[3], 2.0, 1e-8);
+    EXPECT_NEAR(values[4], 1.0, 1e-9);
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "algorithm/Beal.hpp"
+#include "io/ResultCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include "nlohmann/json.hpp"
+
+// ResultCache クラスのテスト
+
+namespace {
+
+io::type::Config makeConfig(const std::string& algorithm, const std::string& optMode) {
+    io::type::Config config;
+    config.generation.mode = "all-patterns";
+    config.generation.algorithm = algorithm;
+    config.generation.opt_mode = optMode;
+    config.generation.alphabet = 2;
+    config.generation.period = 2;
+    config.generation.forbidden.length = 2;
+    return config;
+}
+
+class ResultCacheTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        directory = (std::filesystem::temp_directory_path() /
+                     ("pft-cache-test-" + std::to_string(::testing::UnitTest::GetInstance()
+                                                             ->random_seed())))
+                        .string();
+        std::filesystem::remove_all(directory);
+    }
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    std::string directory;
+};
+
+}  // namespace
+
+TEST_F(ResultCacheTest, KeyIsCanonical) {
+    auto config = makeConfig("Beal", "none");
+    const EigenOptions options;
+    auto key = io::ResultCache::genKey(config, options, {Node("01", 1), Node("00", 0)});
+    EXPECT_EQ(key, io::ResultCache::genKey(config, options, {Node("00", 0), Node("01", 1)}));
+    EXPECT_EQ(key,
+              "algorithm=Beal;alphabet=2;period=2;opt_mode=none;eig_tol=1e-10;"
+              "eig_max_iter=10000;forbidden=00:0,01:1");
+
+    // 設定が異なれば別のキー
+    EXPECT_NE(key, io::ResultCache::genKey(makeConfig("Beal", "minimize"), options,
+                                           {Node("00", 0), Node("01", 1)}));
+    EXPECT_NE(io::ResultCache::genKey(makeConfig("DeBruijn", "none"), options, {Node("00", 0)}),
+              io::ResultCache::genKey(makeConfig("Beal", "none"), options, {Node("00", 0)}));
+
+    // 固有値計算の設定が異なっても別のキー
+    EXPECT_NE(key, io::ResultCache::genKey(config, EigenOptions{1e-6, 10000},
+                                           {Node("00", 0), Node("01", 1)}));
+    EXPECT_NE(key, io::ResultCache::genKey(config, EigenOptions{1e-10, 100},
+                                           {Node("00", 0), Node("01", 1)}));
+
+    // FNV-1a の既知の値
+    EXPECT_EQ(io::ResultCache::hashKey(""), 14695981039346656037ULL);
+    EXPECT_EQ(io::ResultCache::hashKey("a"), 0xaf63dc4c8601ec8cULL);
+}
+
+TEST_F(ResultCacheTest, StoreAndLoad) {
+    io::ResultCache cache(directory);
+    auto config = makeConfig("Beal", "none");
+    std::vector<Node> forbiddenNodes = {Node("00", 0), Node("11", 1)};
+    const std::string key = io::ResultCache::genKey(config, EigenOptions{}, forbiddenNodes);
+
+    io::ResultCache::Entry entry;
+    EXPECT_FALSE(cache.load(key, entry));
+
+    entry.graph = Beal(2, 2).generate(forbiddenNodes);
+    ASSERT_TRUE(cache.store(key, entry));
+
+    io::ResultCache::Entry loaded;
+    ASSERT_TRUE(cache.load(key, loaded));
+    EXPECT_EQ(loaded.graph.getNodes(), entry.graph.getNodes());
+    EXPECT_EQ(loaded.graph.getEdges(), entry.graph.getEdges());
+    EXPECT_FALSE(loaded.maxEigenvalue.has_value());
+
+    // 最大固有値を追記
+    loaded.maxEigenvalue = 1.5;
+    ASSERT_TRUE(cache.store(key, loaded));
+    io::ResultCache::Entry updated;
+    ASSERT_TRUE(cache.load(key, updated));
+    ASSERT_TRUE(updated.maxEigenvalue.has_value());
+    EXPECT_DOUBLE_EQ(*updated.maxEigenvalue, 1.5);
+    EXPECT_EQ(updated.graph.getEdges(), entry.graph.getEdges());
+}
+
+TEST_F(ResultCacheTest, RejectsMismatchedKey) {
+    io::ResultCache cache(directory);
+    io::ResultCache::Entry entry;
+    entry.graph = Beal(2, 2).generate({Node("00", 0)});
+    ASSERT_TRUE(cache.store("key", entry));
+
+    // 同じファイルに別のキーが保存されていた場合 (ハッシュの衝突) は読み込まない
+    for (const auto& file : std::filesystem::recursive_directory_iterator(directory)) {
+        if (file.is_regular_file()) {
+            nlohmann::json data;
+            std::ifstream(file.path()) >> data;
+            data["key"] = "other";
+            std::ofstream(file.path()) << data.dump();
+        }
+    }
+    EXPECT_FALSE(cache.load("key", entry));
+}
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+#include "SequenceTestUtils.hpp"
+#include "algorithm/SequenceCoder.hpp"
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+// SequenceCoder クラスのテスト
+
+namespace {
+
+using test_utils::enumerate;
+using test_utils::makeRandomGraph;
+
+// 11 を含まない系列 (黄金比シフト)
+CsrGraph makeGoldenMean() {
+    CsrGraph csr;
+    csr.addNode("a");
+    csr.addNode("b");
+    const auto zero = csr.addSymbol("0"), one = csr.addSymbol("1");
+    csr.addEdge(0, 0, zero);
+    csr.addEdge(0, 1, one);
+    csr.addEdge(1, 0, zero);
+    return csr;
+}
+
+std::string roundTrip(const SequenceCoder& coder, const std::string& bytes) {
+    std::istringstream in(bytes);
+    std::stringstream encoded;
+    coder.encode(in, encoded);
+    std::ostringstream decoded;
+    EXPECT_EQ(coder.decode(encoded, decoded), bytes.size());
+    return decoded.str();
+}
+
+}  // namespace
+
+TEST(SequenceCoderTest, RanksInLexicographicOrder) {
+    std::mt19937 rng(3);
+    for (int trial = 0; trial < 20; ++trial) {
+        for (const auto& labels : {std::vector<std::string>{"0", "1", "2"},
+                                   std::vector<std::string>{"ab", "ba", "bb"}}) {
+            const CsrGraph csr = makeRandomGraph(rng, 3 + trial % 6, labels);
+            const unsigned int length = 6;
+            const std::vector<std::string> words = enumerate(csr, length);
+
+            const SequenceCoder coder(csr, length);
+            ASSERT_EQ(coder.getCount(), BigUint(words.size()));
+            for (size_t i = 0; i < words.size(); ++i) {
+                EXPECT_EQ(coder.rankUint64(words[i]), i);
+                EXPECT_EQ(coder.rank(words[i]), BigUint(i));
+                EXPECT_EQ(coder.unrankUint64(i), words[i]);
+                EXPECT_EQ(coder.unrank(i), words[i]);
+            }
+            EXPECT_THROW(coder.unrankUint64(words.size()), std::out_of_range);
+            EXPECT_THROW(coder.unrank(words.size()), std::out_of_range);
+        }
+    }
+}
+
+TEST(SequenceCoderTest, LargeCounts) {
+    // 長さLの系列数はフィボナッチ数 F(L + 2) (長さ200では64ビットに収まらない)
+    const SequenceCoder coder(makeGoldenMean(), 200);
+    EXPECT_EQ(coder.getCount().toString(),
+              "734544867157818093234908902110449296423351");
+    EXPECT_EQ(coder.getBitsPerWord(), 139u);
+    EXPECT_THROW(coder.rankUint64(std::string(200, '0')), std::overflow_error);
+
+    // 最初・最後の系列と往復
+    EXPECT_EQ(coder.unrank(0), std::string(200, '0'));
+    std::string last;
+    for (int i = 0; i < 100; ++i) {
+        last += "10";
+    }
+    EXPECT_EQ(coder.rank(last), coder.getCount() - 1);
+    std::mt19937 rng(1);
+    for (int trial = 0; trial < 50; ++trial) {
+        BigUint index;
+        for (size_t bit = 0; bit < coder.getBitsPerWord(); ++bit) {
+            if (rng() & 1) {
+                index.setBit(bit);
+            }
+        }
+        const std::string word = coder.unrank(index);
+        EXPECT_EQ(word.find("11"), std::string::npos);
+        EXPECT_EQ(coder.rank(word), index);
+    }
+}
+
+TEST(SequenceCoderTest, RejectsWordsOutsideTheSet) {
+    const SequenceCoder coder(makeGoldenMean(), 5);
+    EXPECT_EQ(coder.getCount(), BigUint(13u));
+    EXPECT_EQ(coder.getBitsPerWord(), 3u);
+    EXPECT_THROW(coder.rank("01100"), std::invalid_argument);
+    EXPECT_THROW(coder.rank("0100"), std::invalid_argument);
+    EXPECT_THROW(coder.rank("01020"), std::invalid_argument);
+    EXPECT_THROW(coder.rankUint64("11000"), std::invalid_argument);
+
+    // 系列のない長さでは何も順位付けできない
+    CsrGraph chain;
+    chain.addNode("a");
+    chain.addNode("b");
+    chain.addEdge(0, 1, chain.addSymbol("x"));
+    const SequenceCoder empty(chain, 2);
+    EXPECT_TRUE(empty.getCount().isZero());
+    EXPECT_THROW(empty.rank("xx"), std::invalid_argument);
+    EXPECT_THROW(empty.unrank(0), std::out_of_range);
+    std::istringstream in("data");
+    std::ostringstream out;
+    EXPECT_THROW(empty.encode(in, out), std::invalid_argument);
+}
+
+TEST(SequenceCoderTest, EncodeDecodeRoundTrip) {
+    std::mt19937 rng(7);
+    std::string bytes;
+    for (int i = 0; i < 1000; ++i) {
+        bytes += static_cast<char>(rng());
+    }
+    // 1語あたり 3, 21, 63, 64, 139 ビット
+    for (unsigned int length : {5u, 30u, 91u, 92u, 200u}) {
+        const SequenceCoder coder(makeGoldenMean(), length);
+        EXPECT_EQ(roundTrip(coder, bytes), bytes);
+        EXPECT_EQ(roundTrip(coder, bytes.substr(0, 7)), bytes.substr(0, 7));
+        EXPECT_EQ(roundTrip(coder, ""), "");
+    }
+    EXPECT_EQ(SequenceCoder(makeGoldenMean(), 91).getBitsPerWord(), 63u);
+    EXPECT_EQ(SequenceCoder(makeGoldenMean(), 92).getBitsPerWord(), 64u);
+
+    // 語数は切り上げ，壊れた入力は戻さない
+    const SequenceCoder small(makeGoldenMean(), 5);
+    std::istringstream in("ab");
+    std::ostringstream encoded;
+    EXPECT_EQ(small.encode(in, encoded), 6u);
+    std::string text = encoded.str();
+    EXPECT_EQ(text.substr(0, 2), "2\n");
+    std::ostringstream out;
+    std::istringstream truncated(text.substr(0, text.size() - 12));
+    EXPECT_THROW(small.decode(truncated, out), std::invalid_argument);
+    std::istringstream noHeader(text.substr(2));
+    EXPECT_THROW(small.decode(noHeader, out), std::invalid_argument);
+    text[2] = '1';
+    text[3] = '1';
+    std::istringstream invalid(text);
+    EXPECT_THROW(small.decode(invalid, out), std::invalid_argument);
+}
+
+TEST(SequenceCoderTest, DecodeRejectsRanksBeyondBitsPerWord) {
+    // 語数は 2 の冪でないので，順位が 2^getBitsPerWord() 以上の語も集合に含まれる
+    for (unsigned int length : {5u, 200u}) {
+        const SequenceCoder coder(makeGoldenMean(), length);
+        BigUint rank;
+        rank.setBit(coder.getBitsPerWord());
+        ASSERT_LT(rank, coder.getCount());
+        std::istringstream in("1\n" + coder.unrank(rank) + "\n");
+        std::ostringstream out;
+        EXPECT_THROW(coder.decode(in, out), std::invalid_argument);
+    }
+}
@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include "SequenceTestUtils.hpp"
+#include "algorithm/SequenceDawg.hpp"
+#include "core/Graph.hpp"
+#include "io/Input.hpp"
+#include "io/Output.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+// SequenceDawg クラスのテスト
+
+namespace {
+
+using test_utils::enumerate;
+using test_utils::makeRandomGraph;
+
+}  // namespace
+
+TEST(SequenceDawgTest, MatchesEnumerator) {
+    std::mt19937 rng(21);
+    for (int trial = 0; trial < 30; ++trial) {
+        CsrGraph csr = makeRandomGraph(rng, 3 + trial % 6, {"00", "01", "10"});
+        for (unsigned int length = 1; length <= 6; ++length) {
+            const auto expected = enumerate(csr, length);
+            const auto dawg = SequenceDawg::build(csr, length);
+
+            std::vector<std::string> words;
+            EXPECT_EQ(dawg.forEach([&](const std::string& word) { words.push_back(word); }),
+                      expected.size());
+            EXPECT_EQ(words, expected);
+            EXPECT_EQ(dawg.count(), BigUint(expected.size()));
+            for (const auto& word : expected) {
+                EXPECT_TRUE(dawg.contains(word));
+            }
+            EXPECT_FALSE(dawg.contains(std::string(2 * length, '1')) &&
+                         !std::binary_search(expected.begin(), expected.end(),
+                                             std::string(2 * length, '1')));
+            EXPECT_FALSE(dawg.contains("0"));
+        }
+    }
+}
+
+TEST(SequenceDawgTest, IsMinimal) {
+    // 全系列 {0,1}^L は1列の節点 (L + 1 個) になる
+    CsrGraph csr;
+    csr.addNode("a");
+    csr.addNode("b");
+    const auto zero = csr.addSymbol("0"), one = csr.addSymbol("1");
+    csr.addEdge(0, 0, zero);
+    csr.addEdge(0, 1, one);
+    csr.addEdge(1, 0, zero);
+    csr.addEdge(1, 1, one);
+    const auto all = SequenceDawg::build(csr, 20);
+    EXPECT_EQ(all.getNodeCount(), 21u);
+    EXPECT_EQ(all.getEdgeCount(), 40u);
+    EXPECT_EQ(all.count(), BigUint(1u << 20));
+
+    // 11 を含まない系列 (黄金比シフト): 直前が1かどうかで2通りの節点に分かれる
+    CsrGraph golden;
+    golden.addNode("a");
+    golden.addNode("b");
+    const auto z = golden.addSymbol("0"), o = golden.addSymbol("1");
+    golden.addEdge(0, 0, z);
+    golden.addEdge(0, 1, o);
+    golden.addEdge(1, 0, z);
+    const auto dawg = SequenceDawg::build(golden, 30);
+    EXPECT_EQ(dawg.count(), BigUint(2178309u));  // F(32)
+    EXPECT_LE(dawg.getNodeCount(), 2u * 30 + 1);
+    EXPECT_TRUE(dawg.contains("010010100101001010010101010100"));
+    EXPECT_FALSE(dawg.contains("011010100101001010010101010100"));
+}
+
+TEST(SequenceDawgTest, EmptyLanguage) {
+    CsrGraph chain;
+    chain.addNode("a");
+    chain.addNode("b");
+    chain.addEdge(0, 1, chain.addSymbol("x"));
+    for (unsigned int length : {0u, 2u}) {
+        const auto dawg = SequenceDawg::build(chain, length);
+        EXPECT_EQ(dawg.getNodeCount(), 0u);
+        EXPECT_EQ(dawg.count(), BigUint());
+        EXPECT_EQ(dawg.forEach([](const std::string&) {}), 0u);
+        EXPECT_FALSE(dawg.contains("xx"));
+    }
+    EXPECT_TRUE(SequenceDawg::build(chain, 1).contains("x"));
+
+    CsrGraph mixed;
+    mixed.addNode("a");
+    mixed.addEdge(0, 0, mixed.addSymbol("0"));
+    mixed.addEdge(0, 0, mixed.addSymbol("10"));
+    EXPECT_THROW(SequenceDawg::build(mixed, 3), std::invalid_argument);
+}
+
+TEST(SequenceDawgTest, RejectsInvalidArrays) {
+    // 0 -a-> 1 -b-> 2 (L = 2)
+    EXPECT_NO_THROW(SequenceDawg(2, {"a", "b"}, {0, 1, 2, 2}, {0, 1}, {1, 2}));
+    EXPECT_THROW(SequenceDawg(2, {"b", "a"}, {0, 1, 2, 2}, {0, 1}, {1, 2}),
+                 std::invalid_argument);
+    EXPECT_THROW(SequenceDawg(2, {"a", "bb"}, {0, 1, 2, 2}, {0, 1}, {1, 2}),
+                 std::invalid_argument);
+    EXPECT_THROW(SequenceDawg(3, {"a", "b"}, {0, 1, 2, 2}, {0, 1}, {1, 2}),
+                 std::invalid_argument);
+    EXPECT_THROW(SequenceDawg(2, {"a", "b"}, {0, 1, 2, 2}, {0, 1}, {1, 1}),
+                 std::invalid_argument);
+    EXPECT_THROW(SequenceDawg(2, {"a", "b"}, {0, 1, 2, 2}, {0, 2}, {1, 2}),
+                 std::invalid_argument);
+    EXPECT_THROW(SequenceDawg(2, {"a", "b"}, {0, 1, 3, 2}, {0, 1}, {1, 2}),
+                 std::invalid_argument);
+    EXPECT_THROW(SequenceDawg(0, {"a"}, {0, 0}, {}, {}), std::invalid_argument);
+}
+
+TEST(SequenceDawgTest, FileRoundTrip) {
+    const std::string directory =
+        (std::filesystem::temp_directory_path() /
+         ("pft-dawg-test-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed())))
+            .string();
+    std::filesystem::remove_all(directory);
+    const std::string path = directory + "/sequences.dawg";
+
+    std::mt19937 rng(8);
+    Graph graph(makeRandomGraph(rng, 8, {"0", "1", "2"}));
+    ASSERT_TRUE(io::output::writeSeqDawg(path, graph, 12));
+    SequenceDawg dawg;
+    ASSERT_TRUE(io::input::readSeqDawg(path, dawg));
+    const auto expected = enumerate(graph.getCsr(), 12);
+    std::vector<std::string> words;
+    dawg.forEach([&](const std::string& word) { words.push_back(word); });
+    EXPECT_EQ(words, expected);
+    EXPECT_EQ(dawg.getLength(), 12u);
+
+    // 壊れたファイルは読み込まない
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    auto rewrite = [&](const std::string& content) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    };
+    SequenceDawg broken;
+    rewrite(bytes.substr(0, bytes.size() - 4));
+    EXPECT_FALSE(io::input::readSeqDawg(path, broken));
+    rewrite(bytes + "x");
+    EXPECT_FALSE(io::input::readSeqDawg(path, broken));
+    rewrite("PFTDAWG0" + bytes.substr(8));
+    EXPECT_FALSE(io::input::readSeqDawg(path, broken));
+    std::string badTarget = bytes;
+    badTarget[badTarget.size() - 4] = '\x7f';
+    rewrite(badTarget);
+    EXPECT_FALSE(io::input::readSeqDawg(path, broken));
+    EXPECT_FALSE(io::input::readSeqDawg(directory + "/missing.dawg", broken));
+    std::filesystem::remove_all(directory);
+}
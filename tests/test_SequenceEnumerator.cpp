@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "SequenceTestUtils.hpp"
+#include "algorithm/SequenceEnumerator.hpp"
+#include "core/Graph.hpp"
+#include "io/Output.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <set>
+#include <sstream>
+
+// SequenceEnumerator クラスのテスト
+
+namespace {
+
+using test_utils::enumerate;
+using test_utils::makeRandomGraph;
+
+// 経路を列挙して語の集合を作る (比較用)
+std::set<std::string> collectByEnumeration(const CsrGraph& csr, unsigned int length) {
+    std::set<std::string> words;
+    const auto& offsets = csr.getOutOffsets();
+    const auto& targets = csr.getOutTargets();
+    const auto& symbols = csr.getOutSymbols();
+    std::function<void(CsrGraph::Id, const std::string&, unsigned int)> walk =
+        [&](CsrGraph::Id v, const std::string& word, unsigned int rest) {
+            if (rest == 0) {
+                words.insert(word);
+                return;
+            }
+            for (CsrGraph::Id e = offsets[v]; e < offsets[v + 1]; ++e) {
+                walk(targets[e], word + csr.getSymbol(symbols[e]), rest - 1);
+            }
+        };
+    for (CsrGraph::Id v = 0; v < csr.getNodeCount(); ++v) {
+        walk(v, "", length);
+    }
+    return words;
+}
+
+}  // namespace
+
+TEST(SequenceEnumeratorTest, MatchesEnumerationInLexicographicOrder) {
+    std::mt19937 rng(9);
+    for (int trial = 0; trial < 30; ++trial) {
+        CsrGraph csr = makeRandomGraph(rng, 3 + trial % 6, {"0", "1", "2"});
+        for (unsigned int length = 1; length <= 6; ++length) {
+            const auto expected = collectByEnumeration(csr, length);
+            const auto words = enumerate(csr, length);
+            EXPECT_EQ(words, std::vector<std::string>(expected.begin(), expected.end()));
+        }
+    }
+}
+
+TEST(SequenceEnumeratorTest, DeterminizesDuplicatePaths) {
+    // 0 -a-> 1, 0 -a-> 2, 1 -b-> 0, 2 -b-> 0: "ab" と "ba" を綴る経路は2本ずつある
+    CsrGraph csr;
+    for (int v = 0; v < 3; ++v) {
+        csr.addNode(std::to_string(v));
+    }
+    const auto a = csr.addSymbol("a"), b = csr.addSymbol("b");
+    csr.addEdge(0, 1, a);
+    csr.addEdge(0, 2, a);
+    csr.addEdge(1, 0, b);
+    csr.addEdge(2, 0, b);
+    EXPECT_EQ(enumerate(csr, 2), (std::vector<std::string>{"ab", "ba"}));
+    EXPECT_EQ(enumerate(csr, 3), (std::vector<std::string>{"aba", "bab"}));
+    EXPECT_TRUE(enumerate(csr, 0).empty());
+}
+
+TEST(SequenceEnumeratorTest, SkipsDeadEnds) {
+    // 自己ループ 0 -0-> 0 と，行き止まりへの長い鎖 0 -1-> 1 -1-> 2 -1-> 3
+    CsrGraph csr;
+    for (int v = 0; v < 4; ++v) {
+        csr.addNode(std::to_string(v));
+    }
+    const auto zero = csr.addSymbol("0"), one = csr.addSymbol("1");
+    csr.addEdge(0, 0, zero);
+    csr.addEdge(0, 1, one);
+    csr.addEdge(1, 2, one);
+    csr.addEdge(2, 3, one);
+    EXPECT_EQ(enumerate(csr, 4), (std::vector<std::string>{"0000", "0001", "0011", "0111"}));
+
+    // 閉路のないグラフでは最長の経路より長い語はない
+    CsrGraph chain;
+    for (int v = 0; v < 3; ++v) {
+        chain.addNode(std::to_string(v));
+    }
+    const auto x = chain.addSymbol("x");
+    chain.addEdge(0, 1, x);
+    chain.addEdge(1, 2, x);
+    SequenceEnumerator enumerator(chain);
+    EXPECT_EQ(enumerator.enumerate(3, [](const std::string&) {}), 0u);
+    EXPECT_EQ(enumerator.getStateCount(), 1u);
+}
+
+TEST(SequenceEnumeratorTest, NonUniformLabels) {
+    // "a" + "ab" と "aa" + "b" は同じ語 "aab" になる
+    std::mt19937 rng(4);
+    for (int trial = 0; trial < 10; ++trial) {
+        CsrGraph csr = makeRandomGraph(rng, 3 + trial % 4, {"a", "aa", "ab", "b"});
+        for (unsigned int length = 1; length <= 4; ++length) {
+            const auto expected = collectByEnumeration(csr, length);
+            EXPECT_EQ(enumerate(csr, length),
+                      std::vector<std::string>(expected.begin(), expected.end()));
+        }
+    }
+}
+
+TEST(SequenceEnumeratorTest, PrefixesPartitionInOrder) {
+    std::mt19937 rng(12);
+    for (int trial = 0; trial < 20; ++trial) {
+        CsrGraph csr = makeRandomGraph(rng, 4 + trial % 5, {"0", "1", "2"});
+        const unsigned int length = 7;
+        const auto words = enumerate(csr, length);
+        for (size_t minCount : {1, 5, 40, 100000}) {
+            SequenceEnumerator enumerator(csr);
+            const auto prefixes = enumerator.genPrefixes(length, minCount);
+            if (words.empty()) {
+                EXPECT_TRUE(prefixes.empty());
+                continue;
+            }
+            // 区間ごとの語を繋げると全体と一致する (空の区間はない)
+            std::vector<std::string> joined;
+            for (const auto& prefix : prefixes) {
+                EXPECT_LE(prefix.size(), length);
+                const auto count = enumerator.enumerate(
+                    length, [&](const std::string& word) { joined.push_back(word); }, prefix);
+                EXPECT_GT(count, 0u);
+            }
+            EXPECT_EQ(joined, words);
+        }
+    }
+}
+
+TEST(SequenceEnumeratorTest, PrefixOutsideGraph) {
+    CsrGraph csr;
+    csr.addNode("0");
+    csr.addNode("1");
+    const auto a = csr.addSymbol("a"), b = csr.addSymbol("b");
+    csr.addEdge(0, 1, a);
+    csr.addEdge(1, 0, b);
+    SequenceEnumerator enumerator(csr);
+    std::vector<std::string> words;
+    auto visit = [&](const std::string& word) { words.push_back(word); };
+    EXPECT_EQ(enumerator.enumerate(3, visit, {a, a}), 0u);
+    EXPECT_EQ(enumerator.enumerate(2, visit, {a, b, a}), 0u);
+    EXPECT_EQ(enumerator.enumerate(3, visit, {b, a, b}), 1u);
+    EXPECT_EQ(words, (std::vector<std::string>{"bab"}));
+}
+
+TEST(SequenceEnumeratorTest, ParallelCsvMatchesSequential) {
+    const std::string directory =
+        (std::filesystem::temp_directory_path() /
+         ("pft-sequence-test-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed())))
+            .string();
+    std::filesystem::remove_all(directory);
+    auto read = [](const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    };
+
+    std::mt19937 rng(5);
+    for (int trial = 0; trial < 5; ++trial) {
+        Graph graph(makeRandomGraph(rng, 6 + trial, {"0", "1"}));
+        const std::string sequential = directory + "/sequential.csv";
+        const std::string parallel = directory + "/parallel.csv";
+        ASSERT_TRUE(io::output::writeSeqCsv(sequential, graph, 10));
+        ASSERT_TRUE(io::output::writeSeqCsv(parallel, graph, 10, 4));
+        EXPECT_EQ(read(parallel), read(sequential));
+        // 区間ごとの一時ファイルに書き出して繋げても同じで，一時ファイルは残らない
+        ASSERT_TRUE(io::output::writeSeqCsv(parallel, graph, 10, 4, 16));
+        EXPECT_EQ(read(parallel), read(sequential));
+        EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory),
+                                std::filesystem::directory_iterator()),
+                  2);
+    }
+    std::filesystem::remove_all(directory);
+}
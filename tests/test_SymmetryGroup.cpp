@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "algorithm/DeBruijn.hpp"
+#include "analysis/eigenvalues.hpp"
+#include "io/Input.hpp"
+#include "utils/SymmetryGroup.hpp"
+
+#include <set>
+
+// SymmetryGroup クラスのテスト
+
+namespace {
+
+io::type::Config makeAllPatternsConfig(unsigned int alphabet, unsigned int length,
+                                       const std::vector<unsigned int>& position) {
+    io::type::Config config;
+    config.generation.mode = "all-patterns";
+    config.generation.alphabet = alphabet;
+    config.generation.period = position.size();
+    config.generation.forbidden.length = length;
+    config.generation.forbidden.position = position;
+    return config;
+}
+
+}  // namespace
+
+TEST(SymmetryGroupTest, OrderRespectsPosition) {
+    // 置換2通り × 回転2通り × 反転
+    EXPECT_EQ(SymmetryGroup(2, 2, {1, 1}).getOrder(), 8);
+
+    // 回転は位相ごとの個数を保たないが，ph -> -(ph + 1) + 1 の反転は保つ
+    EXPECT_EQ(SymmetryGroup(2, 2, {1, 2}).getOrder(), 4);
+
+    // 置換6通り × 回転3通り × 反転
+    EXPECT_EQ(SymmetryGroup(3, 1, {1, 1, 1}).getOrder(), 36);
+}
+
+TEST(SymmetryGroupTest, TransformsWords) {
+    SymmetryGroup group(2, 3, {1, 1, 1});
+    const auto& transforms = group.getTransforms();
+    for (size_t g = 0; g < transforms.size(); ++g) {
+        const auto& t = transforms[g];
+        if (t.permutation == std::vector<unsigned int>{1, 0} && t.shift == 1 && !t.reversed) {
+            EXPECT_EQ(group.apply(g, {Node("001", 0), Node("011", 2)}),
+                      (std::vector<Node>{Node("100", 0), Node("110", 1)}));
+            EXPECT_EQ(t.toString("01"), "10/1/-");
+        }
+        if (t.permutation == std::vector<unsigned int>{0, 1} && t.shift == 0 && t.reversed) {
+            // 位相0から始まる長さ3の語は，反転すると位相 -(0 + 2) = 1 から始まる
+            EXPECT_EQ(group.apply(g, {Node("001", 0)}), (std::vector<Node>{Node("100", 1)}));
+        }
+    }
+    EXPECT_EQ(transforms[0].toString("01"), "01/0/-");
+}
+
+TEST(SymmetryGroupTest, OrbitsPartitionSweep) {
+    auto config = makeAllPatternsConfig(2, 2, {1, 2, 1});
+    SymmetryGroup group(2, 2, {1, 2, 1});
+
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    std::set<std::vector<Node>> seen;
+    size_t total = 0, covered = 0, representatives = 0;
+    while (enumerator.next()) {
+        seen.insert(enumerator.get());
+        ++total;
+        size_t transform, orbitSize;
+        auto representative = group.canonicalize(enumerator.get(), transform, orbitSize);
+        EXPECT_EQ(group.apply(transform, enumerator.get()), representative);
+        EXPECT_TRUE(seen.count(representative));  // 代表元は列挙順で最初に現れる
+        if (representative == enumerator.get()) {
+            EXPECT_EQ(transform, 0);
+            ++representatives;
+            covered += orbitSize;
+        }
+    }
+    EXPECT_EQ(covered, total);
+    EXPECT_LT(representatives, total);
+}
+
+TEST(SymmetryGroupTest, PreservesCapacity) {
+    const std::vector<unsigned int> position = {1, 1, 1};
+    auto config = makeAllPatternsConfig(2, 2, position);
+    SymmetryGroup group(2, 2, position);
+    DeBruijn generator(2, 3, 2);
+
+    io::input::ForbiddenSetEnumerator enumerator(config);
+    while (enumerator.next()) {
+        double expected = calculateMaxEigenvalue(generator.generate(enumerator.get()));
+        for (size_t g = 0; g < group.getOrder(); ++g) {
+            auto mapped = group.apply(g, enumerator.get());
+            EXPECT_NEAR(calculateMaxEigenvalue(generator.generate(mapped)), expected, 1e-6)
+                << group.getTransforms()[g].toString("01");
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "utils/ThreadPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+// ThreadPool クラスのテスト
+
+TEST(ThreadPoolTest, RunsAllTasks) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4);
+
+    std::vector<int> results(1000, 0);
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&results, i](size_t) { results[i] = i * i; });
+    }
+    pool.wait();
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(results[i], i * i);
+    }
+}
+
+TEST(ThreadPoolTest, WorkerIndexIsInRange) {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> perWorker(3);
+    for (int i = 0; i < 300; ++i) {
+        pool.submit([&](size_t worker) {
+            ASSERT_LT(worker, 3);
+            perWorker[worker]++;
+        });
+    }
+    pool.wait();
+
+    int total = 0;
+    for (auto& count : perWorker) {
+        total += count;
+    }
+    EXPECT_EQ(total, 300);
+}
+
+TEST(ThreadPoolTest, BoundsPendingTasks) {
+    const size_t maxPending = 2;
+    ThreadPool pool(2, maxPending);
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    std::atomic<int> submitted{0};
+
+    for (int i = 0; i < 20; ++i) {
+        pool.submit([&](size_t) {
+            int now = ++running;
+            int prev = maxRunning;
+            while (now > prev && !maxRunning.compare_exchange_weak(prev, now)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --running;
+        });
+        ++submitted;
+    }
+    pool.wait();
+
+    EXPECT_EQ(submitted, 20);
+    EXPECT_LE(maxRunning, static_cast<int>(maxPending));
+}
+
+TEST(ThreadPoolTest, RethrowsTaskException) {
+    ThreadPool pool(2);
+    std::atomic<int> finished{0};
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&, i](size_t) {
+            if (i == 5) {
+                throw std::runtime_error("task failed");
+            }
+            finished++;
+        });
+    }
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(finished, 9);
+
+    // 例外は一度だけ送出される
+    pool.submit([&](size_t) { finished++; });
+    EXPECT_NO_THROW(pool.wait());
+    EXPECT_EQ(finished, 10);
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "io/ZeroCapacitySets.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+// ZeroCapacitySets クラスのテスト
+
+namespace {
+
+class ZeroCapacitySetsTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        directory = (std::filesystem::temp_directory_path() /
+                     ("pft-zero-test-" + std::to_string(::testing::UnitTest::GetInstance()
+                                                            ->random_seed())))
+                        .string();
+        std::filesystem::remove_all(directory);
+        path = directory + "/zero_capacity.csv";
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    std::string directory;
+    std::string path;
+};
+
+}  // namespace
+
+TEST_F(ZeroCapacitySetsTest, PrunesSupersets) {
+    io::ZeroCapacitySets sets(path);
+    EXPECT_FALSE(sets.load());
+    EXPECT_FALSE(sets.containsSubsetOf({Node("00", 0)}));
+
+    ASSERT_TRUE(sets.add({Node("00", 0), Node("11", 1)}));
+    EXPECT_TRUE(sets.containsSubsetOf({Node("00", 0), Node("11", 1)}));
+    EXPECT_TRUE(sets.containsSubsetOf({Node("01", 1), Node("11", 1), Node("00", 0)}));
+    EXPECT_FALSE(sets.containsSubsetOf({Node("00", 0), Node("11", 0)}));
+    EXPECT_FALSE(sets.containsSubsetOf({Node("00", 0)}));
+
+    // 記録済みの集合を含む集合は追加しない
+    EXPECT_FALSE(sets.add({Node("00", 0), Node("11", 1), Node("10", 1)}));
+    EXPECT_EQ(sets.getCount(), 1u);
+}
+
+TEST_F(ZeroCapacitySetsTest, KeepsMinimalSetsAcrossLoads) {
+    {
+        io::ZeroCapacitySets sets(path);
+        ASSERT_TRUE(sets.add({Node("00", 0), Node("11", 1), Node("10", 1)}));
+        ASSERT_TRUE(sets.add({Node("01", 0), Node("10", 0)}));
+
+        // 部分集合を加えると上位集合の記録は取り除かれる
+        ASSERT_TRUE(sets.add({Node("00", 0), Node("11", 1)}));
+        EXPECT_EQ(sets.getCount(), 2u);
+    }
+
+    io::ZeroCapacitySets loaded(path);
+    ASSERT_TRUE(loaded.load());
+    EXPECT_EQ(loaded.getCount(), 2u);
+    EXPECT_TRUE(loaded.containsSubsetOf({Node("11", 1), Node("00", 0), Node("01", 1)}));
+    EXPECT_TRUE(loaded.containsSubsetOf({Node("01", 0), Node("10", 0), Node("11", 0)}));
+    EXPECT_FALSE(loaded.containsSubsetOf({Node("01", 0), Node("11", 1)}));
+
+    std::ifstream file(path);
+    std::string first;
+    std::getline(file, first);
+    EXPECT_EQ(first, "01:0-10:0");
+}
+
+TEST_F(ZeroCapacitySetsTest, MergesSetsSavedByOthers) {
+    // 同じファイルを共有する2つの実行 (どちらも相手の追加より前に読み込んだ)
+    io::ZeroCapacitySets first(path), second(path);
+    EXPECT_FALSE(first.load());
+    EXPECT_FALSE(second.load());
+    ASSERT_TRUE(first.add({Node("00", 0), Node("11", 1), Node("10", 1)}));
+    ASSERT_TRUE(second.add({Node("01", 0), Node("10", 0)}));
+    // 保存時に読み直した相手の集合も極小性を保って取り込む
+    ASSERT_TRUE(first.add({Node("00", 0), Node("11", 1)}));
+    EXPECT_EQ(first.getCount(), 2u);
+
+    io::ZeroCapacitySets loaded(path);
+    ASSERT_TRUE(loaded.load());
+    EXPECT_EQ(loaded.getCount(), 2u);
+    EXPECT_TRUE(loaded.containsSubsetOf({Node("01", 0), Node("10", 0)}));
+    EXPECT_TRUE(loaded.containsSubsetOf({Node("00", 0), Node("11", 1)}));
+    EXPECT_FALSE(loaded.containsSubsetOf({Node("00", 0), Node("10", 1)}));
+}
+
+TEST_F(ZeroCapacitySetsTest, IgnoresBrokenLines) {
+    std::filesystem::create_directories(directory);
+    {
+        std::ofstream file(path);
+        file << "00:0-11:1\nbroken\n01:x\n";
+    }
+    io::ZeroCapacitySets sets(path);
+    ASSERT_TRUE(sets.load());
+    EXPECT_EQ(sets.getCount(), 1u);
+}
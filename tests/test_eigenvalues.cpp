@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "GraphTestUtils.hpp"
+#include "analysis/eigenvalues.hpp"
+#include "core/Graph.hpp"
+
+#include <random>
+
+// 最大固有値計算のテスト
+
+namespace {
+
+using test_utils::makeGraph;
+
+Eigen::SparseMatrix<double> toSparse(const Eigen::MatrixXd& matrix) {
+    return matrix.sparseView();
+}
+
+}  // namespace
+
+TEST(EigenvaluesTest, PeriodicCycle) {
+    // 長さ5の閉路 (固有値は1の5乗根で，絶対値が最大のものが5つある)
+    Graph graph = makeGraph({{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}});
+    EXPECT_NEAR(calculateMaxEigenvalue(graph), 1.0, 1e-8);
+}
+
+TEST(EigenvaluesTest, PeriodicBipartite) {
+    // 周期2の既約行列 (固有値 ±sqrt(6))
+    Eigen::MatrixXd matrix(4, 4);
+    matrix << 0, 0, 1, 2,
+              0, 0, 3, 0,
+              1, 1, 0, 0,
+              2, 0, 0, 0;
+    PerronRoot root = calculatePerronRoot(toSparse(matrix));
+    EXPECT_TRUE(root.converged);
+
+    Eigen::EigenSolver<Eigen::MatrixXd> solver(matrix);
+    double expected = solver.eigenvalues().real().maxCoeff();
+    EXPECT_NEAR(root.value, expected, 1e-8);
+    EXPECT_LE(root.lower, expected + 1e-12);
+    EXPECT_GE(root.upper, expected - 1e-12);
+}
+
+TEST(EigenvaluesTest, ReducibleWithSinks) {
+    // 黄金比の成分 + 自己ループ1つの成分 + シンク
+    Graph graph = makeGraph({{0, 0}, {0, 1}, {1, 0}, {1, 2}, {2, 3}, {3, 3}, {3, 4}});
+    EXPECT_NEAR(calculateMaxEigenvalue(graph), (1.0 + std::sqrt(5.0)) / 2.0, 1e-8);
+
+    // 辺のないグラフ
+    Graph empty = makeGraph({});
+    EXPECT_DOUBLE_EQ(calculateMaxEigenvalue(empty), 0.0);
+}
+
+TEST(EigenvaluesTest, ReducibleIsOnlyExtrapolated) {
+    // 自己ループ1つの成分の比は1のままで，上下界は黄金比に一致しない
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(4, 4);
+    matrix(0, 0) = matrix(0, 1) = matrix(1, 0) = matrix(1, 2) = matrix(2, 3) = 1;
+    matrix(3, 3) = 1;
+    PerronRoot root = calculatePerronRoot(toSparse(matrix));
+    EXPECT_FALSE(root.converged);
+    EXPECT_TRUE(root.extrapolated);
+    EXPECT_NEAR(root.value, (1.0 + std::sqrt(5.0)) / 2.0, 1e-8);
+    EXPECT_LT(root.lower, root.upper - 0.5);
+}
+
+TEST(EigenvaluesTest, MatchesDenseSolverOnRandomMatrices) {
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 30; ++trial) {
+        const int n = 2 + trial % 12;
+        std::bernoulli_distribution hasEdge(0.3);
+        std::uniform_int_distribution<int> weight(1, 3);
+        Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (hasEdge(rng)) {
+                    matrix(i, j) = weight(rng);
+                }
+            }
+        }
+
+        Eigen::EigenSolver<Eigen::MatrixXd> solver(matrix);
+        double expected = solver.eigenvalues().real().maxCoeff();
+        EXPECT_NEAR(calculateMaxEigenvalue(toSparse(matrix)), expected, 1e-6) << matrix;
+    }
+}
+
+TEST(EigenvaluesTest, IterationLimit) {
+    Eigen::MatrixXd matrix(3, 3);
+    matrix << 1, 1, 0,
+              0, 1, 1,
+              1, 0, 0;
+    PerronRoot root = calculatePerronRoot(toSparse(matrix), EigenOptions{1e-12, 2});
+    EXPECT_FALSE(root.converged);
+    EXPECT_EQ(root.iterations, 2);
+    EXPECT_LE(root.lower, root.value);
+    EXPECT_GE(root.upper, root.value);
+
+    // 反復回数が足りなくても密な固有値分解で正しい値を返す
+    Eigen::EigenSolver<Eigen::MatrixXd> solver(matrix);
+    EXPECT_NEAR(calculateMaxEigenvalue(toSparse(matrix), EigenOptions{1e-12, 2}),
+                solver.eigenvalues().real().maxCoeff(), 1e-8);
+}
+
+TEST(EigenvaluesTest, LargeSparseGraph) {
+    // 密行列では扱えない大きさのグラフ (各ノードの入次数・出次数が2)
+    const int n = 50000;
+    CsrGraph csr;
+    csr.reserve(n, 2 * n);
+    for (int v = 0; v < n; ++v) {
+        csr.addNode(std::to_string(v));
+    }
+    CsrGraph::Id symbol = csr.addSymbol("0");
+    for (int v = 0; v < n; ++v) {
+        csr.addEdge(v, (v + 1) % n, symbol);
+        csr.addEdge(v, (v + 7) % n, symbol);
+    }
+    EXPECT_NEAR(calculateMaxEigenvalue(Graph(std::move(csr))), 2.0, 1e-8);
+}
+
+TEST(EigenvaluesTest, WarmStartReusesVector) {
+    Eigen::MatrixXd matrix(4, 4);
+    matrix << 0, 1, 1, 1,
+              1, 0, 0, 1,
+              0, 1, 0, 0,
+              1, 1, 0, 0;
+    Eigen::VectorXd vector;
+    PerronRoot cold = calculatePerronRoot(toSparse(matrix), EigenOptions{}, vector);
+    ASSERT_TRUE(cold.converged);
+    ASSERT_EQ(vector.size(), 4);
+
+    // 収束したベクトルから始めると少ない反復で同じ値になる
+    PerronRoot warm = calculatePerronRoot(toSparse(matrix), EigenOptions{}, vector);
+    ASSERT_TRUE(warm.converged);
+    EXPECT_NEAR(warm.value, cold.value, 1e-9);
+    EXPECT_LT(warm.iterations, cold.iterations);
+
+    // 大きさが合わなければ一様ベクトルから始める
+    Eigen::VectorXd mismatched = Eigen::VectorXd::Ones(7);
+    PerronRoot fresh = calculatePerronRoot(toSparse(matrix), EigenOptions{}, mismatched);
+    EXPECT_EQ(fresh.iterations, cold.iterations);
+}
+
+TEST(EigenvaluesTest, BoundsContainMaxEigenvalue) {
+    std::mt19937 rng(11);
+    for (int trial = 0; trial < 30; ++trial) {
+        const int n = 2 + trial % 10;
+        std::bernoulli_distribution hasEdge(0.35);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (hasEdge(rng)) {
+                    edges.emplace_back(i, j);
+                }
+            }
+        }
+        Graph graph = makeGraph(edges);
+        const double expected = calculateMaxEigenvalue(graph);
+
+        // 次数だけの上下界と，反復で狭めた上下界はどちらも最大固有値を挟む
+        PerronRoot degree = boundMaxEigenvalue(graph);
+        PerronRoot iterated = boundMaxEigenvalue(graph, 20);
+        EXPECT_LE(degree.lower, expected + 1e-9);
+        EXPECT_GE(degree.upper, expected - 1e-9);
+        EXPECT_LE(iterated.lower, expected + 1e-9);
+        EXPECT_GE(iterated.upper, expected - 1e-9);
+        EXPECT_GE(iterated.lower, degree.lower);
+        EXPECT_LE(iterated.upper, degree.upper);
+        EXPECT_FALSE(iterated.converged);
+    }
+}
+
+TEST(EigenvaluesTest, BoundsOfRegularGraph) {
+    // 行和がすべて2なら反復せずに上下界が一致する
+    Graph graph = makeGraph({{0, 0}, {0, 1}, {1, 0}, {1, 2}, {2, 1}, {2, 0}});
+    PerronRoot bounds = boundMaxEigenvalue(graph, 8);
+    EXPECT_EQ(bounds.lower, 2.0);
+    EXPECT_EQ(bounds.upper, 2.0);
+    EXPECT_EQ(bounds.iterations, 0);
+
+    Graph empty = makeGraph({});
+    PerronRoot none = boundMaxEigenvalue(empty, 8);
+    EXPECT_EQ(none.lower, 0.0);
+    EXPECT_EQ(none.upper, 0.0);
+}